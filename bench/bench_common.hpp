@@ -0,0 +1,105 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "game/chuck/voxel_chunk.hpp"
+#include "game/generator/terrain_generator.hpp"
+#include "utils/logger/logger.hpp"
+
+namespace bench {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Elapsed milliseconds between two steady_clock points
+ */
+inline double elapsedMs(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+/**
+ * @brief Running min/mean/max of a series of samples
+ */
+struct Stats {
+    double total = 0.0;
+    double min   = 0.0;
+    double max   = 0.0;
+    size_t count = 0;
+
+    void add(double sample) {
+        min = count == 0 ? sample : std::min(min, sample);
+        max = count == 0 ? sample : std::max(max, sample);
+        total += sample;
+        count++;
+    }
+
+    double mean() const { return count ? total / count : 0.0; }
+};
+
+/**
+ * @brief Keep the optimizer from discarding a computed value
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief Read an integer "--name=value" option, falling back to a default
+ */
+inline int intArg(int argc, char** argv, const std::string& name, int fallback) {
+    std::string prefix = "--" + name + "=";
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind(prefix, 0) == 0) {
+            return std::atoi(arg.c_str() + prefix.size());
+        }
+    }
+    return fallback;
+}
+
+/**
+ * @brief Whether two chunks hold the same block at every position
+ *
+ * Compares blocks, not storage: codecs and compact() may order section
+ * palettes differently for the same contents.
+ */
+inline bool sameBlocks(const game::chuck::VoxelChunk& a, const game::chuck::VoxelChunk& b) {
+    for (int y = 0; y < a.getSizeY(); y++) {
+        for (int z = 0; z < a.getSizeZ(); z++) {
+            for (int x = 0; x < a.getSizeX(); x++) {
+                if (a.getBlock(x, y, z) != b.getBlock(x, y, z)) return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Terrain settings used by every benchmark
+ *
+ * Mirrors the parameters main.cpp uses, except for a non-zero scale so
+ * the terrain actually varies and the numbers are representative.
+ */
+inline void configureGenerator(game::generator::TerrainGenerator& generator) {
+    generator.setScale(0.05f);
+    generator.setOctaves(6);
+    generator.setPersistence(0.5f);
+    generator.setBaseHeight(30);
+    generator.setMaxHeight(40);
+    generator.setWaterLevel(25);
+}
+
+/**
+ * @brief Silence per-chunk debug output while benchmarking
+ */
+inline void quietLogs() {
+    utils::log().setLevel(utils::LogLevel::WARN);
+}
+
+} // namespace bench
@@ -0,0 +1,130 @@
+// Binary greedy mesher micro-benchmark
+//
+// Single-threaded time to mesh one full 16x256x16 chunk (all four
+// neighbours loaded) with BinaryGreedyMesher, next to the mask-based
+// GreedyMesher it replaces. Both must emit the same set of quads with
+// the same textures; the benchmark fails otherwise.
+//
+// Usage: binary_mesher_bench [--chunks=64] [--repeat=20]
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+#include "bench_common.hpp"
+
+#include "game/chuck/binary_greedy_mesher.hpp"
+#include "game/chuck/greedy_meshing.hpp"
+
+namespace {
+
+using game::chuck::ChunkNeighborhood;
+using game::chuck::VoxelChunk;
+
+// four corners plus the texture layer, which stands in for the block type
+using Quad = std::pair<std::array<std::tuple<int, int, int>, 4>, int>;
+
+// Quads of one mesh as sorted corner lists, independent of emission order
+std::vector<Quad> quadsOf(const renderer::ChunkMeshData& mesh) {
+    std::vector<Quad> quads;
+    for (size_t q = 0; q + 3 < mesh.vertices.size(); q += 4) {
+        Quad quad;
+        for (int i = 0; i < 4; i++) {
+            glm::ivec3 p  = mesh.vertices[q + i].getPosition();
+            quad.first[i] = { p.x, p.y, p.z };
+        }
+        std::sort(quad.first.begin(), quad.first.end());
+        quad.second = mesh.vertices[q].getLayer();
+        quads.push_back(quad);
+    }
+    std::sort(quads.begin(), quads.end());
+    return quads;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::quietLogs();
+    game::blocks::initializeBlockTypes();
+
+    int count  = bench::intArg(argc, argv, "chunks", 64);
+    int repeat = bench::intArg(argc, argv, "repeat", 20);
+
+    renderer::TextureAtlas atlas;
+    atlas.loadFromBinary(NT_RESOURCE_DIR "/textures/blocks/universe_block_atlas.ntatlas");
+    game::blocks::BlockTextureTable textures(atlas);
+
+    game::generator::TerrainGenerator generator(1);
+    bench::configureGenerator(generator);
+
+    int width = 1;
+    while (width * width < count) width++;
+
+    // measured chunks occupy [1, width] on both axes, the outer ring only provides neighbours
+    int grid = width + 2;
+    std::vector<std::unique_ptr<VoxelChunk>> chunks(grid * grid);
+    for (int cz = 0; cz < grid; cz++) {
+        for (int cx = 0; cx < grid; cx++) {
+            auto chunk = std::make_unique<VoxelChunk>();
+            for (const auto& block : generator.generateChunk(cx, cz, 16)) {
+                chunk->setBlock(block.position.x - cx * 16, block.position.y, block.position.z - cz * 16, block.blockTypeId);
+            }
+            chunk->compact();
+            chunks[cz * grid + cx] = std::move(chunk);
+        }
+    }
+
+    std::vector<ChunkNeighborhood> neighborhoods;
+    for (int i = 0; i < count; i++) {
+        int cell = (i / width + 1) * grid + (i % width + 1);
+        ChunkNeighborhood n(*chunks[cell]);
+        n.neighbors[ChunkNeighborhood::NEG_X] = chunks[cell - 1].get();
+        n.neighbors[ChunkNeighborhood::POS_X] = chunks[cell + 1].get();
+        n.neighbors[ChunkNeighborhood::NEG_Z] = chunks[cell - grid].get();
+        n.neighbors[ChunkNeighborhood::POS_Z] = chunks[cell + grid].get();
+        neighborhoods.push_back(n);
+    }
+
+    game::chuck::GreedyMesher greedy(&textures);
+    game::chuck::BinaryGreedyMesher binary(&textures);
+
+    // equivalence first, also warms caches and the allocator
+    size_t quads = 0;
+    for (const auto& n : neighborhoods) {
+        auto expected = greedy.generateMesh(n);
+        auto actual   = binary.generateMesh(n);
+        if (quadsOf(expected) != quadsOf(actual)) {
+            std::printf("MISMATCH: binary mesher disagrees with GreedyMesher\n");
+            return 1;
+        }
+        quads += actual.getQuadCount();
+    }
+
+    bench::Stats greedyTime, binaryTime;
+    for (int r = 0; r < repeat; r++) {
+        for (const auto& n : neighborhoods) {
+            auto t0 = bench::Clock::now();
+            auto a  = greedy.generateMesh(n);
+            auto t1 = bench::Clock::now();
+            auto b  = binary.generateMesh(n);
+            auto t2 = bench::Clock::now();
+            bench::doNotOptimize(a);
+            bench::doNotOptimize(b);
+
+            greedyTime.add(bench::elapsedMs(t0, t1));
+            binaryTime.add(bench::elapsedMs(t1, t2));
+        }
+    }
+
+    std::printf("%d chunks x %d runs, seed 1, %zu quads, single thread\n\n", count, repeat, quads);
+    std::printf("%-16s %10s %10s %10s\n", "mesher", "avg ms", "min ms", "max ms");
+    std::printf("%-16s %10.3f %10.3f %10.3f\n", "GreedyMesher", greedyTime.mean(), greedyTime.min, greedyTime.max);
+    std::printf("%-16s %10.3f %10.3f %10.3f\n", "binary", binaryTime.mean(), binaryTime.min, binaryTime.max);
+    std::printf("\nspeedup: %.1fx\n", greedyTime.mean() / binaryTime.mean());
+
+    LOG_FLUSH();
+    return 0;
+}
@@ -0,0 +1,163 @@
+// Chunk codec benchmark
+//
+// Encodes and decodes generated worlds with every ChunkCodec and reports
+// the compression ratio and throughput. Sizes and speeds are relative to
+// the raw chunk, one uint32_t block ID per block (256 KiB), and to the
+// palette-packed form VoxelChunk keeps in memory.
+//
+// Every decoded chunk must hold exactly the generated blocks; the
+// benchmark fails on any difference.
+//
+// Then ChunkManager cold storage: a pregenerated spawn area is frozen by
+// shrinking the render distance and thawed by growing it again, reporting
+// voxel memory in both states and the main-thread cost per transition.
+//
+// Usage: chunk_codec_bench [--size=24] [--repeat=5] [--radius=12]
+
+#include <cstdio>
+#include <vector>
+
+#include "bench_common.hpp"
+
+#include "game/chuck/chuck_manager.hpp"
+#include "game/storage/chunk_codec.hpp"
+
+namespace {
+
+using game::chuck::VoxelChunk;
+using game::storage::ChunkCodec;
+
+constexpr double RAW_CHUNK_BYTES = 16.0 * 16.0 * 256.0 * sizeof(uint32_t);
+
+struct World {
+    const char* name;
+    game::generator::TerrainMode mode;
+    bool biomes;
+};
+
+bool runWorld(const World& world, int size, int repeat) {
+    game::generator::TerrainGenerator generator(7);
+    bench::configureGenerator(generator);
+    generator.setTerrainMode(world.mode);
+    generator.setBiomesEnabled(world.biomes);
+
+    const int count = size * size;
+    std::vector<VoxelChunk> chunks(count);
+    size_t memoryBytes = 0;
+    for (int i = 0; i < count; i++) {
+        generator.generateChunk(i / size * 3, i % size * 3, chunks[i]); // spread out for variety
+        chunks[i].compact();
+        memoryBytes += chunks[i].getMemoryUsage();
+    }
+
+    std::printf("\n%s: %d chunks, in memory %.2f KiB per chunk (%.0f:1 vs raw)\n",
+    world.name, count, memoryBytes / 1024.0 / count, RAW_CHUNK_BYTES * count / memoryBytes);
+    std::printf("%-10s %10s %10s %12s %12s %12s %12s\n",
+    "codec", "B/chunk", "vs raw", "vs memory", "enc us/chunk", "enc GB/s", "dec GB/s");
+
+    std::vector<std::vector<uint8_t>> encoded(count);
+    VoxelChunk decoded;
+    for (int c = 0; c < static_cast<int>(ChunkCodec::COUNT); c++) {
+        ChunkCodec codec = static_cast<ChunkCodec>(c);
+        bench::Stats encode, decode;
+        size_t bytes = 0;
+
+        for (int r = 0; r < repeat; r++) {
+            auto t0 = bench::Clock::now();
+            for (int i = 0; i < count; i++) {
+                encoded[i].clear();
+                game::storage::encodeChunk(chunks[i], codec, encoded[i]);
+            }
+            auto t1 = bench::Clock::now();
+            for (int i = 0; i < count; i++) {
+                if (!game::storage::decodeChunk(encoded[i].data(), encoded[i].size(), decoded)) {
+                    std::printf("FAIL: %s could not decode chunk %d of %s\n", game::storage::getChunkCodecName(codec), i, world.name);
+                    return false;
+                }
+                bench::doNotOptimize(decoded);
+            }
+            auto t2 = bench::Clock::now();
+
+            encode.add(bench::elapsedMs(t0, t1));
+            decode.add(bench::elapsedMs(t1, t2));
+        }
+
+        for (int i = 0; i < count; i++) {
+            bytes += encoded[i].size();
+            if (!game::storage::decodeChunk(encoded[i].data(), encoded[i].size(), decoded) || !bench::sameBlocks(decoded, chunks[i])) {
+                std::printf("MISMATCH: %s round trip of chunk %d of %s\n", game::storage::getChunkCodecName(codec), i, world.name);
+                return false;
+            }
+        }
+
+        double raw = RAW_CHUNK_BYTES * count;
+        std::printf("%-10s %10.0f %9.0f:1 %11.1f:1 %12.1f %12.2f %12.2f\n",
+        game::storage::getChunkCodecName(codec), double(bytes) / count, raw / bytes, double(memoryBytes) / bytes,
+        encode.min * 1000.0 / count, raw / (encode.min * 1e6), raw / (decode.min * 1e6));
+    }
+    return true;
+}
+
+bool runColdStorage(int radius) {
+    game::generator::TerrainGenerator generator(7);
+    bench::configureGenerator(generator);
+
+    game::chuck::ChunkManager manager(nullptr, &generator);
+    const glm::vec3 spawn(8.0f, 64.0f, 8.0f);
+    manager.pregenerate(spawn, radius);
+    const size_t count = manager.getLoadedChunkCount();
+
+    // margin 1: at distance 0 only the spawn chunk and its 4 neighbours stay warm; at distance radius all thaw
+    manager.setColdStorage(1, SIZE_MAX, ChunkCodec::RLE);
+    game::chuck::ChunkMemoryStats warm = manager.getMemoryStats();
+
+    manager.setRenderDistance(0);
+    auto t0 = bench::Clock::now();
+    manager.update(spawn);
+    auto t1 = bench::Clock::now();
+    game::chuck::ChunkMemoryStats cold = manager.getMemoryStats();
+
+    manager.setRenderDistance(radius);
+    auto t2 = bench::Clock::now();
+    manager.update(spawn);
+    auto t3 = bench::Clock::now();
+    game::chuck::ChunkMemoryStats thawed = manager.getMemoryStats();
+
+    if (cold.warmChunks != 5 || cold.coldChunks + 5 != count || thawed.warmChunks != count) {
+        std::printf("FAIL: cold storage froze %zu and thawed to %zu of %zu chunks\n", cold.coldChunks, thawed.warmChunks, count);
+        return false;
+    }
+
+    size_t coldTotal = cold.warmBytes + cold.coldBytes;
+    std::printf("\ncold storage, %zu chunks within %d of spawn (rle):\n", count, radius);
+    std::printf("  warm %.2f KiB per chunk, cold %.2f KiB per chunk, %.1fx less voxel memory\n",
+    warm.warmBytes / 1024.0 / count, coldTotal / 1024.0 / count, double(warm.warmBytes) / coldTotal);
+    std::printf("  freeze %.1f us per chunk, thaw %.1f us per chunk\n",
+    bench::elapsedMs(t0, t1) * 1000.0 / cold.coldChunks, bench::elapsedMs(t2, t3) * 1000.0 / cold.coldChunks);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::quietLogs();
+
+    int size   = bench::intArg(argc, argv, "size", 24);
+    int repeat = bench::intArg(argc, argv, "repeat", 5);
+    int radius = bench::intArg(argc, argv, "radius", 12);
+
+    const World worlds[] = {
+        { "heightmap", game::generator::TerrainMode::HEIGHTMAP, false },
+        { "density", game::generator::TerrainMode::DENSITY, false },
+        { "density+biomes", game::generator::TerrainMode::DENSITY, true },
+    };
+
+    std::printf("raw = one uint32_t per block (%.0f KiB per chunk); GB/s of raw data, single thread\n", RAW_CHUNK_BYTES / 1024);
+    for (const World& world : worlds) {
+        if (!runWorld(world, size, repeat)) return 1;
+    }
+    if (!runColdStorage(radius)) return 1;
+
+    LOG_FLUSH();
+    return 0;
+}
@@ -0,0 +1,112 @@
+// Chunk generation pipeline benchmark
+//
+// Drives ChunkManager::update() from a simulated 60 Hz frame loop without
+// a window and reports generation throughput and the worst main-thread
+// stall, comparing synchronous generation (0 workers) with the worker pool.
+// Also times ChunkManager::pregenerate() of the spawn area, the blocking
+// step between startup and the first frame.
+//
+// Usage: chunk_generation_bench [--radius=8] [--walk=16] [--workers=N] [--budget=4]
+
+#include <cstdio>
+#include <thread>
+
+#include "bench_common.hpp"
+
+#include "game/chuck/chuck_manager.hpp"
+
+namespace {
+
+struct RunResult {
+    int chunks        = 0;
+    double totalMs    = 0.0;
+    bench::Stats update;
+    int slowFrames    = 0; // update() alone blew the 16.6 ms frame budget
+};
+
+RunResult runScenario(size_t workers, size_t budget, int radius, int walk) {
+    game::generator::TerrainGenerator generator(1);
+    bench::configureGenerator(generator);
+
+    game::chuck::ChunkManager manager(nullptr, &generator, workers);
+    manager.setRenderDistance(radius);
+    manager.setMaxChunksAdoptedPerFrame(budget);
+
+    constexpr auto frameTime = std::chrono::microseconds(16667);
+    constexpr int framesPerStep = 20;
+
+    RunResult result;
+    glm::vec3 player(8.0f, 64.0f, 8.0f);
+    int frame = 0;
+
+    auto start = bench::Clock::now();
+    while (true) {
+        auto frameStart = bench::Clock::now();
+
+        // walk one chunk along +X every few frames once spawn has loaded
+        if (frame > 0 && frame % framesPerStep == 0 && player.x < 8.0f + walk * 16.0f) {
+            player.x += 16.0f;
+        }
+
+        manager.update(player);
+        auto frameEnd = bench::Clock::now();
+
+        double ms = bench::elapsedMs(frameStart, frameEnd);
+        result.update.add(ms);
+        if (ms > 16.667) result.slowFrames++;
+
+        frame++;
+
+        bool walked = player.x >= 8.0f + walk * 16.0f;
+        if (walked && manager.getPendingChunkCount() == 0) {
+            break;
+        }
+
+        std::this_thread::sleep_until(frameStart + frameTime);
+    }
+    result.totalMs = bench::elapsedMs(start, bench::Clock::now());
+    result.chunks  = manager.getLoadedChunkCount();
+    return result;
+}
+
+double pregenerateMs(size_t workers, int radius) {
+    game::generator::TerrainGenerator generator(1);
+    bench::configureGenerator(generator);
+
+    game::chuck::ChunkManager manager(nullptr, &generator, workers);
+    auto start = bench::Clock::now();
+    manager.pregenerate(glm::vec3(8.0f, 64.0f, 8.0f), radius);
+    return bench::elapsedMs(start, bench::Clock::now());
+}
+
+void report(const char* name, const RunResult& r) {
+    std::printf("%-22s %8d %10.1f %12.1f %10.3f %10.3f %8d\n",
+    name, r.chunks, r.totalMs, r.chunks / (r.totalMs / 1000.0),
+    r.update.mean(), r.update.max, r.slowFrames);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::quietLogs();
+    game::blocks::initializeBlockTypes();
+
+    int radius     = bench::intArg(argc, argv, "radius", 8);
+    int walk       = bench::intArg(argc, argv, "walk", 16);
+    size_t workers = bench::intArg(argc, argv, "workers", static_cast<int>(utils::ThreadPool::defaultThreadCount()));
+    size_t budget  = bench::intArg(argc, argv, "budget", 4);
+
+    std::printf("render distance %d, walk %d chunks, %zu workers, adopt budget %zu/frame\n\n",
+    radius, walk, workers, budget);
+    std::printf("%-22s %8s %10s %12s %10s %10s %8s\n",
+    "mode", "chunks", "total ms", "chunks/s", "avg ms", "worst ms", ">16ms");
+
+    report("synchronous", runScenario(0, SIZE_MAX, radius, walk));
+    report("worker pool", runScenario(workers, budget, radius, walk));
+
+    std::printf("\npregenerate radius %d: %.1f ms synchronous, %.1f ms on %zu workers\n",
+    radius, pregenerateMs(0, radius), pregenerateMs(workers, radius), workers);
+
+    LOG_FLUSH();
+    return 0;
+}
@@ -0,0 +1,314 @@
+// Chunk meshing benchmark
+//
+// Meshes generated chunks on a fixed seed and compares:
+//   - the original full-volume scan over a flat chunk (every one of the
+//     65,536 voxels visited, six neighbour lookups each)
+//   - the per-face mesher and the greedy mesher, each run on an isolated
+//     chunk (air beyond its borders) and with its four neighbours loaded
+//   - the bitmask greedy mesher with neighbours
+// and reports build time, quad / vertex / index counts and mesh size in
+// the old 48-byte vertex format versus the packed 8-byte ChunkVertex.
+// Every measured chunk has all four neighbours generated. The full scan
+// and the isolated per-face mesher must emit the same quad count, and
+// each greedy mesh must cover exactly the face area of the matching
+// per-face mesh.
+//
+// It also times the neighbour occlusion query the meshers make for every
+// block face, once through BlockTypeRegistry (singleton access plus a
+// hash lookup, as the meshers used to) and once through the frozen
+// BlockPropertyTable; both must count the same occluded faces.
+//
+// Usage: chunk_meshing_bench [--chunks=64] [--repeat=3]
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <set>
+#include <utility>
+
+#include "bench_common.hpp"
+#include "flat_voxel_chunk.hpp"
+
+#include "game/chuck/binary_greedy_mesher.hpp"
+#include "game/chuck/chunk_mesh_optimizer.hpp"
+#include "game/chuck/greedy_meshing.hpp"
+
+namespace {
+
+using MeshData = renderer::ChunkMeshData;
+
+bool isSolid(const bench::FlatVoxelChunk& chunk, int x, int y, int z) {
+    uint32_t typeId = chunk.getBlock(x, y, z);
+    if (typeId == 0) return false;
+    auto* blockType = game::blocks::BlockTypeRegistry::getInstance().getBlockType(typeId);
+    return blockType ? blockType->isSolid : false;
+}
+
+// The mesher as it was before sections: visit every voxel of the chunk
+MeshData referenceMesh(const bench::FlatVoxelChunk& chunk, const renderer::TextureAtlas& atlas) {
+    static const glm::ivec3 offsets[6] = {
+        { 0, 0, 1 }, { 0, 0, -1 }, { -1, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }
+    };
+
+    MeshData mesh;
+    for (int x = 0; x < bench::SIZE_X; x++) {
+        for (int y = 0; y < bench::SIZE_Y; y++) {
+            for (int z = 0; z < bench::SIZE_Z; z++) {
+                uint32_t typeId = chunk.getBlock(x, y, z);
+                if (typeId == 0) continue;
+
+                auto* blockType = game::blocks::BlockTypeRegistry::getInstance().getBlockType(typeId);
+                if (!blockType) continue;
+
+                for (int face = 0; face < 6; face++) {
+                    glm::ivec3 n = glm::ivec3(x, y, z) + offsets[face];
+                    if (isSolid(chunk, n.x, n.y, n.z)) continue;
+
+                    int layer = atlas.getLayer(blockType->getTexture(static_cast<game::blocks::BlockFace>(face)));
+                    glm::ivec3 p(x, y, z);
+                    mesh.addQuad({ p, p, p, p }, face, static_cast<uint16_t>(layer));
+                }
+            }
+        }
+    }
+    return mesh;
+}
+
+struct MeshTotals {
+    size_t quads = 0;
+    double area  = 0.0; // summed quad area in block faces
+};
+
+// Per quad: 4 x 48-byte renderer::Vertex + 6 uint32 indices before packing,
+// 4 x 8-byte ChunkVertex after (indices come from the shared quad buffer)
+constexpr size_t LEGACY_QUAD_BYTES = 4 * 48 + 6 * sizeof(uint32_t);
+constexpr size_t PACKED_QUAD_BYTES = 4 * sizeof(renderer::ChunkVertex);
+
+MeshTotals measureMesh(const MeshData& mesh) {
+    MeshTotals totals;
+    totals.quads = mesh.getQuadCount();
+    for (size_t q = 0; q + 3 < mesh.vertices.size(); q += 4) {
+        glm::vec3 origin = mesh.vertices[q].getPosition();
+        glm::vec3 a      = glm::vec3(mesh.vertices[q + 1].getPosition()) - origin;
+        glm::vec3 b      = glm::vec3(mesh.vertices[q + 3].getPosition()) - origin;
+        totals.area += glm::length(glm::cross(a, b));
+    }
+    return totals;
+}
+
+// Draw calls one chunk cost when every block type had its own renderer:
+// one per type with at least one visible face
+int perTypeDrawCalls(const game::chuck::ChunkNeighborhood& n) {
+    static const glm::ivec3 offsets[6] = {
+        { 0, 0, 1 }, { 0, 0, -1 }, { -1, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }
+    };
+
+    std::set<uint32_t> types;
+    for (int y = 0; y < bench::SIZE_Y; y++) {
+        for (int z = 0; z < bench::SIZE_Z; z++) {
+            for (int x = 0; x < bench::SIZE_X; x++) {
+                uint32_t typeId = n.center->getBlock(x, y, z);
+                if (typeId == 0 || types.count(typeId)) continue;
+                if (!game::blocks::BlockTypeRegistry::getInstance().getBlockType(typeId)) continue;
+
+                for (const auto& offset : offsets) {
+                    glm::ivec3 p = glm::ivec3(x, y, z) + offset;
+                    if (!n.isOccluding(p.x, p.y, p.z)) {
+                        types.insert(typeId);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    return static_cast<int>(types.size());
+}
+
+bool registryOccluding(const game::chuck::ChunkNeighborhood& n, int x, int y, int z) {
+    uint32_t typeId = n.getBlock(x, y, z);
+    if (typeId == 0) return false;
+    auto* blockType = game::blocks::BlockTypeRegistry::getInstance().getBlockType(typeId);
+    return blockType ? blockType->isSolid : false;
+}
+
+// Occluded faces of every non-air block in the non-empty sections
+template <typename OccludingFn>
+size_t countOccludedFaces(const game::chuck::ChunkNeighborhood& n, OccludingFn&& occluding) {
+    static const glm::ivec3 offsets[6] = {
+        { 0, 0, 1 }, { 0, 0, -1 }, { -1, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }
+    };
+
+    size_t occluded = 0;
+    for (int s = 0; s < game::chuck::VoxelChunk::SECTION_COUNT; s++) {
+        if (n.center->isSectionEmpty(s)) continue;
+        for (int y = s * 16; y < s * 16 + 16; y++) {
+            for (int z = 0; z < bench::SIZE_Z; z++) {
+                for (int x = 0; x < bench::SIZE_X; x++) {
+                    if (n.center->getBlock(x, y, z) == 0) continue;
+                    for (const auto& offset : offsets) {
+                        glm::ivec3 p = glm::ivec3(x, y, z) + offset;
+                        occluded += occluding(n, p.x, p.y, p.z);
+                    }
+                }
+            }
+        }
+    }
+    return occluded;
+}
+
+struct MesherResult {
+    const char* name;
+    bench::Stats time;
+    MeshTotals totals;
+};
+
+template <typename MeshFn>
+void run(MesherResult& result, int count, int repeat, MeshFn&& mesh) {
+    for (int r = 0; r < repeat; r++) {
+        for (int i = 0; i < count; i++) {
+            auto t0     = bench::Clock::now();
+            auto meshes = mesh(i);
+            result.time.add(bench::elapsedMs(t0, bench::Clock::now()));
+
+            if (r == 0) {
+                MeshTotals t = measureMesh(meshes);
+                result.totals.quads += t.quads;
+                result.totals.area += t.area;
+            }
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::quietLogs();
+    game::blocks::initializeBlockTypes();
+
+    int count  = bench::intArg(argc, argv, "chunks", 64);
+    int repeat = bench::intArg(argc, argv, "repeat", 3);
+
+    renderer::TextureAtlas atlas;
+    atlas.loadFromBinary(NT_RESOURCE_DIR "/textures/blocks/universe_block_atlas.ntatlas");
+    game::blocks::BlockTextureTable textures(atlas);
+
+    game::generator::TerrainGenerator generator(1);
+    bench::configureGenerator(generator);
+
+    int width = 1;
+    while (width * width < count) width++;
+
+    // measured chunks occupy [1, width] on both axes; ring 0 / width + 1 are neighbours only
+    int grid = width + 2;
+    std::vector<std::unique_ptr<bench::FlatVoxelChunk>> flat(grid * grid);
+    std::vector<std::unique_ptr<game::chuck::VoxelChunk>> sectioned(grid * grid);
+    for (int cz = 0; cz < grid; cz++) {
+        for (int cx = 0; cx < grid; cx++) {
+            auto a = std::make_unique<bench::FlatVoxelChunk>();
+            auto b = std::make_unique<game::chuck::VoxelChunk>();
+            for (const auto& block : generator.generateChunk(cx, cz, 16)) {
+                int x = block.position.x - cx * 16, z = block.position.z - cz * 16;
+                a->setBlock(x, block.position.y, z, block.blockTypeId);
+                b->setBlock(x, block.position.y, z, block.blockTypeId);
+            }
+            b->compact();
+            flat[cz * grid + cx]      = std::move(a);
+            sectioned[cz * grid + cx] = std::move(b);
+        }
+    }
+
+    auto cellOf = [&](int i) { return (i / width + 1) * grid + (i % width + 1); };
+
+    std::vector<game::chuck::ChunkNeighborhood> neighborhoods;
+    for (int i = 0; i < count; i++) {
+        int cell = cellOf(i);
+        game::chuck::ChunkNeighborhood n(*sectioned[cell]);
+        n.neighbors[game::chuck::ChunkNeighborhood::NEG_X] = sectioned[cell - 1].get();
+        n.neighbors[game::chuck::ChunkNeighborhood::POS_X] = sectioned[cell + 1].get();
+        n.neighbors[game::chuck::ChunkNeighborhood::NEG_Z] = sectioned[cell - grid].get();
+        n.neighbors[game::chuck::ChunkNeighborhood::POS_Z] = sectioned[cell + grid].get();
+        neighborhoods.push_back(n);
+    }
+
+    game::chuck::OptimizedChunkMeshBuilder perFace(&textures);
+    game::chuck::GreedyMesher greedy(&textures);
+    game::chuck::BinaryGreedyMesher binary(&textures);
+
+    MesherResult results[] = {
+        { "full scan (isolated)", {}, {} },
+        { "per-face (isolated)", {}, {} },
+        { "greedy (isolated)", {}, {} },
+        { "per-face (neighbours)", {}, {} },
+        { "greedy (neighbours)", {}, {} },
+        { "binary (neighbours)", {}, {} },
+    };
+
+    run(results[0], count, repeat, [&](int i) { return referenceMesh(*flat[cellOf(i)], atlas); });
+    run(results[1], count, repeat, [&](int i) { return perFace.generateChunkMesh(*sectioned[cellOf(i)]); });
+    run(results[2], count, repeat, [&](int i) { return greedy.generateMesh(*sectioned[cellOf(i)]); });
+    run(results[3], count, repeat, [&](int i) { return perFace.generateMesh(neighborhoods[i]); });
+    run(results[4], count, repeat, [&](int i) { return greedy.generateMesh(neighborhoods[i]); });
+    run(results[5], count, repeat, [&](int i) { return binary.generateMesh(neighborhoods[i]); });
+
+    std::printf("%d chunks x %d runs, seed 1\n\n", count, repeat);
+    std::printf("%-24s %9s %9s %10s %10s %10s %12s %12s\n",
+    "mesher", "avg ms", "max ms", "quads", "vertices", "indices", "legacy KiB", "packed KiB");
+    for (const auto& r : results) {
+        size_t quads = r.totals.quads;
+        std::printf("%-24s %9.3f %9.3f %10zu %10zu %10zu %12.1f %12.1f\n",
+        r.name, r.time.mean(), r.time.max, quads, quads * 4, quads * 6,
+        quads * LEGACY_QUAD_BYTES / 1024.0 / count, quads * PACKED_QUAD_BYTES / 1024.0 / count);
+    }
+
+    const auto& faceN   = results[3].totals;
+    const auto& greedyN = results[4].totals;
+    std::printf("\nneighbour culling removes %.1f%% of per-face quads\n",
+    100.0 * (1.0 - static_cast<double>(faceN.quads) / results[1].totals.quads));
+    std::printf("greedy merging removes %.1f%% of remaining quads\n",
+    100.0 * (1.0 - static_cast<double>(greedyN.quads) / faceN.quads));
+    std::printf("packed vertices: %zu -> %zu bytes per quad (%.1fx less VRAM and upload)\n",
+    LEGACY_QUAD_BYTES, PACKED_QUAD_BYTES, static_cast<double>(LEGACY_QUAD_BYTES) / PACKED_QUAD_BYTES);
+
+    int drawCalls = 0;
+    for (const auto& n : neighborhoods) {
+        drawCalls += perTypeDrawCalls(n);
+    }
+    std::printf("draw calls per chunk: %.2f with one renderer per block type, 1 with a merged stream\n",
+    static_cast<double>(drawCalls) / count);
+
+    std::vector<size_t> occluded[2];
+    double lookupMs[2] = { 1e30, 1e30 };
+    for (int r = 0; r < repeat; r++) {
+        for (int k = 0; k < 2; k++) {
+            occluded[k].clear();
+            auto t0 = bench::Clock::now();
+            for (const auto& n : neighborhoods) {
+                occluded[k].push_back(k == 0 ?
+                countOccludedFaces(n, registryOccluding) :
+                countOccludedFaces(n, [](const game::chuck::ChunkNeighborhood& c, int x, int y, int z) { return c.isOccluding(x, y, z); }));
+            }
+            lookupMs[k] = std::min(lookupMs[k], bench::elapsedMs(t0, bench::Clock::now()));
+        }
+    }
+    std::printf("occlusion query per chunk: %.3f ms via registry, %.3f ms via property table (%.2fx)\n",
+    lookupMs[0] / count, lookupMs[1] / count, lookupMs[0] / lookupMs[1]);
+
+    LOG_FLUSH();
+    if (occluded[0] != occluded[1]) {
+        std::printf("MISMATCH: registry and property table disagree on occluded faces\n");
+        return 1;
+    }
+    if (results[0].totals.quads != results[1].totals.quads) {
+        std::printf("MISMATCH: full scan and per-face mesher produced different geometry\n");
+        return 1;
+    }
+    for (auto [k, j] : { std::pair{ 1, 2 }, std::pair{ 3, 4 }, std::pair{ 3, 5 } }) {
+        if (std::abs(results[k].totals.area - results[j].totals.area) > 0.5) {
+            std::printf("MISMATCH: %s covers %.0f faces, %s covers %.0f\n",
+            results[k].name, results[k].totals.area, results[j].name, results[j].totals.area);
+            return 1;
+        }
+    }
+    return 0;
+}
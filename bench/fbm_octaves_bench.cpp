@@ -0,0 +1,105 @@
+// Specialised FBM kernel benchmark
+//
+// For every octave count from 1 to MAX_FBM_OCTAVES, compares the runtime
+// PerlinNoise::fbm(x, y, octaves, persistence) loop with the fbm<Octaves>
+// kernel that PerlinNoise::getFbmKernel() dispatches to, one point at a
+// time as getTerrainHeight() samples.
+//
+// Before timing, each kernel must reproduce the runtime loop bitwise for
+// random points at persistence 0.5 and 0.6 (the latter has inexact
+// amplitudes); the benchmark fails on any difference.
+//
+// Usage: fbm_octaves_bench [--points=65536] [--repeat=10]
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "bench_common.hpp"
+
+namespace {
+
+using game::generator::FbmWeights;
+using game::generator::PerlinNoise;
+
+bool checkKernel(const PerlinNoise& noise, int octaves, double persistence,
+const std::vector<double>& xs, const std::vector<double>& ys) {
+    PerlinNoise::FbmKernel kernel = PerlinNoise::getFbmKernel(octaves);
+    FbmWeights weights            = game::generator::makeFbmWeights(octaves, persistence);
+
+    for (size_t i = 0; i < xs.size(); i++) {
+        double expected = noise.fbm(xs[i], ys[i], octaves, persistence);
+        double actual   = (noise.*kernel)(xs[i], ys[i], weights);
+        if (std::memcmp(&expected, &actual, sizeof(double)) != 0) {
+            std::printf("MISMATCH: fbm<%d>(%f, %f) persistence %g = %.17g, runtime loop %.17g\n",
+            octaves, xs[i], ys[i], persistence, actual, expected);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::quietLogs();
+
+    int points = bench::intArg(argc, argv, "points", 65536);
+    int repeat = bench::intArg(argc, argv, "repeat", 10);
+
+    PerlinNoise noise(12345);
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> coord(-5000.0, 5000.0);
+
+    std::vector<double> xs(points), ys(points);
+    for (int i = 0; i < points; i++) {
+        xs[i] = coord(rng);
+        ys[i] = coord(rng);
+    }
+
+    for (int octaves = 1; octaves <= game::generator::MAX_FBM_OCTAVES; octaves++) {
+        for (double persistence : { 0.5, 0.6 }) {
+            if (!checkKernel(noise, octaves, persistence, xs, ys)) return 1;
+        }
+    }
+    if (PerlinNoise::getFbmKernel(0) || PerlinNoise::getFbmKernel(game::generator::MAX_FBM_OCTAVES + 1)) {
+        std::printf("FAIL: kernel returned for an octave count without a specialisation\n");
+        return 1;
+    }
+
+    std::printf("%d points x %d runs, persistence 0.5, single thread\n", points, repeat);
+    std::printf("all kernels match the runtime loop bitwise (persistence 0.5 and 0.6)\n\n");
+    std::printf("%-8s %14s %14s %10s\n", "octaves", "runtime ns/pt", "kernel ns/pt", "speedup");
+
+    std::vector<double> out(points);
+    for (int octaves = 1; octaves <= game::generator::MAX_FBM_OCTAVES; octaves++) {
+        PerlinNoise::FbmKernel kernel = PerlinNoise::getFbmKernel(octaves);
+        FbmWeights weights            = game::generator::makeFbmWeights(octaves, 0.5);
+
+        // the two paths take turns, so they see the same machine state
+        bench::Stats runtime, specialised;
+        for (int r = 0; r < repeat; r++) {
+            auto t0 = bench::Clock::now();
+            for (int i = 0; i < points; i++) {
+                out[i] = noise.fbm(xs[i], ys[i], octaves, 0.5);
+            }
+            auto t1 = bench::Clock::now();
+            bench::doNotOptimize(out);
+            for (int i = 0; i < points; i++) {
+                out[i] = (noise.*kernel)(xs[i], ys[i], weights);
+            }
+            auto t2 = bench::Clock::now();
+            bench::doNotOptimize(out);
+
+            runtime.add(bench::elapsedMs(t0, t1));
+            specialised.add(bench::elapsedMs(t1, t2));
+        }
+
+        std::printf("%-8d %14.2f %14.2f %9.2fx\n", octaves,
+        runtime.min * 1e6 / points, specialised.min * 1e6 / points, runtime.min / specialised.min);
+    }
+
+    LOG_FLUSH();
+    return 0;
+}
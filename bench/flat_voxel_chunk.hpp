@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace bench {
+
+constexpr int SIZE_X = 16;
+constexpr int SIZE_Y = 256;
+constexpr int SIZE_Z = 16;
+constexpr int VOLUME = SIZE_X * SIZE_Y * SIZE_Z;
+
+/**
+ * @brief The original VoxelChunk layout, kept as a benchmark baseline
+ *
+ * One uint32_t per block in a single flat array (256 KiB per chunk).
+ */
+class FlatVoxelChunk {
+    std::vector<uint32_t> blocks = std::vector<uint32_t>(VOLUME, 0);
+
+    static int getIndex(int x, int y, int z) {
+        return x + y * SIZE_X + z * SIZE_X * SIZE_Y;
+    }
+
+    public:
+    void setBlock(int x, int y, int z, uint32_t typeId) {
+        if (x >= 0 && x < SIZE_X && y >= 0 && y < SIZE_Y && z >= 0 && z < SIZE_Z) {
+            blocks[getIndex(x, y, z)] = typeId;
+        }
+    }
+
+    uint32_t getBlock(int x, int y, int z) const {
+        if (x < 0 || x >= SIZE_X || y < 0 || y >= SIZE_Y || z < 0 || z >= SIZE_Z) {
+            return 0;
+        }
+        return blocks[getIndex(x, y, z)];
+    }
+
+    size_t getMemoryUsage() const { return blocks.capacity() * sizeof(uint32_t); }
+};
+
+} // namespace bench
@@ -0,0 +1,198 @@
+// Batched FBM benchmark
+//
+// Compares per-column TerrainGenerator::getTerrainHeight() with the batched
+// getTerrainHeights(), and PerlinNoise::fbm() per point with fbmBatch() on
+// every backend this CPU supports, for 2D and 3D noise.
+//
+// Before timing, every backend must reproduce the scalar results exactly:
+// integer chunk heights for several seeds, with and without biomes, and
+// bitwise-identical 2D and 3D
+// fbm values for random points, including negative and large coordinates.
+// The benchmark fails on any difference.
+//
+// Usage: noise_batch_bench [--chunks=256] [--repeat=10]
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench_common.hpp"
+
+namespace {
+
+using game::generator::NoiseBackend;
+using game::generator::PerlinNoise;
+
+const NoiseBackend BACKENDS[] = { NoiseBackend::SCALAR, NoiseBackend::AVX2 };
+
+bool checkFbm(unsigned seed, NoiseBackend backend) {
+    PerlinNoise noise(seed);
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> coord(-5000.0, 5000.0);
+
+    const size_t count = 100003; // odd, so the SIMD tail is exercised
+    std::vector<double> xs(count), ys(count), out(count);
+    for (size_t i = 0; i < count; i++) {
+        xs[i] = coord(rng);
+        ys[i] = coord(rng);
+    }
+
+    noise.fbmBatch(xs.data(), ys.data(), out.data(), count, 6, 0.5, backend);
+    for (size_t i = 0; i < count; i++) {
+        double expected = noise.fbm(xs[i], ys[i], 6, 0.5);
+        if (std::memcmp(&expected, &out[i], sizeof(double)) != 0) {
+            std::printf("MISMATCH: %s fbm(%f, %f) = %.17g, scalar %.17g\n",
+            PerlinNoise::getBackendName(backend), xs[i], ys[i], out[i], expected);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool checkFbm3(unsigned seed, NoiseBackend backend) {
+    PerlinNoise noise(seed);
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> coord(-5000.0, 5000.0);
+
+    const size_t count = 100003;
+    std::vector<double> xs(count), ys(count), zs(count), out(count);
+    for (size_t i = 0; i < count; i++) {
+        xs[i] = coord(rng);
+        ys[i] = coord(rng);
+        zs[i] = coord(rng);
+    }
+
+    noise.fbmBatch(xs.data(), ys.data(), zs.data(), out.data(), count, 3, 0.5, backend);
+    for (size_t i = 0; i < count; i++) {
+        double expected = noise.fbm(xs[i], ys[i], zs[i], 3, 0.5);
+        if (std::memcmp(&expected, &out[i], sizeof(double)) != 0) {
+            std::printf("MISMATCH: %s fbm(%f, %f, %f) = %.17g, scalar %.17g\n",
+            PerlinNoise::getBackendName(backend), xs[i], ys[i], zs[i], out[i], expected);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool checkHeights(unsigned seed, int count, bool biomes) {
+    game::generator::TerrainGenerator generator(seed);
+    bench::configureGenerator(generator);
+    generator.setBiomesEnabled(biomes);
+
+    int heights[16 * 16];
+    for (int i = 0; i < count; i++) {
+        // spiral-ish spread over negative and positive chunk coordinates
+        int cx = (i % 32) - 16 + (i / 32) * 37;
+        int cz = (i / 32) - 4 - (i % 7) * 53;
+        generator.getTerrainHeights(cx * 16, cz * 16, 16, 16, heights);
+        for (int x = 0; x < 16; x++) {
+            for (int z = 0; z < 16; z++) {
+                int expected = generator.getTerrainHeight(cx * 16 + x, cz * 16 + z);
+                if (heights[x * 16 + z] != expected) {
+                    std::printf("MISMATCH: seed %u%s column (%d, %d) batched height %d, scalar %d\n",
+                    seed, biomes ? " biomes" : "", cx * 16 + x, cz * 16 + z, heights[x * 16 + z], expected);
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void report(const char* name, const bench::Stats& s, double baseline) {
+    std::printf("%-24s %10.4f %10.4f %10.2f %9.1fx\n", name, s.mean(), s.min, 256.0 / s.mean() / 1000.0, baseline / s.mean());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::quietLogs();
+
+    int count  = bench::intArg(argc, argv, "chunks", 256);
+    int repeat = bench::intArg(argc, argv, "repeat", 10);
+
+    for (unsigned seed : { 1u, 12345u, 987654321u }) {
+        for (NoiseBackend backend : BACKENDS) {
+            if (!PerlinNoise::isBackendSupported(backend)) continue;
+            if (!checkFbm(seed, backend) || !checkFbm3(seed, backend)) return 1;
+        }
+        if (!checkHeights(seed, count, false) || !checkHeights(seed, count, true)) return 1;
+    }
+
+    game::generator::TerrainGenerator generator(1);
+    bench::configureGenerator(generator);
+
+    // the same 16x16 sample grids getTerrainHeights() builds, scale 0.05
+    PerlinNoise noise(1);
+    // 3D points: the same grids at 256 heights spread over the chunk's columns
+    std::vector<std::vector<double>> xs(count, std::vector<double>(256)), zs(count, std::vector<double>(256));
+    std::vector<double> ys(256);
+    for (int i = 0; i < count; i++) {
+        for (int c = 0; c < 256; c++) {
+            xs[i][c] = ((i % 16) * 16 + c / 16) * 0.05f;
+            zs[i][c] = ((i / 16) * 16 + c % 16) * 0.05f;
+        }
+    }
+    for (int c = 0; c < 256; c++) {
+        ys[c] = c * 0.03;
+    }
+
+    bench::Stats perColumn, batched;
+    bench::Stats fbmTime[2], fbm3Time[2];
+    std::vector<double> out(256);
+    int heights[256];
+
+    for (int r = 0; r < repeat; r++) {
+        for (int i = 0; i < count; i++) {
+            int cx = i % 16, cz = i / 16;
+
+            auto t0 = bench::Clock::now();
+            for (int x = 0; x < 16; x++)
+                for (int z = 0; z < 16; z++)
+                    heights[x * 16 + z] = generator.getTerrainHeight(cx * 16 + x, cz * 16 + z);
+            auto t1 = bench::Clock::now();
+            bench::doNotOptimize(heights);
+            generator.getTerrainHeights(cx * 16, cz * 16, 16, 16, heights);
+            auto t2 = bench::Clock::now();
+            bench::doNotOptimize(heights);
+
+            perColumn.add(bench::elapsedMs(t0, t1));
+            batched.add(bench::elapsedMs(t1, t2));
+
+            for (int b = 0; b < 2; b++) {
+                if (!PerlinNoise::isBackendSupported(BACKENDS[b])) continue;
+                auto s = bench::Clock::now();
+                noise.fbmBatch(xs[i].data(), zs[i].data(), out.data(), 256, 6, 0.5, BACKENDS[b]);
+                fbmTime[b].add(bench::elapsedMs(s, bench::Clock::now()));
+                bench::doNotOptimize(out);
+
+                s = bench::Clock::now();
+                noise.fbmBatch(xs[i].data(), ys.data(), zs[i].data(), out.data(), 256, 3, 0.5, BACKENDS[b]);
+                fbm3Time[b].add(bench::elapsedMs(s, bench::Clock::now()));
+                bench::doNotOptimize(out);
+            }
+        }
+    }
+
+    std::printf("%d chunks x %d runs, 16x16 columns, 6 octaves (3D: 3 octaves), single thread\n", count, repeat);
+    std::printf("all backends match scalar results exactly (3 seeds, heights with and without biomes)\n");
+    std::printf("best backend: %s\n\n", PerlinNoise::getBackendName(PerlinNoise::getBestBackend()));
+    std::printf("%-24s %10s %10s %10s %10s\n", "path", "avg ms", "min ms", "Mcol/s", "speedup");
+    report("getTerrainHeight", perColumn, perColumn.mean());
+    report("getTerrainHeights", batched, perColumn.mean());
+    for (int b = 0; b < 2; b++) {
+        if (!PerlinNoise::isBackendSupported(BACKENDS[b])) continue;
+        std::string name = std::string("fbmBatch ") + PerlinNoise::getBackendName(BACKENDS[b]);
+        report(name.c_str(), fbmTime[b], fbmTime[0].mean());
+    }
+    for (int b = 0; b < 2; b++) {
+        if (!PerlinNoise::isBackendSupported(BACKENDS[b])) continue;
+        std::string name = std::string("3D fbmBatch ") + PerlinNoise::getBackendName(BACKENDS[b]);
+        report(name.c_str(), fbm3Time[b], fbm3Time[0].mean());
+    }
+
+    LOG_FLUSH();
+    return 0;
+}
@@ -0,0 +1,271 @@
+// Region file persistence benchmark
+//
+// Generates a square of chunks spanning several region files, saves them
+// with RegionStore, then reopens the store and loads every chunk back
+// through the memory mapping. Reports generation, save and load cost per
+// chunk, and the same comparison for ChunkManager::pregenerate() of a
+// spawn area: first run generates and writes through, second run reads.
+//
+// Checks, failing the benchmark on any difference:
+//   - every loaded chunk holds exactly the saved blocks
+//   - a chunk saved again after an edit loads as the edited version, both
+//     from the open store (appended past the mapping) and after reopening
+//   - truncated and corrupted payloads are rejected, not decoded
+//   - ChunkManager regenerates a chunk whose payload is rejected from
+//     scratch, without blocks left over from the partial decode
+//
+// Usage: region_file_bench [--size=40] [--repeat=5] [--radius=8]
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <unistd.h>
+
+#include "bench_common.hpp"
+
+#include "game/chuck/chuck_manager.hpp"
+#include "game/storage/region_file.hpp"
+#include "utils/binary_io.hpp"
+
+namespace {
+
+using game::chuck::VoxelChunk;
+using game::storage::ChunkCodec;
+using game::storage::RegionStore;
+
+uint64_t directorySize(const std::filesystem::path& directory, size_t& files) {
+    uint64_t bytes = 0;
+    files          = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        bytes += entry.file_size();
+        files++;
+    }
+    return bytes;
+}
+
+bool checkEdits(const std::filesystem::path& directory, int chunkX, int chunkZ) {
+    VoxelChunk edited;
+    {
+        RegionStore store(directory);
+        if (!store.loadChunk(chunkX, chunkZ, edited)) {
+            std::printf("FAIL: chunk (%d, %d) was not stored\n", chunkX, chunkZ);
+            return false;
+        }
+
+        edited.setBlock(3, 200, 5, game::blocks::BlockIDs::WOOD);
+        edited.setBlock(0, 0, 0, game::blocks::BlockIDs::AIR);
+        edited.compact();
+        store.saveChunk(chunkX, chunkZ, edited);
+
+        VoxelChunk reloaded;
+        if (!store.loadChunk(chunkX, chunkZ, reloaded) || !bench::sameBlocks(reloaded, edited)) {
+            std::printf("MISMATCH: edited chunk (%d, %d) reloaded from the open store\n", chunkX, chunkZ);
+            return false;
+        }
+    }
+
+    RegionStore reopened(directory);
+    VoxelChunk reloaded;
+    if (!reopened.loadChunk(chunkX, chunkZ, reloaded) || !bench::sameBlocks(reloaded, edited)) {
+        std::printf("MISMATCH: edited chunk (%d, %d) reloaded after reopening\n", chunkX, chunkZ);
+        return false;
+    }
+    return true;
+}
+
+bool checkMalformed(const VoxelChunk& chunk) {
+    VoxelChunk scratch;
+    for (int c = 0; c < static_cast<int>(ChunkCodec::COUNT); c++) {
+        const char* name = game::storage::getChunkCodecName(static_cast<ChunkCodec>(c));
+        std::vector<uint8_t> payload;
+        game::storage::encodeChunk(chunk, static_cast<ChunkCodec>(c), payload);
+
+        for (size_t size : { size_t(0), size_t(1), payload.size() / 2, payload.size() - 1 }) {
+            if (game::storage::decodeChunk(payload.data(), size, scratch)) {
+                std::printf("FAIL: %s payload truncated to %zu of %zu bytes was accepted\n", name, size, payload.size());
+                return false;
+            }
+        }
+
+        payload.push_back(0);
+        if (game::storage::decodeChunk(payload.data(), payload.size(), scratch)) {
+            std::printf("FAIL: %s payload with trailing bytes was accepted\n", name);
+            return false;
+        }
+    }
+
+    std::vector<uint8_t> unknownCodec;
+    game::storage::encodeChunk(chunk, ChunkCodec::SECTIONS, unknownCodec);
+    unknownCodec[0] = 0xff;
+    if (game::storage::decodeChunk(unknownCodec.data(), unknownCodec.size(), scratch)) {
+        std::printf("FAIL: payload with an unknown codec was accepted\n");
+        return false;
+    }
+
+    // section 0 with a 3-entry palette at 2 bits; index 3 points past the palette
+    VoxelChunk threeTypes;
+    threeTypes.setBlock(0, 0, 0, game::blocks::BlockIDs::STONE);
+    threeTypes.setBlock(1, 0, 0, game::blocks::BlockIDs::DIRT);
+    std::vector<uint8_t> outOfPalette;
+    game::storage::encodeChunk(threeTypes, ChunkCodec::SECTIONS, outOfPalette);
+    constexpr size_t FIRST_WORD = 1 + 1 + 4 + 3 * 4; // codec, bits, palette size, palette
+    outOfPalette[FIRST_WORD + 7] = 0xff;
+    if (game::storage::decodeChunk(outOfPalette.data(), outOfPalette.size(), scratch)) {
+        std::printf("FAIL: payload with an index outside the palette was accepted\n");
+        return false;
+    }
+    return true;
+}
+
+// A stored chunk that fails to decode must be generated from scratch, not on top of a partly decoded one
+bool checkCorruptFallback(const std::filesystem::path& directory) {
+    game::generator::TerrainGenerator generator(1);
+    bench::configureGenerator(generator);
+
+    {
+        VoxelChunk sky;
+        for (int y = 200; y < 256; y++) {
+            for (int z = 0; z < 16; z++) {
+                for (int x = 0; x < 16; x++) sky.setBlock(x, y, z, game::blocks::BlockIDs::STONE);
+            }
+        }
+        sky.compact();
+        RegionStore store(directory);
+        store.setCodec(ChunkCodec::RLE);
+        store.saveChunk(0, 0, sky);
+    }
+
+    // cut the last byte off chunk (0, 0): the first sections still decode
+    {
+        std::fstream file(directory / RegionStore::getRegionFileName(0, 0), std::ios::in | std::ios::out | std::ios::binary);
+        uint8_t entry[game::storage::RegionFile::TABLE_ENTRY];
+        file.seekg(game::storage::RegionFile::HEADER_SIZE);
+        file.read(reinterpret_cast<char*>(entry), sizeof(entry));
+        std::vector<uint8_t> length;
+        utils::appendLE<uint32_t>(length, utils::readLE<uint32_t>(entry + 4) - 1);
+        file.seekp(game::storage::RegionFile::HEADER_SIZE + 4);
+        file.write(reinterpret_cast<const char*>(length.data()), length.size());
+    }
+
+    {
+        RegionStore store(directory);
+        game::chuck::ChunkManager manager(nullptr, &generator);
+        manager.setWorldStore(&store);
+        manager.pregenerate(glm::vec3(8.0f, 64.0f, 8.0f), 0);
+        if (store.getStats().failures != 1) {
+            std::printf("FAIL: the truncated chunk was not rejected\n");
+            return false;
+        }
+    }
+
+    // the regenerated chunk was written back over the broken one
+    VoxelChunk expected, reloaded;
+    generator.generateChunk(0, 0, expected);
+    RegionStore store(directory);
+    if (!store.loadChunk(0, 0, reloaded) || !bench::sameBlocks(reloaded, expected)) {
+        std::printf("MISMATCH: chunk regenerated after a failed load keeps blocks of the broken payload\n");
+        return false;
+    }
+    return true;
+}
+
+double pregenerateMs(const std::filesystem::path& directory, int radius) {
+    game::generator::TerrainGenerator generator(1);
+    bench::configureGenerator(generator);
+
+    RegionStore store(directory);
+    game::chuck::ChunkManager manager(nullptr, &generator);
+    manager.setWorldStore(&store);
+
+    auto start = bench::Clock::now();
+    manager.pregenerate(glm::vec3(8.0f, 64.0f, 8.0f), radius);
+    return bench::elapsedMs(start, bench::Clock::now());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::quietLogs();
+
+    int size   = bench::intArg(argc, argv, "size", 40);
+    int repeat = bench::intArg(argc, argv, "repeat", 5);
+    int radius = bench::intArg(argc, argv, "radius", 8);
+
+    std::filesystem::path root = std::filesystem::temp_directory_path() /
+    ("nt_region_bench_" + std::to_string(::getpid()));
+    std::filesystem::remove_all(root);
+
+    game::generator::TerrainGenerator generator(1);
+    bench::configureGenerator(generator);
+
+    // centred on the origin, so the square straddles region boundaries
+    const int origin = -size / 2;
+    const int count  = size * size;
+    std::vector<VoxelChunk> expected(count);
+
+    double generateMs = 0.0, saveMs = 0.0;
+    {
+        RegionStore store(root / "world");
+        for (int i = 0; i < count; i++) {
+            int chunkX = origin + i / size, chunkZ = origin + i % size;
+
+            auto t0 = bench::Clock::now();
+            VoxelChunk chunk;
+            generator.generateChunk(chunkX, chunkZ, chunk);
+            chunk.compact();
+            auto t1 = bench::Clock::now();
+            store.saveChunk(chunkX, chunkZ, chunk);
+            auto t2 = bench::Clock::now();
+
+            generateMs += bench::elapsedMs(t0, t1);
+            saveMs += bench::elapsedMs(t1, t2);
+            expected[i] = std::move(chunk);
+        }
+    }
+
+    // first pass from a freshly opened store, then warm passes
+    bench::Stats load;
+    for (int r = 0; r < repeat; r++) {
+        RegionStore store(root / "world");
+        auto start = bench::Clock::now();
+        for (int i = 0; i < count; i++) {
+            VoxelChunk chunk;
+            if (!store.loadChunk(origin + i / size, origin + i % size, chunk)) {
+                std::printf("FAIL: chunk %d was not loaded\n", i);
+                return 1;
+            }
+            if (r == 0 && !bench::sameBlocks(chunk, expected[i])) {
+                std::printf("MISMATCH: chunk %d differs after a save/load round trip\n", i);
+                return 1;
+            }
+            bench::doNotOptimize(chunk);
+        }
+        load.add(bench::elapsedMs(start, bench::Clock::now()));
+    }
+
+    VoxelChunk sample;
+    generator.generateChunk(0, 0, sample);
+    sample.compact();
+    if (!checkMalformed(sample) || !checkEdits(root / "world", -1, 0) || !checkCorruptFallback(root / "corrupt")) return 1;
+
+    size_t files;
+    uint64_t bytes = directorySize(root / "world", files);
+
+    std::printf("%dx%d chunks (%d), %zu region files, %.1f MiB, %.2f KiB per chunk\n",
+    size, size, count, files, bytes / 1048576.0, bytes / 1024.0 / count);
+    std::printf("all chunks round-trip; edits and malformed payloads handled\n\n");
+    std::printf("%-10s %12s %14s\n", "step", "us/chunk", "vs generate");
+    std::printf("%-10s %12.1f %13.2fx\n", "generate", generateMs * 1000.0 / count, 1.0);
+    std::printf("%-10s %12.1f %13.2fx\n", "save", saveMs * 1000.0 / count, saveMs / generateMs);
+    std::printf("%-10s %12.1f %13.2fx\n", "load", load.min * 1000.0 / count, load.min / generateMs);
+
+    // ChunkManager: the first start generates and writes the spawn area, the second reads it
+    double coldMs = pregenerateMs(root / "spawn", radius);
+    double warmMs = pregenerateMs(root / "spawn", radius);
+    std::printf("\npregenerate radius %d: %.1f ms generating + saving, %.1f ms loading (%.1fx faster)\n",
+    radius, coldMs, warmMs, coldMs / warmMs);
+
+    std::filesystem::remove_all(root);
+    LOG_FLUSH();
+    return 0;
+}
@@ -0,0 +1,212 @@
+// Terrain generation cost benchmark
+//
+// Compares TerrainMode::DENSITY (3D noise on a 4-block lattice, overhangs
+// and caves) with the 2D heightmap mode it builds on, each also with
+// climate biomes enabled:
+//
+//   single thread  generateChunk() into a compacted VoxelChunk with the
+//                  heightmap cache disabled, as on first generation
+//   worker pool    ChunkManager::pregenerate() of a spawn area, the path
+//                  the game takes on the generation workers
+//
+// "no caves" disables the cave noise to show what it costs on its own.
+// Density generation must stay within 2x of heightmap generation on a
+// single thread; the benchmark fails otherwise. The biome rows report
+// throughput with biomes enabled and the share of columns per biome.
+// With biomes, the voxel path must match the TerrainBlock path block for
+// block, or the benchmark fails.
+//
+// Benchmarked chunks are taken every --spread chunks, so they cover
+// several climate regions and biomes rather than one patch of terrain.
+//
+// Usage: terrain_density_bench [--chunks=256] [--repeat=5] [--spread=4] [--radius=8] [--workers=N]
+
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include "bench_common.hpp"
+
+#include "game/chuck/chuck_manager.hpp"
+#include "game/chuck/voxel_chunk.hpp"
+
+namespace {
+
+using game::chuck::VoxelChunk;
+using game::generator::BiomeType;
+using game::generator::TerrainGenerator;
+using game::generator::TerrainMode;
+
+constexpr double MAX_SLOWDOWN = 2.0;
+
+struct Variant {
+    const char* name;
+    TerrainMode mode;
+    bool caves;
+    bool biomes;
+};
+
+// The first two are compared against MAX_SLOWDOWN
+constexpr Variant VARIANTS[] = {
+    { "heightmap", TerrainMode::HEIGHTMAP, false, false },
+    { "density", TerrainMode::DENSITY, true, false },
+    { "no caves", TerrainMode::DENSITY, false, false },
+    { "heightmap+biomes", TerrainMode::HEIGHTMAP, false, true },
+    { "density+biomes", TerrainMode::DENSITY, true, true },
+};
+
+void configure(TerrainGenerator& generator, const Variant& variant) {
+    bench::configureGenerator(generator);
+    generator.setTerrainMode(variant.mode);
+    generator.setBiomesEnabled(variant.biomes);
+    if (!variant.caves) generator.setCaveThreshold(2.0f);
+}
+
+bool matchesBlockList(const TerrainGenerator& generator, const VoxelChunk& chunk, int cx, int cz) {
+    VoxelChunk expected;
+    for (const auto& block : generator.generateChunk(cx, cz, 16)) {
+        expected.setBlock(block.position.x - cx * 16, block.position.y, block.position.z - cz * 16, block.blockTypeId);
+    }
+    for (int y = 0; y < chunk.getSizeY(); y++)
+        for (int z = 0; z < 16; z++)
+            for (int x = 0; x < 16; x++)
+                if (chunk.getBlock(x, y, z) != expected.getBlock(x, y, z)) return false;
+    return true;
+}
+
+// Blocks that differ from the heightmap column: air under the surface
+// (caves, overhang hollows) and solid blocks above it (overhangs)
+struct Shape {
+    size_t hollow = 0;
+    size_t raised = 0;
+    size_t below  = 0;
+};
+
+void measureShape(const TerrainGenerator& generator, const VoxelChunk& chunk, int cx, int cz, Shape& shape) {
+    auto heightmap = generator.getHeightmap(cx, cz);
+    for (int x = 0; x < 16; x++) {
+        for (int z = 0; z < 16; z++) {
+            int height = heightmap->get(x, z);
+            for (int y = 0; y < chunk.getSizeY(); y++) {
+                uint32_t id = chunk.getBlock(x, y, z);
+                bool solid  = id != game::blocks::BlockIDs::AIR && id != game::blocks::BlockIDs::WATER;
+                if (y <= height) {
+                    shape.below++;
+                    if (!solid) shape.hollow++;
+                } else if (solid) {
+                    shape.raised++;
+                }
+            }
+        }
+    }
+}
+
+double pregenerateMs(const Variant& variant, size_t workers, int radius) {
+    TerrainGenerator generator(1);
+    configure(generator, variant);
+
+    game::chuck::ChunkManager manager(nullptr, &generator, workers);
+    auto start = bench::Clock::now();
+    manager.pregenerate(glm::vec3(8.0f, 64.0f, 8.0f), radius);
+    return bench::elapsedMs(start, bench::Clock::now());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::quietLogs();
+    game::blocks::initializeBlockTypes();
+
+    int count      = bench::intArg(argc, argv, "chunks", 256);
+    int repeat     = bench::intArg(argc, argv, "repeat", 5);
+    int spread     = bench::intArg(argc, argv, "spread", 4);
+    int radius     = bench::intArg(argc, argv, "radius", 8);
+    size_t workers = bench::intArg(argc, argv, "workers", static_cast<int>(utils::ThreadPool::defaultThreadCount()));
+
+    int width = 1;
+    while (width * width < count) width++;
+
+    std::printf("%d chunks x %d runs, every %d chunks, seed 1, single thread; pregenerate radius %d on %zu workers\n\n",
+    count, repeat, spread, radius, workers);
+    std::printf("%-16s %10s %10s %12s %9s %9s %14s\n",
+    "mode", "avg ms", "min ms", "chunks/s", "hollow %", "raised %", "pregenerate ms");
+
+    constexpr size_t VARIANT_COUNT = std::size(VARIANTS);
+
+    std::vector<std::unique_ptr<TerrainGenerator>> generators;
+    for (const Variant& variant : VARIANTS) {
+        generators.push_back(std::make_unique<TerrainGenerator>(1));
+        configure(*generators.back(), variant);
+        generators.back()->setHeightmapCacheCapacity(0);
+    }
+
+    // shape statistics and the biome check first, also warms caches and the allocator
+    Shape shapes[VARIANT_COUNT];
+    size_t biomeColumns[static_cast<size_t>(BiomeType::COUNT)] = {};
+    for (size_t v = 0; v < VARIANT_COUNT; v++) {
+        for (int i = 0; i < count; i++) {
+            int cx = (i % width) * spread, cz = (i / width) * spread;
+            VoxelChunk chunk;
+            generators[v]->generateChunk(cx, cz, chunk);
+            measureShape(*generators[v], chunk, cx, cz, shapes[v]);
+
+            if (VARIANTS[v].biomes && VARIANTS[v].mode == TerrainMode::HEIGHTMAP) {
+                if (!matchesBlockList(*generators[v], chunk, cx, cz)) {
+                    std::printf("FAIL: biome chunk (%d, %d) differs between the voxel and TerrainBlock paths\n", cx, cz);
+                    return 1;
+                }
+                for (BiomeType biome : generators[v]->getHeightmap(cx, cz)->biomes) {
+                    biomeColumns[static_cast<size_t>(biome)]++;
+                }
+            }
+        }
+    }
+
+    // variants take turns per chunk, so they see the same machine state
+    bench::Stats times[VARIANT_COUNT];
+    for (int r = 0; r < repeat; r++) {
+        for (int i = 0; i < count; i++) {
+            int cx = (i % width) * spread, cz = (i / width) * spread;
+            for (size_t v = 0; v < VARIANT_COUNT; v++) {
+                auto t0    = bench::Clock::now();
+                auto chunk = std::make_unique<VoxelChunk>();
+                generators[v]->generateChunk(cx, cz, *chunk);
+                chunk->compact();
+                auto t1 = bench::Clock::now();
+                bench::doNotOptimize(chunk);
+
+                times[v].add(bench::elapsedMs(t0, t1));
+            }
+        }
+    }
+
+    for (size_t v = 0; v < VARIANT_COUNT; v++) {
+        const bench::Stats& time = times[v];
+        std::printf("%-16s %10.3f %10.3f %12.0f %9.2f %9.2f %14.1f\n",
+        VARIANTS[v].name, time.mean(), time.min, 1000.0 / time.mean(),
+        100.0 * shapes[v].hollow / shapes[v].below, 100.0 * shapes[v].raised / shapes[v].below,
+        pregenerateMs(VARIANTS[v], workers, radius));
+    }
+
+    double slowdown = times[1].mean() / times[0].mean();
+    std::printf("\ndensity / heightmap: %.2fx (limit %.1fx)\n", slowdown, MAX_SLOWDOWN);
+    std::printf("biomes / none: heightmap %.2fx, density %.2fx\n",
+    times[3].mean() / times[0].mean(), times[4].mean() / times[1].mean());
+
+    std::printf("biome columns:");
+    for (size_t b = 0; b < static_cast<size_t>(BiomeType::COUNT); b++) {
+        std::printf(" %s %.1f%%", game::generator::getBiome(static_cast<BiomeType>(b)).name,
+        100.0 * biomeColumns[b] / (256.0 * count));
+    }
+    auto climate = generators[3]->getClimateCacheStats();
+    std::printf("\nclimate cache: %zu / %zu regions, %zu hits, %zu misses\n",
+    climate.entries, climate.capacity, climate.hits, climate.misses);
+
+    LOG_FLUSH();
+    if (slowdown > MAX_SLOWDOWN) {
+        std::printf("FAIL: density terrain is more than %.1fx slower than heightmap terrain\n", MAX_SLOWDOWN);
+        return 1;
+    }
+    return 0;
+}
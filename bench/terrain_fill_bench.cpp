@@ -0,0 +1,135 @@
+// Terrain-to-voxel fill benchmark
+//
+// Single-threaded time to turn one chunk of terrain into a compacted
+// VoxelChunk, the work every ChunkManager generation task does:
+//
+//   two-pass  TerrainGenerator::generateChunk() into a TerrainBlock list,
+//             then setBlock() per block (the previous ChunkManager path)
+//   direct    TerrainGenerator::generateChunk() straight into the chunk
+//             with run-length column and layer fills
+//
+// Heightmap caching is disabled for both, so every chunk samples noise as
+// on first generation. "direct cached" regenerates chunks whose heightmaps
+// are already in the generator's LRU, as happens for chunks regenerated
+// after their neighbours queried them. "height only" samples the 256
+// column heights one by one and nothing else.
+//
+// Both paths must produce identical chunks; the benchmark fails otherwise.
+//
+// Usage: terrain_fill_bench [--chunks=256] [--repeat=5]
+
+#include <cstdio>
+#include <memory>
+
+#include "bench_common.hpp"
+
+#include "game/chuck/voxel_chunk.hpp"
+
+namespace {
+
+using game::chuck::VoxelChunk;
+
+std::unique_ptr<VoxelChunk> twoPass(const game::generator::TerrainGenerator& generator, int cx, int cz) {
+    auto chunk = std::make_unique<VoxelChunk>();
+    for (const auto& block : generator.generateChunk(cx, cz, 16)) {
+        chunk->setBlock(block.position.x - cx * 16, block.position.y, block.position.z - cz * 16, block.blockTypeId);
+    }
+    chunk->compact();
+    return chunk;
+}
+
+std::unique_ptr<VoxelChunk> direct(const game::generator::TerrainGenerator& generator, int cx, int cz) {
+    auto chunk = std::make_unique<VoxelChunk>();
+    generator.generateChunk(cx, cz, *chunk);
+    chunk->compact();
+    return chunk;
+}
+
+void report(const char* name, const bench::Stats& s) {
+    std::printf("%-14s %10.3f %10.3f %10.3f %12.0f\n", name, s.mean(), s.min, s.max, 1000.0 / s.mean());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::quietLogs();
+    game::blocks::initializeBlockTypes();
+
+    int count  = bench::intArg(argc, argv, "chunks", 256);
+    int repeat = bench::intArg(argc, argv, "repeat", 5);
+
+    game::generator::TerrainGenerator generator(1);
+    bench::configureGenerator(generator);
+    generator.setHeightmapCacheCapacity(0);
+
+    game::generator::TerrainGenerator cachedGenerator(1);
+    bench::configureGenerator(cachedGenerator);
+
+    int width = 1;
+    while (width * width < count) width++;
+
+    // equivalence first, also warms caches and the allocator
+    size_t memory = 0;
+    for (int i = 0; i < count; i++) {
+        int cx = i % width, cz = i / width;
+        auto expected = twoPass(generator, cx, cz);
+        auto actual   = direct(generator, cx, cz);
+        if (!bench::sameBlocks(*expected, *actual)) {
+            std::printf("MISMATCH: direct fill disagrees with the TerrainBlock path at chunk (%d, %d)\n", cx, cz);
+            return 1;
+        }
+        memory += actual->getMemoryUsage();
+
+        // warm the LRU, which holds all benchmarked chunks at the default size
+        if (!bench::sameBlocks(*actual, *direct(cachedGenerator, cx, cz))) {
+            std::printf("MISMATCH: cached heightmap disagrees at chunk (%d, %d)\n", cx, cz);
+            return 1;
+        }
+    }
+
+    bench::Stats heightTime, twoPassTime, directTime, cachedTime;
+    for (int r = 0; r < repeat; r++) {
+        for (int i = 0; i < count; i++) {
+            int cx = i % width, cz = i / width;
+
+            auto t0    = bench::Clock::now();
+            int height = 0;
+            for (int x = 0; x < 16; x++)
+                for (int z = 0; z < 16; z++)
+                    height += generator.getTerrainHeight(cx * 16 + x, cz * 16 + z);
+            auto t1 = bench::Clock::now();
+            auto a  = twoPass(generator, cx, cz);
+            auto t2 = bench::Clock::now();
+            auto b  = direct(generator, cx, cz);
+            auto t3 = bench::Clock::now();
+            auto c  = direct(cachedGenerator, cx, cz);
+            auto t4 = bench::Clock::now();
+            bench::doNotOptimize(height);
+            bench::doNotOptimize(a);
+            bench::doNotOptimize(b);
+            bench::doNotOptimize(c);
+
+            heightTime.add(bench::elapsedMs(t0, t1));
+            twoPassTime.add(bench::elapsedMs(t1, t2));
+            directTime.add(bench::elapsedMs(t2, t3));
+            cachedTime.add(bench::elapsedMs(t3, t4));
+        }
+    }
+
+    std::printf("%d chunks x %d runs, seed 1, %.1f KiB voxel storage per chunk, single thread\n\n",
+    count, repeat, memory / 1024.0 / count);
+    std::printf("%-14s %10s %10s %10s %12s\n", "path", "avg ms", "min ms", "max ms", "chunks/s");
+    report("height only", heightTime);
+    report("two-pass", twoPassTime);
+    report("direct", directTime);
+    report("direct cached", cachedTime);
+    std::printf("\nspeedup: %.1fx, %.1fx with a cached heightmap\n",
+    twoPassTime.mean() / directTime.mean(), twoPassTime.mean() / cachedTime.mean());
+
+    auto cache = cachedGenerator.getHeightmapCacheStats();
+    std::printf("heightmap cache: %zu / %zu entries, %zu hits, %zu misses\n",
+    cache.entries, cache.capacity, cache.hits, cache.misses);
+
+    LOG_FLUSH();
+    return 0;
+}
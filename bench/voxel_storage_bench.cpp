@@ -0,0 +1,164 @@
+// Voxel storage benchmark
+//
+// Fills chunks from the terrain generator and compares the sectioned,
+// palette compressed VoxelChunk against the original flat
+// std::vector<uint32_t> layout: resident memory, bulk write and read
+// throughput, and how many sections need no storage at all.
+//
+// Usage: voxel_storage_bench [--chunks=64] [--resident=200]
+
+#include <cstdio>
+#include <memory>
+#include <random>
+
+#include "bench_common.hpp"
+#include "flat_voxel_chunk.hpp"
+
+#include "game/chuck/voxel_chunk.hpp"
+
+namespace {
+
+using bench::FlatVoxelChunk;
+using bench::SIZE_X;
+using bench::SIZE_Y;
+using bench::SIZE_Z;
+using bench::VOLUME;
+
+struct Column {
+    std::vector<game::generator::TerrainBlock> blocks;
+    int chunkX, chunkZ;
+};
+
+template <typename ChunkT>
+struct StorageResult {
+    std::vector<std::unique_ptr<ChunkT>> chunks;
+    double writeMs = 0.0;
+    double readMs  = 0.0;
+    double randMs  = 0.0;
+    size_t memory  = 0;
+};
+
+template <typename ChunkT>
+StorageResult<ChunkT> measure(const std::vector<Column>& input, const std::vector<glm::ivec3>& probes) {
+    StorageResult<ChunkT> r;
+
+    auto t0 = bench::Clock::now();
+    for (const auto& column : input) {
+        auto chunk = std::make_unique<ChunkT>();
+        for (const auto& b : column.blocks) {
+            chunk->setBlock(b.position.x - column.chunkX * 16, b.position.y, b.position.z - column.chunkZ * 16, b.blockTypeId);
+        }
+        r.chunks.push_back(std::move(chunk));
+    }
+    auto t1 = bench::Clock::now();
+
+    // sequential full scan in the order the mesher walks (x, y, z)
+    uint64_t sum = 0;
+    for (const auto& chunk : r.chunks) {
+        for (int x = 0; x < SIZE_X; x++)
+            for (int y = 0; y < SIZE_Y; y++)
+                for (int z = 0; z < SIZE_Z; z++)
+                    sum += chunk->getBlock(x, y, z);
+    }
+    auto t2 = bench::Clock::now();
+
+    for (const auto& chunk : r.chunks) {
+        for (const auto& p : probes) {
+            sum += chunk->getBlock(p.x, p.y, p.z);
+        }
+    }
+    auto t3 = bench::Clock::now();
+    bench::doNotOptimize(sum);
+
+    r.writeMs = bench::elapsedMs(t0, t1);
+    r.readMs  = bench::elapsedMs(t1, t2);
+    r.randMs  = bench::elapsedMs(t2, t3);
+    for (const auto& chunk : r.chunks) {
+        r.memory += chunk->getMemoryUsage();
+    }
+    return r;
+}
+
+template <typename ChunkT>
+void report(const char* name, const StorageResult<ChunkT>& r, size_t chunkCount, size_t probeCount, int resident) {
+    double blocks   = static_cast<double>(chunkCount) * VOLUME;
+    double perChunk = static_cast<double>(r.memory) / chunkCount;
+    std::printf("%-12s %12.1f %14.2f %14.1f %14.1f %14.1f\n",
+    name, perChunk / 1024.0, perChunk * resident / (1024.0 * 1024.0),
+    blocks / (r.writeMs * 1000.0), blocks / (r.readMs * 1000.0),
+    chunkCount * probeCount / (r.randMs * 1000.0));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::quietLogs();
+    game::blocks::initializeBlockTypes();
+
+    int side     = bench::intArg(argc, argv, "chunks", 64);
+    int resident = bench::intArg(argc, argv, "resident", 200);
+
+    game::generator::TerrainGenerator generator(1);
+    bench::configureGenerator(generator);
+
+    int width = 1;
+    while (width * width < side) width++;
+
+    std::vector<Column> input;
+    for (int i = 0; i < side; i++) {
+        int cx = i % width, cz = i / width;
+        input.push_back({ generator.generateChunk(cx, cz, 16), cx, cz });
+    }
+
+    std::mt19937 rng(42);
+    std::vector<glm::ivec3> probes(1 << 16);
+    for (auto& p : probes) {
+        p = glm::ivec3(rng() % SIZE_X, rng() % SIZE_Y, rng() % SIZE_Z);
+    }
+
+    auto flat    = measure<FlatVoxelChunk>(input, probes);
+    auto palette = measure<game::chuck::VoxelChunk>(input, probes);
+    for (auto& chunk : palette.chunks) {
+        chunk->compact();
+    }
+    palette.memory = 0;
+    for (const auto& chunk : palette.chunks) {
+        palette.memory += chunk->getMemoryUsage();
+    }
+
+    std::printf("%zu chunks, memory extrapolated to %d resident chunks\n\n", input.size(), resident);
+    std::printf("%-12s %12s %14s %14s %14s %14s\n",
+    "storage", "KiB/chunk", "MiB resident", "write Mblk/s", "scan Mblk/s", "rand Mblk/s");
+    report("flat", flat, input.size(), probes.size(), resident);
+    report("sections", palette, input.size(), probes.size(), resident);
+
+    // how sections are stored after compact(): 0 bits = uniform, no storage
+    int empty = 0, uniform = 0, histogram[17] = {};
+    for (const auto& chunk : palette.chunks) {
+        for (int i = 0; i < game::chuck::VoxelChunk::SECTION_COUNT; i++) {
+            const auto& section = chunk->getSection(i);
+            if (section.isEmpty()) empty++;
+            else if (section.isUniform()) uniform++;
+            else histogram[section.getBitsPerBlock()]++;
+        }
+    }
+    std::printf("\nsections: empty %d, uniform solid %d", empty, uniform);
+    for (int bits = 1; bits <= 16; bits *= 2) {
+        std::printf(", %d-bit %d", bits, histogram[bits]);
+    }
+    std::printf("\n");
+
+    // both layouts must hold the same blocks
+    for (size_t i = 0; i < input.size(); i++) {
+        for (int x = 0; x < SIZE_X; x++)
+            for (int y = 0; y < SIZE_Y; y++)
+                for (int z = 0; z < SIZE_Z; z++)
+                    if (flat.chunks[i]->getBlock(x, y, z) != palette.chunks[i]->getBlock(x, y, z)) {
+                        std::printf("MISMATCH in chunk %zu at (%d, %d, %d)\n", i, x, y, z);
+                        return 1;
+                    }
+    }
+
+    LOG_FLUSH();
+    return 0;
+}
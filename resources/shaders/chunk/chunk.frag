@@ -0,0 +1,32 @@
+#version 330 core
+
+out vec4 FragColor;
+
+in vec3 FragPos;
+in vec3 Normal;
+in vec2 LocalUV;
+flat in uint TextureLayer;
+
+uniform sampler2DArray blockTextures;
+uniform vec3 lightPos;
+uniform vec3 viewPos;
+uniform vec3 lightColor;
+
+void main() {
+    // 合并面跨越多个方块，每层纹理自己重复，效果等同 fract(LocalUV)；
+    // 不在着色器里取小数，UV 导数在方块接缝处保持连续，mipmap 层级选择不会跳变
+    vec4 texColor = texture(blockTextures, vec3(LocalUV, float(TextureLayer)));
+
+    // 环境光
+    float ambientStrength = 0.3;
+    vec3 ambient          = ambientStrength * lightColor;
+
+    // 漫反射
+    vec3 norm     = normalize(Normal);
+    vec3 lightDir = normalize(lightPos - FragPos);
+    float diff    = max(dot(norm, lightDir), 0.0);
+    vec3 diffuse  = diff * lightColor;
+
+    vec3 result = (ambient + diffuse) * texColor.rgb;
+    FragColor   = vec4(result, texColor.a);
+}
@@ -0,0 +1,43 @@
+#version 330 core
+
+// 打包的区块顶点，见 renderer::ChunkVertex
+// x: 位置 x(5) | y(9) | z(5) | 面(3)，y: 纹理数组层(16)
+layout(location = 0) in uvec2 aPacked;
+// 区块 (x, z) 角的世界方块坐标：多重间接绘制时为逐实例属性，由 baseInstance 选取；
+// GL 3.3 回退路径下为每次绘制前设置的常量属性
+layout(location = 1) in ivec2 aChunkOrigin;
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec2 LocalUV;            // 以方块为单位的纹理坐标，纹理的 GL_REPEAT 在每个方块上重复一次
+flat out uint TextureLayer;  // 方块纹理数组的层
+
+uniform mat4 view;
+uniform mat4 projection;
+
+// 顺序与 blocks::BlockFace 一致：FRONT, BACK, LEFT, RIGHT, TOP, BOTTOM
+const vec3 NORMALS[6] = vec3[6](
+    vec3(0.0, 0.0, 1.0), vec3(0.0, 0.0, -1.0),
+    vec3(-1.0, 0.0, 0.0), vec3(1.0, 0.0, 0.0),
+    vec3(0.0, 1.0, 0.0), vec3(0.0, -1.0, 0.0));
+
+void main() {
+    uint p    = aPacked.x;
+    vec3 pos  = vec3(float(p & 31u), float((p >> 5u) & 511u), float((p >> 14u) & 31u));
+    uint face = (p >> 19u) & 7u;
+
+    // 纹理方向与逐面网格一致：侧面 v 朝上，从外侧看不镜像
+    if (face == 0u) LocalUV = vec2(pos.x, pos.y);
+    else if (face == 1u) LocalUV = vec2(-pos.x, pos.y);
+    else if (face == 2u) LocalUV = vec2(pos.z, pos.y);
+    else if (face == 3u) LocalUV = vec2(-pos.z, pos.y);
+    else if (face == 4u) LocalUV = vec2(pos.x, -pos.z);
+    else LocalUV = vec2(pos.x, pos.z);
+
+    TextureLayer = aPacked.y & 65535u;
+
+    FragPos = vec3(float(aChunkOrigin.x), 0.0, float(aChunkOrigin.y)) + pos;
+    Normal  = NORMALS[face];
+
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+}
@@ -12,7 +12,7 @@ uniform vec3 viewPos;
 uniform vec3 lightColor;
 
 void main() {
-    // 采样纹理
+    // 单个方块的面只覆盖一个子纹理，不需要平铺
     vec4 texColor = texture(texture1, TexCoord);
 
     // 环境光
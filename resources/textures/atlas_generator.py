@@ -148,6 +148,10 @@ def main():
     print(f"实际使用 {len(metadata['textures'])} 个纹理")
     print(f"剩余容量: {builder.max_textures - len(metadata['textures'])} 个纹理")
     
+    # 游戏启动时读取的是二进制元数据和预压缩纹理，JSON 和 PNG 只是编辑格式
+    print(f"\n请重新生成二进制元数据: atlas_cook --in={OUTPUT_METADATA}")
+    print(f"请重新生成压缩纹理: texture_cook --in={OUTPUT_ATLAS} --tile={TEXTURE_SIZE}")
+    
     return 0
 
 if __name__ == "__main__":
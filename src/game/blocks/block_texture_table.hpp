@@ -0,0 +1,75 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "renderer/texture/texture_atlas.hpp"
+#include "utils/logger/logger.hpp"
+
+#include "blocks_types.hpp"
+
+namespace game::blocks {
+
+/**
+ * 方块 ID 与面 -> 方块纹理数组层的查找表
+ *
+ * 启动时由冻结的注册表和图集一次解析完，网格生成只做数组下标，不再按纹理名查哈希表。
+ * 图集中缺少的纹理在解析时每个名字警告一次，并退回第 0 层。
+ * 之后只读，可被多个网格工作线程同时使用。
+ */
+class BlockTextureTable {
+    public:
+    explicit BlockTextureTable(const renderer::TextureAtlas& atlas,
+    const BlockTypeRegistry& registry = BlockTypeRegistry::getInstance()) {
+        if (!registry.isFrozen()) {
+            throw std::logic_error("Block textures must be resolved after initializeBlockTypes()");
+        }
+
+        const BlockPropertyTable& properties = registry.getProperties();
+
+        // 先按纹理名解析一次，每个名字只查一次图集
+        std::vector<uint16_t> resolved(properties.getTextureCount(), 0);
+        for (size_t i = 0; i < resolved.size(); i++) {
+            const std::string& name = properties.getTextureName(static_cast<uint16_t>(i));
+            if (atlas.hasTexture(name)) {
+                resolved[i] = static_cast<uint16_t>(atlas.getLayer(name));
+            } else {
+                LOG_WARN("Texture '", name, "' is not in the atlas; its block faces use layer 0");
+                missing++;
+            }
+        }
+
+        uint32_t count = 0;
+        for (const auto& [id, blockType] : registry.getAllBlockTypes()) {
+            count = std::max(count, id + 1);
+        }
+        layers.resize(count);
+
+        for (uint32_t id = 0; id < count; id++) {
+            if (!properties.isRegistered(id)) continue;
+            for (int face = 0; face < 6; face++) {
+                layers[id][face] = resolved[properties.getTextureIndex(id, static_cast<BlockFace>(face))];
+            }
+        }
+    }
+
+    // 调用方需保证 id 已注册
+    uint16_t getLayer(uint32_t id, BlockFace face) const {
+        return layers[id][static_cast<int>(face)];
+    }
+
+    // 图集中找不到的纹理数
+    size_t getMissingCount() const {
+        return missing;
+    }
+
+    private:
+    std::vector<std::array<uint16_t, 6>> layers; // [ID][面]
+    size_t missing = 0;
+};
+
+} // namespace game::blocks
@@ -16,9 +16,10 @@ constexpr uint32_t SAND   = 6;
 constexpr uint32_t WATER  = 7;
 } // namespace BlockIDs
 
-// 初始化所有方块类型
+// 初始化所有方块类型并冻结属性表；重复调用不做任何事
 inline void initializeBlockTypes() {
     auto& registry = BlockTypeRegistry::getInstance();
+    if (registry.isFrozen()) return;
 
     // 草方块
     registry.registerBlock("grass")
@@ -46,6 +47,8 @@ inline void initializeBlockTypes() {
     registry.registerBlock("sand")
     .setTexture("sand")
     .setHardness(0.5f);
+
+    registry.freeze();
 }
 
 } // namespace game::blocks
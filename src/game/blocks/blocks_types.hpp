@@ -3,10 +3,14 @@
 #include <string>
 
 #include "renderer/texture/texture.hpp"
+#include <array>
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace game::blocks {
 
@@ -90,6 +94,58 @@ struct BlockType {
     }
 };
 
+/**
+ * 按方块 ID 直接下标的只读属性表，供网格生成、碰撞等热循环使用
+ *
+ * 由 BlockTypeRegistry::freeze() 在所有方块注册完后一次生成，之后不再改变，
+ * 工作线程无需加锁。每种属性一个 64 字节对齐的位集，每个面的纹理是
+ * getTextureName() 的下标，查询只是一次数组访问，不经过注册表的哈希表。
+ * ID 0（空气）、未注册或超出 MAX_BLOCK_TYPES 的 ID 所有位都为 0：不渲染、不遮挡、不碰撞。
+ */
+class BlockPropertyTable {
+    public:
+    static constexpr uint32_t MAX_BLOCK_TYPES = 1024;
+
+    bool isRegistered(uint32_t id) const { return test(registered, id); }
+    bool isSolid(uint32_t id) const { return test(solid, id); }             // 参与碰撞
+    bool isTransparent(uint32_t id) const { return test(transparent, id); } // 可以看到背后的方块
+    bool isOccluding(uint32_t id) const { return test(occluding, id); }     // 遮挡相邻方块的面；目前与实心相同，树叶也遮挡
+
+    // 调用方需保证 id 已注册
+    uint16_t getTextureIndex(uint32_t id, BlockFace face) const {
+        return faceTextures[id][static_cast<int>(face)];
+    }
+
+    const std::string& getTextureName(uint16_t index) const {
+        return textureNames[index];
+    }
+
+    // 所有方块用到的不同纹理数
+    size_t getTextureCount() const {
+        return textureNames.size();
+    }
+
+    private:
+    friend class BlockTypeRegistry;
+
+    using Bits = std::array<uint64_t, MAX_BLOCK_TYPES / 64>;
+
+    static bool test(const Bits& bits, uint32_t id) {
+        return id < MAX_BLOCK_TYPES && (bits[id >> 6] >> (id & 63)) & 1u;
+    }
+
+    static void set(Bits& bits, uint32_t id) {
+        bits[id >> 6] |= uint64_t(1) << (id & 63);
+    }
+
+    alignas(64) Bits registered{};
+    alignas(64) Bits solid{};
+    alignas(64) Bits transparent{};
+    alignas(64) Bits occluding{};
+    alignas(64) std::array<std::array<uint16_t, 6>, MAX_BLOCK_TYPES> faceTextures{}; // [ID][面]
+    std::vector<std::string> textureNames;
+};
+
 // 方块类型管理器
 class BlockTypeRegistry {
     private:
@@ -97,6 +153,10 @@ class BlockTypeRegistry {
     std::unordered_map<std::string, BlockType*> blockTypesByName;
     uint32_t nextId;
 
+    // 冻结前全为空气；对象本身不会重建，提前取得的引用在冻结后同样有效
+    BlockPropertyTable properties;
+    bool frozen = false;
+
     BlockTypeRegistry() : nextId(1) {} // ID 0 保留给空气
 
     public:
@@ -108,6 +168,13 @@ class BlockTypeRegistry {
 
     // 注册方块类型
     BlockType& registerBlock(const std::string& name) {
+        if (frozen) {
+            throw std::logic_error("Cannot register block '" + name + "' after the registry is frozen");
+        }
+        if (nextId >= BlockPropertyTable::MAX_BLOCK_TYPES) {
+            throw std::length_error("Too many block types");
+        }
+
         uint32_t id    = nextId++;
         auto blockType = std::make_unique<BlockType>(id, name);
         BlockType* ptr = blockType.get();
@@ -141,14 +208,58 @@ class BlockTypeRegistry {
         return blockTypesById;
     }
 
+    /**
+     * 由已注册的方块生成属性表，之后不能再注册方块
+     *
+     * 冻结后再修改 BlockType 的属性不会反映到属性表中。
+     */
+    void freeze() {
+        properties = BlockPropertyTable();
+
+        std::unordered_map<std::string, uint16_t> textureIndices;
+        for (const auto& [id, blockType] : blockTypesById) {
+            BlockPropertyTable::set(properties.registered, id);
+            if (blockType->isSolid) {
+                BlockPropertyTable::set(properties.solid, id);
+                BlockPropertyTable::set(properties.occluding, id);
+            }
+            if (blockType->isTransparent) {
+                BlockPropertyTable::set(properties.transparent, id);
+            }
+
+            for (int face = 0; face < 6; face++) {
+                const std::string& name = blockType->textures[face];
+                auto [it, inserted]     = textureIndices.try_emplace(name, static_cast<uint16_t>(properties.textureNames.size()));
+                if (inserted) properties.textureNames.push_back(name);
+                properties.faceTextures[id][face] = it->second;
+            }
+        }
+        frozen = true;
+    }
+
+    bool isFrozen() const {
+        return frozen;
+    }
+
+    const BlockPropertyTable& getProperties() const {
+        return properties;
+    }
+
     // 清空注册表
     void clear() {
         blockTypesById.clear();
         blockTypesByName.clear();
-        nextId = 1;
+        nextId     = 1;
+        properties = BlockPropertyTable();
+        frozen     = false;
     }
 };
 
+// 冻结后的方块属性表；在热循环外取一次引用，循环内直接查询
+inline const BlockPropertyTable& getBlockProperties() {
+    return BlockTypeRegistry::getInstance().getProperties();
+}
+
 // 方块实例（世界中的一个方块）
 struct Block {
     uint32_t typeId;
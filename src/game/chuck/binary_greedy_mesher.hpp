@@ -0,0 +1,465 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "game/blocks/block_texture_table.hpp"
+#include "game/blocks/blocks_types.hpp"
+#include "game/chuck/chunk_mesher.hpp"
+
+namespace game::chuck {
+
+/**
+ * 位掩码贪婪网格生成器
+ *
+ * 与 GreedyMesher 生成完全相同的四边形，但不逐个比较遮罩条目：
+ * 1. 解码一次区块，把每个方块写进三组 16 位行掩码（沿 X / Y / Z 方向各一组），
+ *    同时记下每个方块的类型槽位；每种方块类型只查一次属性表和纹理表
+ * 2. 可见面 = 可渲染行 & ~(相邻方向平移一位后的实心行)，边界位来自相邻分段或邻居区块
+ * 3. 可见面按方块类型拆到 16 位宽的平面上，用 ctz 找到连续段，
+ *    逐行向下扩展时整段一次比较，完成贪婪合并
+ *
+ * 全空气分段完全跳过，全同一方块的分段整行填充，不逐个解码。
+ *
+ * 行掩码用 16 位而不是 64 位：区块宽 16，一行正好一个 uint16_t，移位不会串到相邻行；
+ * 把 4 行拼进一个 uint64_t 需要在每次移位后屏蔽行间进位，Y 方向则要跨分段拼接，
+ * 而 ctz / 移位 / 与运算的次数并不减少。
+ *
+ * 掩码和平面放在每个线程复用的暂存区里，每次只清理本区块用到的行。
+ * 无共享状态，可被多个网格工作线程同时调用。
+ */
+class BinaryGreedyMesher : public ChunkMesher {
+    public:
+    explicit BinaryGreedyMesher(const blocks::BlockTextureTable* textureTable)
+    : textures(textureTable) {
+        if (!textures) {
+            throw std::runtime_error("BlockTextureTable cannot be null");
+        }
+    }
+
+    // 单独生成一个区块的网格，区块外一律视为空气
+    renderer::ChunkMeshData generateMesh(const VoxelChunk& chunk) const {
+        return generateMesh(ChunkNeighborhood(chunk));
+    }
+
+    renderer::ChunkMeshData generateMesh(const ChunkNeighborhood& neighborhood) const override {
+        const VoxelChunk& chunk = *neighborhood.center;
+        renderer::ChunkMeshData mesh;
+
+        int lowest = chunk.getLowestNonEmptySection();
+        if (lowest < 0) return mesh;
+        int highest = chunk.getHighestNonEmptySection();
+
+        Scratch& scratch = getScratch();
+        Masks& masks     = scratch.masks;
+        clearMasks(masks, lowest, highest);
+        SlotTable slots(*neighborhood.properties);
+
+        for (int s = lowest; s <= highest; s++) {
+            decodeSection(chunk.getSection(s), s, slots, masks);
+        }
+        decodeBorders(neighborhood, lowest, highest, slots, masks);
+
+        // 每个类型槽位一块平面：4096 行 16 位，X / Z 面为 [16 层][256 行]，Y 面为 [256 层][16 行]
+        // 合并时会清掉用过的位，所以六个方向以及之后的区块都可以复用同一块内存
+        std::vector<uint16_t>& planes = scratch.planes;
+        if (!scratch.planesClean) {
+            std::fill(planes.begin(), planes.end(), 0);
+        }
+        if (planes.size() < slots.info.size() * PLANE_ROWS) {
+            planes.resize(slots.info.size() * PLANE_ROWS, 0);
+        }
+        scratch.planesClean = false; // 中途抛出异常时，下一次整块清零
+
+        int y0 = lowest * SECTION;
+        int y1 = (highest + 1) * SECTION;
+
+        for (int faceIdx = 0; faceIdx < 6; faceIdx++) {
+            auto face = static_cast<blocks::BlockFace>(faceIdx);
+            fillPlanes(face, lowest, highest, masks, planes);
+
+            for (size_t slot = 1; slot < slots.info.size(); slot++) {
+                const SlotInfo& info = slots.info[slot];
+                uint16_t* plane      = planes.data() + slot * PLANE_ROWS;
+
+                if (face == blocks::BlockFace::TOP || face == blocks::BlockFace::BOTTOM) {
+                    for (int y = y0; y < y1; y++) {
+                        mergePlane(plane + y * SECTION, SECTION, face, y, info.textureLayers[faceIdx], mesh);
+                    }
+                } else {
+                    for (int layer = 0; layer < SECTION; layer++) {
+                        // X / Z 面的行即 Y 坐标，只扫描非空分段覆盖的高度
+                        mergePlane(plane + layer * CHUNK_HEIGHT + y0, y1 - y0, face, layer,
+                        info.textureLayers[faceIdx], mesh, y0);
+                    }
+                }
+            }
+        }
+        scratch.planesClean = true;
+
+        return mesh;
+    }
+
+    private:
+    static constexpr int SECTION      = VoxelChunk::SECTION_SIZE;
+    static constexpr int SECTIONS     = VoxelChunk::SECTION_COUNT;
+    static constexpr int CHUNK_HEIGHT = SECTION * SECTIONS;
+    static constexpr int PLANE_ROWS   = SECTION * CHUNK_HEIGHT;
+
+    const blocks::BlockTextureTable* textures;
+
+    // 槽位 0 表示空气或未注册的方块：不渲染，也不遮挡
+    struct SlotInfo {
+        uint32_t typeId;
+        bool solid; // 遮挡相邻方块的面
+        std::array<uint16_t, 6> textureLayers; // 每个面在纹理数组中的层
+    };
+
+    // 方块 ID -> 槽位，每种 ID 只查一次属性表和纹理表
+    struct SlotTable {
+        static constexpr uint8_t UNKNOWN = 0xFF;
+
+        const blocks::BlockPropertyTable& properties; // 取自 ChunkNeighborhood
+        std::array<uint8_t, 256> smallIds;           // ID < 256 的直接映射
+        std::vector<SlotInfo> info;
+
+        explicit SlotTable(const blocks::BlockPropertyTable& table) : properties(table) {
+            smallIds.fill(UNKNOWN);
+            smallIds[0] = 0;
+            info.push_back({ 0, false, {} });
+        }
+    };
+
+    // 每个方块一位的行掩码；实心掩码用于剔除，可渲染掩码决定面属于谁
+    struct Masks {
+        uint8_t slot[CHUNK_HEIGHT * SECTION * SECTION];  // [y][z][x] 类型槽位
+        uint16_t renderX[CHUNK_HEIGHT][SECTION];         // [y][z]，第 x 位
+        uint16_t solidX[CHUNK_HEIGHT][SECTION];          // [y][z]，第 x 位
+        uint16_t renderZ[CHUNK_HEIGHT][SECTION];         // [y][x]，第 z 位
+        uint16_t solidZ[CHUNK_HEIGHT][SECTION];          // [y][x]，第 z 位
+        uint16_t renderY[SECTIONS][SECTION][SECTION];    // [分段][z][x]，第 y & 15 位
+        uint16_t solidY[SECTIONS][SECTION][SECTION];     // [分段][z][x]，第 y & 15 位
+        uint16_t borderSolid[4][CHUNK_HEIGHT];           // 按 ChunkNeighborhood::Side，[y] 沿边界的位
+    };
+
+    struct Scratch {
+        Masks masks{};
+        std::vector<uint16_t> planes; // 调用之间保持全零
+        bool planesClean = true;
+    };
+
+    // 每个网格线程一份，约 115 KiB，只在线程第一次生成网格时清零分配
+    static Scratch& getScratch() {
+        thread_local std::unique_ptr<Scratch> scratch = std::make_unique<Scratch>();
+        return *scratch;
+    }
+
+    /**
+     * 清掉上一个区块留下的行：本区块非空分段的高度范围，以及上下各一个分段
+     * （TOP / BOTTOM 会读相邻分段的最低 / 最高位）。
+     * 类型槽位不用清：只在可渲染位为 1 的位置读取，而这些位置本次都写过。
+     */
+    static void clearMasks(Masks& m, int lowest, int highest) {
+        int y0      = lowest * SECTION;
+        int y1      = (highest + 1) * SECTION;
+        size_t rows = static_cast<size_t>(y1 - y0) * SECTION * sizeof(uint16_t);
+        std::memset(m.renderX[y0], 0, rows);
+        std::memset(m.solidX[y0], 0, rows);
+        std::memset(m.renderZ[y0], 0, rows);
+        std::memset(m.solidZ[y0], 0, rows);
+        for (int side = 0; side < 4; side++) {
+            std::memset(m.borderSolid[side] + y0, 0, (y1 - y0) * sizeof(uint16_t));
+        }
+
+        int s0          = std::max(lowest - 1, 0);
+        int s1          = std::min(highest + 1, SECTIONS - 1);
+        size_t sections = static_cast<size_t>(s1 - s0 + 1) * sizeof(m.renderY[0]);
+        std::memset(m.renderY[s0], 0, sections);
+        std::memset(m.solidY[s0], 0, sections);
+    }
+
+    uint8_t getSlot(uint32_t typeId, SlotTable& slots) const {
+        if (typeId < slots.smallIds.size() && slots.smallIds[typeId] != SlotTable::UNKNOWN) {
+            return slots.smallIds[typeId];
+        }
+        for (size_t i = 1; i < slots.info.size(); i++) {
+            if (slots.info[i].typeId == typeId) return static_cast<uint8_t>(i);
+        }
+
+        uint8_t slot                                 = 0;
+        const blocks::BlockPropertyTable& properties = slots.properties;
+        if (properties.isRegistered(typeId)) {
+            if (slots.info.size() == SlotTable::UNKNOWN) {
+                throw std::runtime_error("Too many distinct block types in one chunk");
+            }
+            SlotInfo info{ typeId, properties.isOccluding(typeId), {} };
+            for (int face = 0; face < 6; face++) {
+                info.textureLayers[face] = textures->getLayer(typeId, static_cast<blocks::BlockFace>(face));
+            }
+            slot = static_cast<uint8_t>(slots.info.size());
+            slots.info.push_back(info);
+        }
+
+        if (typeId < slots.smallIds.size()) {
+            slots.smallIds[typeId] = slot;
+        }
+        return slot;
+    }
+
+    void decodeSection(const ChunkSection& section, int s, SlotTable& slots, Masks& m) const {
+        if (section.isEmpty()) return;
+
+        int base = s * SECTION;
+
+        if (section.isUniform()) {
+            uint8_t slot = getSlot(section.getUniformType(), slots);
+            if (slot == 0) return;
+
+            bool solid = slots.info[slot].solid;
+            std::memset(m.slot + (base << 8), slot, SECTION * SECTION * SECTION);
+            for (int y = base; y < base + SECTION; y++) {
+                for (int i = 0; i < SECTION; i++) {
+                    m.renderX[y][i] = m.renderZ[y][i] = 0xFFFF;
+                    if (solid) m.solidX[y][i] = m.solidZ[y][i] = 0xFFFF;
+                }
+            }
+            for (int z = 0; z < SECTION; z++) {
+                for (int x = 0; x < SECTION; x++) {
+                    m.renderY[s][z][x] = 0xFFFF;
+                    if (solid) m.solidY[s][z][x] = 0xFFFF;
+                }
+            }
+            return;
+        }
+
+        uint32_t lastId  = 0;
+        uint8_t lastSlot = 0;
+        for (int ly = 0; ly < SECTION; ly++) {
+            int y = base + ly;
+            for (int z = 0; z < SECTION; z++) {
+                for (int x = 0; x < SECTION; x++) {
+                    uint32_t typeId = section.get(x, ly, z);
+                    if (typeId == 0) continue;
+
+                    // 相邻方块通常同类，缓存上一次的映射
+                    if (typeId != lastId) {
+                        lastId   = typeId;
+                        lastSlot = getSlot(typeId, slots);
+                    }
+                    if (lastSlot == 0) continue;
+
+                    m.slot[(y << 8) | (z << 4) | x] = lastSlot;
+                    m.renderX[y][z] |= 1u << x;
+                    m.renderZ[y][x] |= 1u << z;
+                    m.renderY[s][z][x] |= 1u << ly;
+
+                    if (slots.info[lastSlot].solid) {
+                        m.solidX[y][z] |= 1u << x;
+                        m.solidZ[y][x] |= 1u << z;
+                        m.solidY[s][z][x] |= 1u << ly;
+                    }
+                }
+            }
+        }
+    }
+
+    // 只读取邻居区块紧贴边界的一层，且只在本区块非空的高度范围内
+    void decodeBorders(const ChunkNeighborhood& neighborhood, int lowest, int highest, SlotTable& slots, Masks& m) const {
+        for (int side = 0; side < 4; side++) {
+            const VoxelChunk* neighbor = neighborhood.neighbors[side];
+            if (!neighbor) continue;
+
+            for (int s = lowest; s <= highest; s++) {
+                const ChunkSection& section = neighbor->getSection(s);
+                if (section.isEmpty()) continue;
+
+                if (section.isUniform()) {
+                    uint8_t slot = getSlot(section.getUniformType(), slots);
+                    if (!slots.info[slot].solid) continue;
+                    for (int ly = 0; ly < SECTION; ly++) {
+                        m.borderSolid[side][s * SECTION + ly] = 0xFFFF;
+                    }
+                    continue;
+                }
+
+                for (int ly = 0; ly < SECTION; ly++) {
+                    uint16_t bits = 0;
+                    for (int i = 0; i < SECTION; i++) {
+                        uint32_t typeId;
+                        switch (side) {
+                        case ChunkNeighborhood::NEG_X: typeId = section.get(SECTION - 1, ly, i); break;
+                        case ChunkNeighborhood::POS_X: typeId = section.get(0, ly, i); break;
+                        case ChunkNeighborhood::NEG_Z: typeId = section.get(i, ly, SECTION - 1); break;
+                        default: typeId = section.get(i, ly, 0); break;
+                        }
+                        if (typeId != 0 && slots.info[getSlot(typeId, slots)].solid) {
+                            bits |= 1u << i;
+                        }
+                    }
+                    m.borderSolid[side][s * SECTION + ly] = bits;
+                }
+            }
+        }
+    }
+
+    /**
+     * 计算一个方向的可见面并按类型槽位写入平面
+     *
+     * 行掩码的第 i 位是第 i 个方块；正方向的遮挡者是第 i+1 个，
+     * 即实心掩码右移一位，最高位由相邻区块 / 分段补上；负方向同理左移。
+     */
+    void fillPlanes(blocks::BlockFace face, int lowest, int highest, const Masks& m, std::vector<uint16_t>& planes) const {
+        using blocks::BlockFace;
+
+        auto forEachBit = [](uint32_t bits, auto&& fn) {
+            while (bits) {
+                fn(__builtin_ctz(bits));
+                bits &= bits - 1;
+            }
+        };
+
+        int y0 = lowest * SECTION;
+        int y1 = (highest + 1) * SECTION;
+
+        switch (face) {
+        case BlockFace::RIGHT:
+        case BlockFace::LEFT: {
+            bool positive = face == BlockFace::RIGHT;
+            const uint16_t* border = m.borderSolid[positive ? ChunkNeighborhood::POS_X : ChunkNeighborhood::NEG_X];
+
+            for (int y = y0; y < y1; y++) {
+                for (int z = 0; z < SECTION; z++) {
+                    uint32_t solid    = m.solidX[y][z];
+                    uint32_t edge     = (border[y] >> z) & 1u;
+                    uint32_t occluder = positive ? (solid >> 1) | (edge << 15) : (solid << 1) | edge;
+                    uint32_t visible  = m.renderX[y][z] & ~occluder & 0xFFFFu;
+
+                    forEachBit(visible, [&](int x) {
+                        uint8_t slot = m.slot[(y << 8) | (z << 4) | x];
+                        planes[slot * PLANE_ROWS + x * CHUNK_HEIGHT + y] |= 1u << z;
+                    });
+                }
+            }
+            break;
+        }
+        case BlockFace::FRONT:
+        case BlockFace::BACK: {
+            bool positive = face == BlockFace::FRONT;
+            const uint16_t* border = m.borderSolid[positive ? ChunkNeighborhood::POS_Z : ChunkNeighborhood::NEG_Z];
+
+            for (int y = y0; y < y1; y++) {
+                for (int x = 0; x < SECTION; x++) {
+                    uint32_t solid    = m.solidZ[y][x];
+                    uint32_t edge     = (border[y] >> x) & 1u;
+                    uint32_t occluder = positive ? (solid >> 1) | (edge << 15) : (solid << 1) | edge;
+                    uint32_t visible  = m.renderZ[y][x] & ~occluder & 0xFFFFu;
+
+                    forEachBit(visible, [&](int z) {
+                        uint8_t slot = m.slot[(y << 8) | (z << 4) | x];
+                        planes[slot * PLANE_ROWS + z * CHUNK_HEIGHT + y] |= 1u << x;
+                    });
+                }
+            }
+            break;
+        }
+        case BlockFace::TOP:
+        case BlockFace::BOTTOM: {
+            bool positive = face == BlockFace::TOP;
+
+            for (int s = lowest; s <= highest; s++) {
+                for (int z = 0; z < SECTION; z++) {
+                    for (int x = 0; x < SECTION; x++) {
+                        uint32_t solid = m.solidY[s][z][x];
+                        uint32_t occluder;
+                        if (positive) {
+                            uint32_t above = s + 1 < SECTIONS ? m.solidY[s + 1][z][x] & 1u : 0u;
+                            occluder       = (solid >> 1) | (above << 15);
+                        } else {
+                            uint32_t below = s > 0 ? (m.solidY[s - 1][z][x] >> 15) & 1u : 0u;
+                            occluder       = (solid << 1) | below;
+                        }
+                        uint32_t visible = m.renderY[s][z][x] & ~occluder & 0xFFFFu;
+
+                        forEachBit(visible, [&](int ly) {
+                            int y        = s * SECTION + ly;
+                            uint8_t slot = m.slot[(y << 8) | (z << 4) | x];
+                            planes[slot * PLANE_ROWS + y * SECTION + z] |= 1u << x;
+                        });
+                    }
+                }
+            }
+            break;
+        }
+        }
+    }
+
+    /**
+     * 在一层平面上贪婪合并：行内用 ctz 找连续段，
+     * 再逐行向下，下一行完整包含该段时一并吞掉。合并后平面被清零。
+     *
+     * 行 / 位与 GreedyMesher 的 height / width 对应：
+     * X 面为 (y, z)，Y 面为 (z, x)，Z 面为 (y, x)。
+     */
+    void mergePlane(uint16_t* rows, int rowCount, blocks::BlockFace face, int layer,
+    uint16_t textureLayer, renderer::ChunkMeshData& meshData, int rowOffset = 0) const {
+        for (int r = 0; r < rowCount; r++) {
+            uint32_t bits = rows[r];
+            while (bits) {
+                int start     = __builtin_ctz(bits);
+                int width     = __builtin_ctz(~(bits >> start));
+                uint32_t span = ((1u << width) - 1u) << start;
+
+                int height = 1;
+                while (r + height < rowCount && (rows[r + height] & span) == span) {
+                    rows[r + height] &= static_cast<uint16_t>(~span);
+                    height++;
+                }
+                bits &= ~span;
+
+                emitQuad(meshData, face, layer, start, r + rowOffset, width, height, textureLayer);
+            }
+            rows[r] = 0;
+        }
+    }
+
+    // 顶点位置与顺序与 GreedyMesher 保持一致
+    void emitQuad(renderer::ChunkMeshData& meshData, blocks::BlockFace face, int depth,
+    int startW, int startH, int width, int height, uint16_t textureLayer) const {
+        using blocks::BlockFace;
+
+        bool positive = face == BlockFace::RIGHT || face == BlockFace::TOP || face == BlockFace::FRONT;
+        int d         = depth + (positive ? 1 : 0);
+        int w0 = startW, w1 = startW + width;
+        int h0 = startH, h1 = startH + height;
+
+        std::array<glm::ivec3, 4> corners;
+        switch (face) {
+        case BlockFace::RIGHT:
+        case BlockFace::LEFT:
+            corners = { glm::ivec3(d, h0, w0), glm::ivec3(d, h0, w1), glm::ivec3(d, h1, w1), glm::ivec3(d, h1, w0) };
+            break;
+        case BlockFace::TOP:
+        case BlockFace::BOTTOM:
+            corners = { glm::ivec3(w0, d, h0), glm::ivec3(w1, d, h0), glm::ivec3(w1, d, h1), glm::ivec3(w0, d, h1) };
+            break;
+        case BlockFace::FRONT:
+        case BlockFace::BACK:
+            corners = { glm::ivec3(w0, h0, d), glm::ivec3(w1, h0, d), glm::ivec3(w1, h1, d), glm::ivec3(w0, h1, d) };
+            break;
+        }
+        if (!positive) {
+            std::swap(corners[1], corners[3]);
+        }
+
+        meshData.addQuad(corners, static_cast<int>(face), textureLayer);
+    }
+};
+
+} // namespace game::chuck
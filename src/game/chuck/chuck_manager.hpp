@@ -2,18 +2,51 @@
 
 #include <glm/glm.hpp>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
-#include "game/chuck/chunk_mesh_optimizer.hpp"
-#include "game/chuck/greedy_meshing.hpp"
+#include "game/chuck/chunk_mesher.hpp"
 #include "game/generator/terrain_generator.hpp"
+#include "game/storage/chunk_codec.hpp"
+#include "game/storage/region_file.hpp"
 
 #include "renderer/mesh/frustum.hpp"
-#include "renderer/render/instanced_block_renderer.hpp"
+#include "renderer/buffer/chunk_geometry_arena.hpp"
+
+#include "utils/thread_pool/thread_pool.hpp"
 
 namespace game::chuck {
 
+// 工作线程生成的 CPU 端网格，等待主线程上传
+struct ChunkMeshResult {
+    glm::ivec2 coord;
+    uint32_t revision;
+    renderer::ChunkMeshData mesh; // 所有方块类型合并后的顶点流
+};
+
+// 最近一帧 render() 的统计
+struct ChunkRenderStats {
+    int visibleChunks = 0;
+    int drawCalls     = 0;
+    size_t quads      = 0;
+};
+
+// 区块体素占用的内存，冷区块只计压缩后的字节
+struct ChunkMemoryStats {
+    size_t warmChunks = 0;
+    size_t coldChunks = 0;
+    size_t warmBytes  = 0; // 调色板存储的堆内存
+    size_t coldBytes  = 0; // 压缩数据
+};
+
 // 区块坐标哈希
 struct ChunkCoordHash {
     std::size_t operator()(const glm::ivec2& coord) const {
@@ -24,13 +57,19 @@ struct ChunkCoordHash {
 // 单个区块
 struct Chunk {
     glm::ivec2 coord; // 区块坐标
-    VoxelChunk voxels;
-    std::unordered_map<uint32_t, renderer::CubeMesh::MeshData> meshes;
-    std::unordered_map<uint32_t, std::unique_ptr<renderer::InstancedBlockRenderer>> renderers;
+    // 网格任务持有共享引用，区块被替换或卸载时工作线程仍可安全读取；冷区块为空
+    std::shared_ptr<VoxelChunk> voxels;
+    // 远离玩家后压缩保存的体素（冷存储），解压后清空
+    std::vector<uint8_t> coldVoxels;
+    // 生成时的高度图与列信息，剔除等后续阶段直接复用，不再采样噪声；从存档读取的区块为空
+    std::shared_ptr<const game::generator::ChunkHeightmap> heightmap;
+    // 网格在共享顶点缓冲中的句柄，一次绘制；没有可见面时为 INVALID_HANDLE
+    renderer::ChunkGeometryArena::Handle mesh = renderer::ChunkGeometryArena::INVALID_HANDLE;
     renderer::AABB boundingBox;
-    bool isDirty = true; // 是否需要重新生成网格
+    bool isDirty          = true; // 是否需要重新生成网格
+    uint32_t meshRevision = 0;    // 最近一次提交的网格任务编号，旧结果直接丢弃
 
-    Chunk(const glm::ivec2& c) : coord(c) {
+    Chunk(const glm::ivec2& c) : coord(c), voxels(std::make_shared<VoxelChunk>()) {
         // 计算包围盒
         glm::vec3 worldPos(coord.x * 16.0f, 0.0f, coord.y * 16.0f);
         boundingBox.min = worldPos;
@@ -43,117 +82,468 @@ class ChunkManager {
 
     private:
     std::unordered_map<glm::ivec2, std::unique_ptr<Chunk>, ChunkCoordHash> chunks;
-    OptimizedChunkMeshBuilder* meshBuilder;
+    const ChunkMesher* mesher; // 逐面或贪婪网格，构造时选定
     game::generator::TerrainGenerator* terrainGen;
+    game::storage::RegionStore* worldStore = nullptr; // 存档，为空时每次启动都重新生成
     int renderDistance = 8;
 
+    // 冷存储：超出渲染距离 coldMargin 个区块后体素压缩保存、网格保留，回到 coldMargin - 1 以内时解压；0 表示关闭
+    int coldMargin                    = 2;
+    size_t maxColdTransitionsPerFrame = 8; // 每帧最多压缩或解压的区块数
+    game::storage::ChunkCodec coldCodec = game::storage::ChunkCodec::RLE;
+
+    // 异步生成：已提交但尚未被主线程接收的区块
+    std::unordered_set<glm::ivec2, ChunkCoordHash> pendingChunks;
+    std::mutex completedMutex;
+    std::condition_variable completedCv;                 // 预生成时等待工作线程
+    std::vector<std::unique_ptr<Chunk>> completedChunks; // 由工作线程写入
+    size_t maxChunksAdoptedPerFrame = 4;                  // 每帧最多接收的区块数
+
+    // 异步网格：工作线程生成 MeshData，主线程按预算创建 GL 缓冲
+    std::mutex meshMutex;
+    std::vector<ChunkMeshResult> completedMeshes;       // 由工作线程写入
+    size_t maxMeshUploadsPerFrame     = 8;               // 每帧最多上传的区块网格数
+    size_t maxMeshUploadBytesPerFrame = 4 * 1024 * 1024; // 每帧最多上传的字节数
+
+    // 所有区块网格共用的顶点缓冲与四边形索引
+    renderer::ChunkGeometryArena geometry;
+    std::vector<renderer::ChunkDraw> drawList; // 每帧重建，复用容量
+    ChunkRenderStats renderStats;
+
+    // 必须最后声明：析构时先停止工作线程，再销毁它们会访问的成员
+    utils::ThreadPool workers;
+
     public:
-    ChunkManager(OptimizedChunkMeshBuilder* builder, game::generator::TerrainGenerator* generator)
-    : meshBuilder(builder), terrainGen(generator) {
+    /**
+     * @param chunkMesher 网格生成器，在工作线程上并发调用；只生成地形时可为空
+     * @param workerCount 生成线程数，0 表示在 update() 中同步生成
+     */
+    ChunkManager(const ChunkMesher* chunkMesher, game::generator::TerrainGenerator* generator,
+    size_t workerCount = utils::ThreadPool::defaultThreadCount())
+    : mesher(chunkMesher), terrainGen(generator), workers(workerCount) {
 
         if (!terrainGen) {
             throw std::runtime_error("TerrainGenerator cannot be null");
         }
     }
 
+    /**
+     * 设置存档目录：已保存的区块直接从磁盘读取，其余区块生成后立即写入
+     *
+     * 必须在第一次 update() / pregenerate() 之前调用；store 由调用方持有，生命周期须长于本对象。
+     */
+    void setWorldStore(game::storage::RegionStore* store) {
+        worldStore = store;
+    }
+
+    /**
+     * 把已加载区块的当前内容写回存档，修改方块后调用；区块未加载或没有存档时返回 false
+     *
+     * 只在主线程调用。网格任务可能正在工作线程上读取同一份体素，这里只读不改：
+     * 不调用 compact()，均匀分段按原样编码，读回后仍是相同的方块。
+     */
+    bool saveChunk(const glm::ivec2& coord) {
+        auto it = chunks.find(coord);
+        if (!worldStore || it == chunks.end()) return false;
+
+        try {
+            thawChunk(*it->second);
+            worldStore->saveChunk(coord.x, coord.y, *it->second->voxels);
+            return true;
+        } catch (const std::exception& e) {
+            LOG_ERROR("Cannot save chunk (", coord.x, ", ", coord.y, "): ", e.what());
+            return false;
+        }
+    }
+
     void setRenderDistance(int distance) {
         renderDistance = distance;
     }
 
+    void setColdStorage(int margin, size_t transitionsPerFrame, game::storage::ChunkCodec codec) {
+        coldMargin                 = margin;
+        maxColdTransitionsPerFrame = transitionsPerFrame;
+        coldCodec                  = codec;
+    }
+
+    void setMaxChunksAdoptedPerFrame(size_t count) {
+        maxChunksAdoptedPerFrame = count;
+    }
+
+    // 每帧上传预算：达到任一上限即停止（每帧至少上传一个，避免超大网格饿死）
+    void setMeshUploadBudget(size_t chunksPerFrame, size_t bytesPerFrame) {
+        maxMeshUploadsPerFrame     = chunksPerFrame;
+        maxMeshUploadBytesPerFrame = bytesPerFrame;
+    }
+
+    // 只负责提交生成任务和接收已完成的区块，不在主线程上生成地形
     void update(const glm::vec3& playerPos) {
-        glm::ivec2 playerChunk(
-        static_cast<int>(floor(playerPos.x / 16.0f)),
-        static_cast<int>(floor(playerPos.z / 16.0f)));
+        for (const auto& coord : collectMissingChunks(playerPos, renderDistance)) {
+            requestChunk(coord);
+        }
 
-        for (int x = -renderDistance; x <= renderDistance; x++) {
-            for (int z = -renderDistance; z <= renderDistance; z++) {
-                glm::ivec2 chunkCoord = playerChunk + glm::ivec2(x, z);
+        adoptCompletedChunks(maxChunksAdoptedPerFrame);
+        updateColdChunks(playerPos);
+    }
 
-                if (x * x + z * z > renderDistance * renderDistance) {
-                    continue;
-                }
+    /**
+     * 阻塞生成出生点周围 radius 个区块内的地形，由近到远，工作线程并行
+     *
+     * 同时在途的区块不超过 maxInFlight 个（0 表示工作线程数的两倍），完成的区块
+     * 立即接收并压缩，峰值内存只比最终结果多这一小批。网格仍由 render() 按需生成。
+     *
+     * @return 本次生成的区块数
+     */
+    size_t pregenerate(const glm::vec3& center, int radius, size_t maxInFlight = 0) {
+        std::vector<glm::ivec2> missing = collectMissingChunks(center, radius);
+        if (maxInFlight == 0) {
+            maxInFlight = std::max<size_t>(workers.getThreadCount(), 1) * 2;
+        }
 
-                if (chunks.find(chunkCoord) == chunks.end()) {
-                    generateChunk(chunkCoord);
-                }
+        LOG_INFO("Pregenerating ", missing.size(), " chunks within ", radius, " chunks of spawn");
+        auto start = std::chrono::steady_clock::now();
+
+        // 之前 update() 提交的区块也一并等待完成，但不计入进度
+        std::unordered_set<glm::ivec2, ChunkCoordHash> wanted(missing.begin(), missing.end());
+        size_t next = 0, done = 0, reported = 0;
+        while (next < missing.size() || !pendingChunks.empty()) {
+            while (next < missing.size() && pendingChunks.size() < maxInFlight) {
+                requestChunk(missing[next++]);
+            }
+
+            {
+                std::unique_lock<std::mutex> lock(completedMutex);
+                completedCv.wait(lock, [this] { return !completedChunks.empty(); });
+            }
+            for (const glm::ivec2& coord : adoptCompletedChunks(SIZE_MAX)) {
+                done += wanted.count(coord);
+            }
+
+            // 每完成一成输出一次进度
+            size_t percent = missing.empty() ? 100 : done * 100 / missing.size();
+            if (percent / 10 > reported / 10) {
+                reported = percent;
+                LOG_INFO("Pregenerating: ", percent, "% (", done, "/", missing.size(), " chunks)");
             }
         }
+
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        LOG_INFO("Pregenerated ", missing.size(), " chunks in ", ms, " ms on ", workers.getThreadCount(), " workers");
+        return missing.size();
     }
 
+    // 区块着色器需已激活；可见区块收集成一个列表，GL 4.3 下整片地形只需一次绘制
     void render(const renderer::Frustum& frustum) {
-        int visibleChunks = 0;
-        int totalChunks   = chunks.size();
+        renderStats = {};
+        drawList.clear();
+
+        uploadCompletedMeshes();
+        geometry.maintain();
 
         for (auto& [coord, chunk] : chunks) {
             if (!frustum.isBoxVisible(chunk->boundingBox)) {
                 continue;
             }
 
-            visibleChunks++;
+            renderStats.visibleChunks++;
 
             if (chunk->isDirty) {
-                rebuildChunkMesh(chunk.get());
+                requestChunkMesh(chunk.get());
             }
 
-            for (auto& [typeId, renderer] : chunk->renderers) {
-                if (renderer && renderer->getInstanceCount() > 0) {
-                    renderer->render();
-                }
-            }
+            if (chunk->mesh == renderer::ChunkGeometryArena::INVALID_HANDLE) continue;
+
+            drawList.push_back({ chunk->mesh, coord * 16 });
+            renderStats.quads += geometry.getRange(chunk->mesh).count / 4;
         }
+
+        renderStats.drawCalls = static_cast<int>(geometry.draw(drawList));
     }
 
     int getLoadedChunkCount() const {
         return chunks.size();
     }
 
+    int getPendingChunkCount() const {
+        return pendingChunks.size();
+    }
+
+    ChunkMemoryStats getMemoryStats() const {
+        ChunkMemoryStats stats;
+        for (const auto& [coord, chunk] : chunks) {
+            if (chunk->voxels) {
+                stats.warmChunks++;
+                stats.warmBytes += chunk->voxels->getMemoryUsage();
+            } else {
+                stats.coldChunks++;
+                stats.coldBytes += chunk->coldVoxels.capacity();
+            }
+        }
+        return stats;
+    }
+
+    const ChunkRenderStats& getRenderStats() const {
+        return renderStats;
+    }
+
+    renderer::ChunkGeometryStats getGeometryStats() const {
+        return geometry.getStats();
+    }
+
     private:
-    void generateChunk(const glm::ivec2& coord) {
+    static glm::ivec2 getChunkCoord(const glm::vec3& position) {
+        return glm::ivec2(
+        static_cast<int>(floor(position.x / 16.0f)),
+        static_cast<int>(floor(position.z / 16.0f)));
+    }
+
+    // 以 center 为圆心、radius 个区块内尚未加载也未提交的区块，由近到远排序
+    std::vector<glm::ivec2> collectMissingChunks(const glm::vec3& center, int radius) const {
+        glm::ivec2 centerChunk = getChunkCoord(center);
+
+        std::vector<glm::ivec2> missing;
+
+        for (int x = -radius; x <= radius; x++) {
+            for (int z = -radius; z <= radius; z++) {
+                glm::ivec2 chunkCoord = centerChunk + glm::ivec2(x, z);
+
+                if (x * x + z * z > radius * radius) {
+                    continue;
+                }
+
+                if (chunks.find(chunkCoord) == chunks.end() &&
+                pendingChunks.find(chunkCoord) == pendingChunks.end()) {
+                    missing.push_back(chunkCoord);
+                }
+            }
+        }
+
+        // 先生成离玩家近的区块
+        std::sort(missing.begin(), missing.end(), [&](const glm::ivec2& a, const glm::ivec2& b) {
+            glm::ivec2 da = a - centerChunk;
+            glm::ivec2 db = b - centerChunk;
+            return da.x * da.x + da.y * da.y < db.x * db.x + db.y * db.y;
+        });
+
+        return missing;
+    }
+
+    void requestChunk(const glm::ivec2& coord) {
+        pendingChunks.insert(coord);
+
+        workers.submit([this, coord] {
+            auto chunk = generateChunk(coord);
+
+            {
+                std::lock_guard<std::mutex> lock(completedMutex);
+                completedChunks.push_back(std::move(chunk));
+            }
+            completedCv.notify_one();
+        });
+    }
+
+    // 主线程：接收工作线程生成完的区块，每次最多 limit 个；返回接收的区块坐标
+    std::vector<glm::ivec2> adoptCompletedChunks(size_t limit) {
+        std::vector<std::unique_ptr<Chunk>> ready;
+        {
+            std::lock_guard<std::mutex> lock(completedMutex);
+            size_t count = std::min(completedChunks.size(), limit);
+            ready.assign(std::make_move_iterator(completedChunks.begin()),
+            std::make_move_iterator(completedChunks.begin() + count));
+            completedChunks.erase(completedChunks.begin(), completedChunks.begin() + count);
+        }
+
+        std::vector<glm::ivec2> adopted;
+        adopted.reserve(ready.size());
+        for (auto& chunk : ready) {
+            glm::ivec2 coord = chunk->coord;
+            adopted.push_back(coord);
+            pendingChunks.erase(coord);
+            chunks[coord] = std::move(chunk);
+
+            // 邻居的边界面之前按空气生成，现在可以剔除了
+            for (const auto& offset : NEIGHBOR_OFFSETS) {
+                auto it = chunks.find(coord + offset);
+                if (it != chunks.end()) {
+                    it->second->isDirty = true;
+                }
+            }
+        }
+
+        return adopted;
+    }
+
+    // 工作线程：只读访问 terrainGen，不触碰 chunks；有存档时优先读盘，生成的区块随即写入
+    std::unique_ptr<Chunk> generateChunk(const glm::ivec2& coord) const {
         auto chunk = std::make_unique<Chunk>(coord);
 
-        auto terrainBlocks = terrainGen->generateChunk(coord.x, coord.y, 16);
+        int maxSolidY;
+        if (worldStore && worldStore->loadChunk(coord.x, coord.y, *chunk->voxels)) {
+            LOG_DEBUG("Loaded chunk (", coord.x, ", ", coord.y, ") from disk");
+            maxSolidY = findMaxSolidY(*chunk->voxels);
+        } else {
+            LOG_DEBUG("Generating chunk (", coord.x, ", ", coord.y, ")");
+
+            // 存档解码失败时体素里可能留有已解码的部分，生成器只写非空气方块，必须从空区块开始
+            if (worldStore) chunk->voxels = std::make_shared<VoxelChunk>();
+
+            // 地形按列直接写入体素存储，不经过 TerrainBlock 列表
+            chunk->heightmap = terrainGen->generateChunk(coord.x, coord.y, *chunk->voxels);
+            chunk->voxels->compact();
+            maxSolidY = chunk->heightmap->maxSolidY;
+
+            if (worldStore) {
+                try {
+                    worldStore->saveChunk(coord.x, coord.y, *chunk->voxels);
+                } catch (const std::exception& e) {
+                    LOG_ERROR("Cannot save chunk (", coord.x, ", ", coord.y, "): ", e.what());
+                }
+            }
+        }
+
+        // 包围盒上沿取最高实心方块，精确到方块；水目前不渲染，不计入
+        int lowest = chunk->voxels->getLowestNonEmptySection();
+        if (lowest < 0 || maxSolidY < 0) {
+            chunk->boundingBox.max.y = chunk->boundingBox.min.y;
+        } else {
+            chunk->boundingBox.min.y = lowest * VoxelChunk::SECTION_SIZE;
+            chunk->boundingBox.max.y = maxSolidY + 1.0f;
+        }
+
+        return chunk;
+    }
+
+    // 没有高度图时（从存档读取）自上而下扫描体素，求最高的实心方块；全空返回 -1
+    static int findMaxSolidY(const VoxelChunk& voxels) {
+        for (int section = voxels.getHighestNonEmptySection(); section >= 0; section--) {
+            if (voxels.isSectionEmpty(section)) continue;
+
+            for (int y = (section + 1) * VoxelChunk::SECTION_SIZE - 1; y >= section * VoxelChunk::SECTION_SIZE; y--) {
+                for (int x = 0; x < voxels.getSizeX(); x++) {
+                    for (int z = 0; z < voxels.getSizeZ(); z++) {
+                        uint32_t typeId = voxels.getBlock(x, y, z);
+                        if (typeId != blocks::BlockIDs::AIR && typeId != blocks::BlockIDs::WATER) return y;
+                    }
+                }
+            }
+        }
+        return -1;
+    }
+
 
-        LOG_DEBUG("Generating chunk (", coord.x, ", ", coord.y, ") with ",
-        terrainBlocks.size(), " blocks");
+    // 主线程：远处区块压缩进冷存储，重新靠近的解压；两个距离之间留一圈，避免在边界上反复切换
+    void updateColdChunks(const glm::vec3& playerPos) {
+        if (coldMargin <= 0) return;
 
-        for (const auto& block : terrainBlocks) {
-            int localX = block.position.x - coord.x * 16;
-            int localY = block.position.y;
-            int localZ = block.position.z - coord.y * 16;
+        glm::ivec2 center = getChunkCoord(playerPos);
+        int freezeDistance = renderDistance + coldMargin;
+        int thawDistance   = freezeDistance - 1;
+        size_t budget      = maxColdTransitionsPerFrame;
 
-            if (localX >= 0 && localX < 16 && localZ >= 0 && localZ < 16 &&
-            localY >= 0 && localY < 256) {
-                chunk->voxels.setBlock(localX, localY, localZ, block.blockTypeId);
+        for (auto& [coord, chunk] : chunks) {
+            if (budget == 0) break;
+
+            glm::ivec2 d  = coord - center;
+            int distance2 = d.x * d.x + d.y * d.y;
+            if (chunk->voxels && distance2 > freezeDistance * freezeDistance) {
+                freezeChunk(*chunk);
+                budget--;
+            } else if (!chunk->voxels && distance2 <= thawDistance * thawDistance) {
+                thawChunk(*chunk);
+                budget--;
             }
         }
+    }
 
-        chunks[coord] = std::move(chunk);
+    // 进行中的网格任务持有自己的引用，释放 voxels 不影响它们
+    void freezeChunk(Chunk& chunk) const {
+        chunk.coldVoxels.clear();
+        game::storage::encodeChunk(*chunk.voxels, coldCodec, chunk.coldVoxels);
+        chunk.coldVoxels.shrink_to_fit();
+        chunk.voxels.reset();
     }
 
+    // 冷区块解压回 voxels；已解压的区块不做任何事
+    void thawChunk(Chunk& chunk) const {
+        if (chunk.voxels) return;
 
-    void rebuildChunkMesh(Chunk* chunk) {
-        // 生成优化的网格（只包含可见面）
-        chunk->meshes = meshBuilder->generateChunkMesh(chunk->voxels);
+        auto voxels = std::make_shared<VoxelChunk>();
+        if (!game::storage::decodeChunk(chunk.coldVoxels.data(), chunk.coldVoxels.size(), *voxels)) {
+            // 数据由 freezeChunk() 在本进程内写出，解码失败只可能是程序错误
+            throw std::logic_error("Cold chunk data failed to decode");
+        }
+        chunk.voxels = std::move(voxels);
+        std::vector<uint8_t>().swap(chunk.coldVoxels);
+    }
 
-        // 为每种方块类型创建渲染器
-        chunk->renderers.clear();
+    // 与 ChunkNeighborhood::Side 顺序一致
+    static inline const glm::ivec2 NEIGHBOR_OFFSETS[4] = {
+        { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 }
+    };
 
-        for (auto& [typeId, meshData] : chunk->meshes) {
-            if (meshData.vertices.empty()) continue;
+    // 主线程：把网格任务交给工作线程，只捕获只读的体素数据（含四个邻居）
+    void requestChunkMesh(Chunk* chunk) {
+        if (!mesher) return;
 
-            // 将整个区块的网格作为一个"实例"
-            // 这里不使用真正的实例化，而是直接渲染合并后的网格
-            auto renderer = std::make_unique<renderer::InstancedBlockRenderer>(meshData, 1);
+        thawChunk(*chunk);
+        chunk->isDirty    = false;
+        uint32_t revision = ++chunk->meshRevision;
 
-            // 添加一个单位变换的实例
-            renderer::BlockInstance instance(glm::vec3(chunk->coord.x * 16.0f, 0.0f, chunk->coord.y * 16.0f));
-            renderer->addInstance(instance);
-            renderer->updateInstanceBuffer();
+        std::shared_ptr<const VoxelChunk> voxels = chunk->voxels;
+        glm::ivec2 coord                        = chunk->coord;
 
-            chunk->renderers[typeId] = std::move(renderer);
+        std::array<std::shared_ptr<const VoxelChunk>, 4> neighbors;
+        for (int i = 0; i < 4; i++) {
+            auto it = chunks.find(coord + NEIGHBOR_OFFSETS[i]);
+            if (it != chunks.end()) {
+                thawChunk(*it->second);
+                neighbors[i] = it->second->voxels;
+            }
         }
 
-        chunk->isDirty = false;
+        workers.submit([this, voxels, neighbors, coord, revision] {
+            ChunkNeighborhood neighborhood(*voxels);
+            for (int i = 0; i < 4; i++) {
+                neighborhood.neighbors[i] = neighbors[i].get();
+            }
+
+            ChunkMeshResult result{ coord, revision, mesher->generateMesh(neighborhood) };
+
+            std::lock_guard<std::mutex> lock(meshMutex);
+            completedMeshes.push_back(std::move(result));
+        });
+    }
+
+    // 主线程：按每帧预算把已完成的网格上传到共享顶点缓冲
+    void uploadCompletedMeshes() {
+        std::vector<ChunkMeshResult> ready;
+        {
+            std::lock_guard<std::mutex> lock(meshMutex);
+            size_t count = 0;
+            size_t bytes = 0;
+            while (count < completedMeshes.size() && count < maxMeshUploadsPerFrame) {
+                bytes += completedMeshes[count].mesh.getByteSize();
+                if (count > 0 && bytes > maxMeshUploadBytesPerFrame) break;
+                count++;
+            }
+            ready.assign(std::make_move_iterator(completedMeshes.begin()),
+            std::make_move_iterator(completedMeshes.begin() + count));
+            completedMeshes.erase(completedMeshes.begin(), completedMeshes.begin() + count);
+        }
+
+        for (auto& result : ready) {
+            auto it = chunks.find(result.coord);
+            if (it == chunks.end() || it->second->meshRevision != result.revision) {
+                continue; // 区块已卸载或已有更新的网格任务
+            }
+            uploadChunkMesh(it->second.get(), result.mesh);
+        }
+    }
+
+    void uploadChunkMesh(Chunk* chunk, const renderer::ChunkMeshData& mesh) {
+        // 顶点已是区块局部坐标，原点在绘制时给出；没有可见面的区块不占缓冲空间
+        geometry.release(chunk->mesh);
+        chunk->mesh = geometry.allocate(mesh);
     }
 };
 
@@ -2,200 +2,124 @@
 
 #include <glm/glm.hpp>
 
-#include <unordered_map>
+#include <array>
+#include <stdexcept>
 #include <vector>
 
+#include "game/blocks/block_texture_table.hpp"
 #include "game/blocks/blocks_types.hpp"
-#include "renderer/mesh/mesh.hpp"
+#include "game/chuck/chunk_mesher.hpp"
 
 namespace game::chuck {
 
-// 简化的方块世界表示
-class VoxelChunk {
+// 逐面网格生成器：每个可见方块面一个四边形
+// 无内部状态，可被多个网格工作线程同时调用
+class OptimizedChunkMeshBuilder : public ChunkMesher {
     private:
-    static constexpr int CHUNK_SIZE_X = 16;
-    static constexpr int CHUNK_SIZE_Y = 256;
-    static constexpr int CHUNK_SIZE_Z = 16;
-
-    std::vector<uint32_t> blocks;
-    int getIndex(int x, int y, int z) const {
-        return x + y * CHUNK_SIZE_X + z * CHUNK_SIZE_X * CHUNK_SIZE_Y;
-    }
+    const blocks::BlockTextureTable* textures;
 
     public:
-    VoxelChunk() {
-        blocks.resize(CHUNK_SIZE_X * CHUNK_SIZE_Y * CHUNK_SIZE_Z, 0);
-    }
-
-    void setBlock(int x, int y, int z, uint32_t typeId) {
-        if (x >= 0 && x < CHUNK_SIZE_X &&
-        y >= 0 && y < CHUNK_SIZE_Y &&
-        z >= 0 && z < CHUNK_SIZE_Z) {
-            blocks[getIndex(x, y, z)] = typeId;
-        }
-    }
-
-    uint32_t getBlock(int x, int y, int z) const {
-        if (x < 0 || x >= CHUNK_SIZE_X ||
-        y < 0 || y >= CHUNK_SIZE_Y ||
-        z < 0 || z >= CHUNK_SIZE_Z) {
-            return 0;
+    OptimizedChunkMeshBuilder(const blocks::BlockTextureTable* textureTable)
+    : textures(textureTable) {
+        if (!textures) {
+            throw std::runtime_error("BlockTextureTable cannot be null");
         }
-        return blocks[getIndex(x, y, z)];
     }
 
-    bool isBlockSolid(int x, int y, int z) const {
-        uint32_t typeId = getBlock(x, y, z);
-        if (typeId == 0) return false;
-
-        auto* blockType = blocks::BlockTypeRegistry::getInstance().getBlockType(typeId);
-        return blockType ? blockType->isSolid : false;
+    // 单独生成一个区块的网格，区块外一律视为空气
+    renderer::ChunkMeshData generateChunkMesh(const VoxelChunk& chunk) const {
+        return generateMesh(ChunkNeighborhood(chunk));
     }
 
-    // 检查某个面是否需要渲染（相邻方块是否遮挡）
-    bool shouldRenderFace(int x, int y, int z, blocks::BlockFace face) const {
-        if (getBlock(x, y, z) == 0) return false; // 空气不渲染
+    renderer::ChunkMeshData generateMesh(const ChunkNeighborhood& neighborhood) const override {
+        static const glm::ivec3 offsets[6] = {
+            { 0, 0, 1 }, { 0, 0, -1 }, { -1, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }
+        };
 
-        using namespace blocks;
+        const VoxelChunk& chunk                      = *neighborhood.center;
+        const blocks::BlockPropertyTable& properties = *neighborhood.properties;
+        renderer::ChunkMeshData mesh;
 
-        // 检查相邻方块
-        int nx = x, ny = y, nz = z;
-        switch (face) {
-        case BlockFace::FRONT: nz++; break;
-        case BlockFace::BACK: nz--; break;
-        case BlockFace::LEFT: nx--; break;
-        case BlockFace::RIGHT: nx++; break;
-        case BlockFace::TOP: ny++; break;
-        case BlockFace::BOTTOM: ny--; break;
-        }
+        int sizeX = chunk.getSizeX();
+        int sizeZ = chunk.getSizeZ();
 
-        // 如果相邻是空气或透明方块，需要渲染这个面
-        return !isBlockSolid(nx, ny, nz);
-    }
+        for (int s = 0; s < VoxelChunk::SECTION_COUNT; s++) {
+            const ChunkSection& section = chunk.getSection(s);
 
-    int getSizeX() const { return CHUNK_SIZE_X; }
-    int getSizeY() const { return CHUNK_SIZE_Y; }
-    int getSizeZ() const { return CHUNK_SIZE_Z; }
-};
+            // 全空气分段没有任何面
+            if (section.isEmpty()) continue;
 
-// 优化的区块网格生成器
-class OptimizedChunkMeshBuilder {
-    private:
-    renderer::TextureAtlas* atlas;
+            // 全实心分段内部的面全部被遮挡，只需检查分段外壳上的方块
+            bool shellOnly = false;
+            if (section.isUniform()) {
+                if (!properties.isRegistered(section.getUniformType())) continue;
+                shellOnly = properties.isOccluding(section.getUniformType());
+            }
 
-    public:
-    OptimizedChunkMeshBuilder(renderer::TextureAtlas* textureAtlas)
-    : atlas(textureAtlas) {}
+            int y0 = s * VoxelChunk::SECTION_SIZE;
+            int y1 = y0 + VoxelChunk::SECTION_SIZE;
 
-    std::unordered_map<uint32_t, renderer::CubeMesh::MeshData> generateChunkMesh(const VoxelChunk& chunk) {
-        std::unordered_map<uint32_t, renderer::CubeMesh::MeshData> meshes;
+            for (int x = 0; x < sizeX; x++) {
+                for (int y = y0; y < y1; y++) {
+                    bool shellRow = !shellOnly || x == 0 || x == sizeX - 1 || y == y0 || y == y1 - 1;
 
-        int sizeX = chunk.getSizeX();
-        int sizeY = chunk.getSizeY();
-        int sizeZ = chunk.getSizeZ();
+                    for (int z = 0; z < sizeZ; z++) {
+                        // 内部行只有首尾两个方块在外壳上
+                        if (!shellRow && z != 0) z = sizeZ - 1;
 
-        for (int x = 0; x < sizeX; x++) {
-            for (int y = 0; y < sizeY; y++) {
-                for (int z = 0; z < sizeZ; z++) {
-                    uint32_t typeId = chunk.getBlock(x, y, z);
-                    if (typeId == 0) continue;
+                        uint32_t typeId = chunk.getBlock(x, y, z);
+                        if (typeId == 0) continue;
 
-                    auto* blockType = blocks::BlockTypeRegistry::getInstance().getBlockType(typeId);
-                    if (!blockType) continue;
+                        if (!properties.isRegistered(typeId)) continue;
 
-                    for (int faceIdx = 0; faceIdx < 6; faceIdx++) {
-                        blocks::BlockFace face = static_cast<blocks::BlockFace>(faceIdx);
+                        for (int faceIdx = 0; faceIdx < 6; faceIdx++) {
+                            // 相邻方块（可能在邻居区块内）不遮挡时才渲染
+                            glm::ivec3 n = glm::ivec3(x, y, z) + offsets[faceIdx];
+                            if (neighborhood.isOccluding(n.x, n.y, n.z)) continue;
 
-                        if (chunk.shouldRenderFace(x, y, z, face)) {
-                            addBlockFace(meshes[typeId], *blockType,
-                            glm::vec3(x, y, z), face);
+                            auto face = static_cast<blocks::BlockFace>(faceIdx);
+                            addBlockFace(mesh, textures->getLayer(typeId, face), glm::ivec3(x, y, z), face);
                         }
                     }
                 }
             }
         }
 
-        return meshes;
+        return mesh;
     }
 
     private:
-    void addBlockFace(renderer::CubeMesh::MeshData& meshData, const blocks::BlockType& blockType, const glm::vec3& position, blocks::BlockFace face) {
-
-        // 立方体顶点（相对位置）
-        glm::vec3 vertices[8] = {
-            position + glm::vec3(-0.5f, -0.5f, -0.5f),
-            position + glm::vec3(0.5f, -0.5f, -0.5f),
-            position + glm::vec3(0.5f, 0.5f, -0.5f),
-            position + glm::vec3(-0.5f, 0.5f, -0.5f),
-            position + glm::vec3(-0.5f, -0.5f, 0.5f),
-            position + glm::vec3(0.5f, -0.5f, 0.5f),
-            position + glm::vec3(0.5f, 0.5f, 0.5f),
-            position + glm::vec3(-0.5f, 0.5f, 0.5f)
+    void addBlockFace(renderer::ChunkMeshData& meshData, uint16_t textureLayer, const glm::ivec3& position, blocks::BlockFace face) const {
+
+        // 立方体的 8 个整数角点，方块占据 [position, position + 1]
+        glm::ivec3 vertices[8] = {
+            position + glm::ivec3(0, 0, 0),
+            position + glm::ivec3(1, 0, 0),
+            position + glm::ivec3(1, 1, 0),
+            position + glm::ivec3(0, 1, 0),
+            position + glm::ivec3(0, 0, 1),
+            position + glm::ivec3(1, 0, 1),
+            position + glm::ivec3(1, 1, 1),
+            position + glm::ivec3(0, 1, 1)
         };
 
-        // 获取纹理UV
-        const std::string& textureName = blockType.getTexture(face);
-        renderer::TextureUV uv         = atlas->getUV(textureName);
-
-        glm::vec2 uvCoords[4] = {
-            glm::vec2(uv.min.x, uv.min.y),
-            glm::vec2(uv.max.x, uv.min.y),
-            glm::vec2(uv.max.x, uv.max.y),
-            glm::vec2(uv.min.x, uv.max.y)
-        };
-
-        // 根据面选择顶点和法线
+        // 根据面选择顶点（逆时针）
         std::array<int, 4> indices;
-        glm::vec3 normal;
 
         using namespace blocks;
 
         switch (face) {
-        case BlockFace::FRONT:
-            indices = { 4, 5, 6, 7 };
-            normal  = glm::vec3(0, 0, 1);
-            break;
-        case BlockFace::BACK:
-            indices = { 1, 0, 3, 2 };
-            normal  = glm::vec3(0, 0, -1);
-            break;
-        case BlockFace::LEFT:
-            indices = { 0, 4, 7, 3 };
-            normal  = glm::vec3(-1, 0, 0);
-            break;
-        case BlockFace::RIGHT:
-            indices = { 5, 1, 2, 6 };
-            normal  = glm::vec3(1, 0, 0);
-            break;
-        case BlockFace::TOP:
-            indices = { 7, 6, 2, 3 };
-            normal  = glm::vec3(0, 1, 0);
-            break;
-        case BlockFace::BOTTOM:
-            indices = { 0, 1, 5, 4 };
-            normal  = glm::vec3(0, -1, 0);
-            break;
+        case BlockFace::FRONT: indices = { 4, 5, 6, 7 }; break;
+        case BlockFace::BACK: indices = { 1, 0, 3, 2 }; break;
+        case BlockFace::LEFT: indices = { 0, 4, 7, 3 }; break;
+        case BlockFace::RIGHT: indices = { 5, 1, 2, 6 }; break;
+        case BlockFace::TOP: indices = { 7, 6, 2, 3 }; break;
+        case BlockFace::BOTTOM: indices = { 0, 1, 5, 4 }; break;
         }
 
-        uint32_t baseIndex = meshData.vertices.size();
-
-        // 添加4个顶点
-        for (int i = 0; i < 4; i++) {
-            renderer::Vertex vertex;
-            vertex.position = vertices[indices[i]];
-            vertex.normal   = normal;
-            vertex.texCoord = uvCoords[i];
-            meshData.vertices.push_back(vertex);
-        }
-
-        // 添加2个三角形
-        meshData.indices.push_back(baseIndex + 0);
-        meshData.indices.push_back(baseIndex + 1);
-        meshData.indices.push_back(baseIndex + 2);
-
-        meshData.indices.push_back(baseIndex + 0);
-        meshData.indices.push_back(baseIndex + 2);
-        meshData.indices.push_back(baseIndex + 3);
+        // 纹理只记录纹理数组的层，UV 由着色器按位置和面推出
+        meshData.addQuad({ vertices[indices[0]], vertices[indices[1]], vertices[indices[2]], vertices[indices[3]] },
+        static_cast<int>(face), textureLayer);
     }
 };
 
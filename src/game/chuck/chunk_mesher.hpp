@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "game/chuck/voxel_chunk.hpp"
+#include "renderer/mesh/chunk_vertex.hpp"
+
+namespace game::chuck {
+
+/**
+ * 网格生成时看到的区块及其四个水平邻居
+ *
+ * 只是视图，不持有数据；调用方保证生成期间这些区块存活。
+ * 局部坐标 x / z 允许越界一格，落在对应邻居内；邻居缺失时视为空气，
+ * 这样边界上的面会先被生成，邻居加载后区块重新生成网格时再剔除。
+ */
+struct ChunkNeighborhood {
+    enum Side { NEG_X = 0,
+        POS_X,
+        NEG_Z,
+        POS_Z };
+
+    const VoxelChunk* center;
+    std::array<const VoxelChunk*, 4> neighbors = {};
+    const blocks::BlockPropertyTable* properties = &blocks::getBlockProperties();
+
+    explicit ChunkNeighborhood(const VoxelChunk& chunk) : center(&chunk) {}
+
+    uint32_t getBlock(int x, int y, int z) const {
+        constexpr int SIZE = 16;
+
+        bool outX = x < 0 || x >= SIZE;
+        bool outZ = z < 0 || z >= SIZE;
+        if (!outX && !outZ) return center->getBlock(x, y, z);
+        if (outX && outZ) return 0; // 斜对角的区块不参与面剔除
+
+        const VoxelChunk* neighbor;
+        if (outX) {
+            neighbor = neighbors[x < 0 ? NEG_X : POS_X];
+            x        = x < 0 ? x + SIZE : x - SIZE;
+        } else {
+            neighbor = neighbors[z < 0 ? NEG_Z : POS_Z];
+            z        = z < 0 ? z + SIZE : z - SIZE;
+        }
+        return neighbor ? neighbor->getBlock(x, y, z) : 0;
+    }
+
+    bool isBlockSolid(int x, int y, int z) const {
+        return properties->isSolid(getBlock(x, y, z));
+    }
+
+    // 该位置的方块是否遮挡相邻方块的面
+    bool isOccluding(int x, int y, int z) const {
+        return properties->isOccluding(getBlock(x, y, z));
+    }
+};
+
+/**
+ * 区块网格生成器接口
+ *
+ * 整个区块的所有方块类型输出到同一个顶点流，纹理由每个顶点自带，
+ * 因此一个区块只需一次绘制。
+ * 实现必须是无状态的：ChunkManager 会在多个工作线程上同时调用同一个实例。
+ */
+class ChunkMesher {
+    public:
+    virtual ~ChunkMesher() = default;
+
+    virtual renderer::ChunkMeshData generateMesh(const ChunkNeighborhood& neighborhood) const = 0;
+};
+
+} // namespace game::chuck
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "game/chuck/palette_storage.hpp"
+
+namespace game::chuck {
+
+/**
+ * 区块的一个 16x16x16 垂直分段
+ *
+ * 整个分段只有一种方块（全是空气或全是石头）时不分配任何存储，
+ * 只记录 uniformType；第一次写入不同方块时才展开为调色板存储。
+ * compact() 可在批量写入后把重新变得均匀的分段收缩回来。
+ */
+class ChunkSection {
+    public:
+    static constexpr int SIZE   = 16;
+    static constexpr int VOLUME = SIZE * SIZE * SIZE;
+
+    ChunkSection() = default;
+
+    ChunkSection(const ChunkSection& other)
+    : uniformType(other.uniformType),
+      storage(other.storage ? std::make_unique<PalettedBlockStorage>(*other.storage) : nullptr) {}
+
+    ChunkSection& operator=(const ChunkSection& other) {
+        if (this != &other) {
+            uniformType = other.uniformType;
+            storage     = other.storage ? std::make_unique<PalettedBlockStorage>(*other.storage) : nullptr;
+        }
+        return *this;
+    }
+
+    ChunkSection(ChunkSection&&)            = default;
+    ChunkSection& operator=(ChunkSection&&) = default;
+
+    // 局部坐标，范围 [0, 16)
+    uint32_t get(int x, int y, int z) const {
+        return storage ? storage->get(getIndex(x, y, z)) : uniformType;
+    }
+
+    void set(int x, int y, int z, uint32_t typeId) {
+        if (!prepareWrite(typeId)) return;
+        storage->set(getIndex(x, y, z), typeId);
+    }
+
+    // 把 (x, z) 列的 [y0, y1) 写成同一方块
+    void fillColumn(int x, int z, int y0, int y1, uint32_t typeId) {
+        if (y0 >= y1 || !prepareWrite(typeId)) return;
+        storage->fill(getIndex(x, y0, z), y1 - y0, SIZE * SIZE, typeId);
+    }
+
+    // 把 [y0, y1) 的整层写成同一方块；覆盖整个分段时直接变为均匀分段，不分配存储
+    void fillLayers(int y0, int y1, uint32_t typeId) {
+        if (y0 >= y1) return;
+        if (y0 == 0 && y1 == SIZE) {
+            uniformType = typeId;
+            storage.reset();
+            return;
+        }
+        if (!prepareWrite(typeId)) return;
+        storage->fill(getIndex(0, y0, 0), (y1 - y0) * SIZE * SIZE, 1, typeId);
+    }
+
+    // 整个分段只有一种方块
+    bool isUniform() const { return !storage; }
+    // 整个分段都是空气
+    bool isEmpty() const { return !storage && uniformType == 0; }
+    uint32_t getUniformType() const { return uniformType; }
+    // 非均匀分段的调色板存储，均匀分段为空
+    const PalettedBlockStorage* getStorage() const { return storage.get(); }
+
+    // 反序列化时整体替换内容
+    void assignUniform(uint32_t typeId) {
+        uniformType = typeId;
+        storage.reset();
+    }
+    void assignStorage(std::unique_ptr<PalettedBlockStorage> paletted) {
+        storage = std::move(paletted);
+    }
+
+    // 若所有方块相同则释放存储，返回是否为均匀分段
+    bool compact() {
+        if (!storage) return true;
+
+        // 调色板只增不减，只有一项时必然均匀；否则逐个检查
+        uint32_t first = storage->get(0);
+        if (storage->getPaletteSize() > 1) {
+            for (int i = 1; i < VOLUME; i++) {
+                if (storage->get(i) != first) return false;
+            }
+        }
+
+        uniformType = first;
+        storage.reset();
+        return true;
+    }
+
+    size_t getMemoryUsage() const {
+        return storage ? sizeof(PalettedBlockStorage) + storage->getMemoryUsage() : 0;
+    }
+
+    int getBitsPerBlock() const { return storage ? storage->getBitsPerEntry() : 0; }
+
+    private:
+    uint32_t uniformType = 0;                      // 均匀分段的方块类型
+    std::unique_ptr<PalettedBlockStorage> storage; // 非均匀分段才分配
+
+    static int getIndex(int x, int y, int z) {
+        return (y << 8) | (z << 4) | x;
+    }
+
+    // 写入前展开均匀分段；写入的正是均匀类型时无需任何操作，返回 false
+    bool prepareWrite(uint32_t typeId) {
+        if (!storage) {
+            if (typeId == uniformType) return false;
+            storage = std::make_unique<PalettedBlockStorage>(VOLUME, uniformType);
+        }
+        return true;
+    }
+};
+
+} // namespace game::chuck
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "game/chuck/voxel_chunk.hpp"
+#include "utils/binary_io.hpp"
+
+namespace game::chuck {
+
+/**
+ * 把区块按分段写成字节流（小端序），追加到 out 末尾
+ *
+ * 每个分段：1 字节位宽（0 表示均匀分段），
+ * - 均匀分段：4 字节方块类型
+ * - 调色板分段：4 字节调色板长度、调色板（每项 4 字节）、打包后的索引字（每个 8 字节）
+ *
+ * 直接写出内存中的调色板存储，不重新编码；同一区块内容与写入顺序相同时字节完全一致。
+ * 调用前应先 compact()，否则已变均匀的分段仍按调色板写出。
+ */
+inline void serializeChunk(const VoxelChunk& chunk, std::vector<uint8_t>& out) {
+    for (int i = 0; i < VoxelChunk::SECTION_COUNT; i++) {
+        const ChunkSection& section         = chunk.getSection(i);
+        const PalettedBlockStorage* storage = section.getStorage();
+
+        if (!storage) {
+            out.push_back(0);
+            utils::appendLE<uint32_t>(out, section.getUniformType());
+            continue;
+        }
+
+        out.push_back(static_cast<uint8_t>(storage->getBitsPerEntry()));
+        utils::appendLE<uint32_t>(out, static_cast<uint32_t>(storage->getPaletteSize()));
+        for (uint32_t typeId : storage->getPalette()) {
+            utils::appendLE<uint32_t>(out, typeId);
+        }
+        for (uint64_t word : storage->getData()) {
+            utils::appendLE<uint64_t>(out, word);
+        }
+    }
+}
+
+/**
+ * 从 serializeChunk() 的字节流恢复区块，覆盖 chunk 的全部分段
+ *
+ * 输入来自磁盘，不可信：长度不足、位宽或调色板不合法、索引越界、末尾有多余字节时
+ * 返回 false，此时 chunk 内容未定义，调用方应丢弃并重新生成。
+ */
+inline bool deserializeChunk(const uint8_t* data, size_t size, VoxelChunk& chunk) {
+    size_t pos = 0;
+    auto has   = [&](size_t bytes) { return size - pos >= bytes; };
+
+    for (int i = 0; i < VoxelChunk::SECTION_COUNT; i++) {
+        ChunkSection& section = chunk.getSection(i);
+
+        if (!has(1 + 4)) return false;
+        int bits = data[pos++];
+        uint32_t value = utils::readLE<uint32_t>(data + pos);
+        pos += 4;
+
+        if (bits == 0) {
+            section.assignUniform(value);
+            continue;
+        }
+
+        // value 为调色板长度；先检查上限，避免按损坏的长度分配内存
+        if (bits > PalettedBlockStorage::MAX_BITS || value == 0 || value > (1u << bits)) return false;
+        if (!has(size_t(value) * 4)) return false;
+        std::vector<uint32_t> palette(value);
+        for (uint32_t& typeId : palette) {
+            typeId = utils::readLE<uint32_t>(data + pos);
+            pos += 4;
+        }
+
+        size_t words = (size_t(ChunkSection::VOLUME) * bits + 63) / 64;
+        if (!has(words * 8)) return false;
+        std::vector<uint64_t> packed(words);
+        for (uint64_t& word : packed) {
+            word = utils::readLE<uint64_t>(data + pos);
+            pos += 8;
+        }
+
+        auto storage = PalettedBlockStorage::fromRaw(ChunkSection::VOLUME, bits, std::move(palette), std::move(packed));
+        if (!storage) return false;
+        section.assignStorage(std::move(storage));
+    }
+    return pos == size;
+}
+
+} // namespace game::chuck
@@ -5,11 +5,9 @@
 #include <array>
 #include <vector>
 
+#include "game/blocks/block_texture_table.hpp"
 #include "game/blocks/blocks_types.hpp"
-#include "game/chuck/chunk_mesh_optimizer.hpp"
-
-#include "renderer/mesh/mesh.hpp"
-#include "renderer/texture/texture.hpp"
+#include "game/chuck/chunk_mesher.hpp"
 
 
 namespace game::chuck {
@@ -26,22 +24,29 @@ namespace game::chuck {
  * - 减少 80-95% 的顶点数量
  * - 减少绘制调用
  * - 提高缓存友好性
+ *
+ * 无内部状态，可被多个网格工作线程同时调用；
+ * 区块边界上的面按邻居区块的方块剔除。
  */
-class GreedyMesher {
+class GreedyMesher : public ChunkMesher {
     public:
     // 构造函数
-    explicit GreedyMesher(renderer::TextureAtlas* textureAtlas)
-    : atlas(textureAtlas) {
-        if (!atlas) {
-            throw std::runtime_error("TextureAtlas cannot be null");
+    explicit GreedyMesher(const blocks::BlockTextureTable* textureTable)
+    : textures(textureTable) {
+        if (!textures) {
+            throw std::runtime_error("BlockTextureTable cannot be null");
         }
     }
 
-    // 主入口：生成区块的贪婪网格
-    std::unordered_map<uint32_t, renderer::CubeMesh::MeshData> generateMesh(
-    const VoxelChunk& chunk) {
+    // 单独生成一个区块的网格，区块外一律视为空气
+    renderer::ChunkMeshData generateMesh(const VoxelChunk& chunk) const {
+        return generateMesh(ChunkNeighborhood(chunk));
+    }
 
-        meshes.clear();
+    // 主入口：生成区块的贪婪网格
+    renderer::ChunkMeshData generateMesh(const ChunkNeighborhood& neighborhood) const override {
+        const VoxelChunk& chunk = *neighborhood.center;
+        renderer::ChunkMeshData mesh;
 
         int sizeX = chunk.getSizeX();
         int sizeY = chunk.getSizeY();
@@ -49,23 +54,22 @@ class GreedyMesher {
 
         // 为6个方向分别生成网格
         // X轴方向
-        generateAxisMesh(chunk, Axis::X, Direction::POSITIVE, sizeX, sizeY, sizeZ);
-        generateAxisMesh(chunk, Axis::X, Direction::NEGATIVE, sizeX, sizeY, sizeZ);
+        generateAxisMesh(neighborhood, Axis::X, Direction::POSITIVE, sizeX, sizeY, sizeZ, mesh);
+        generateAxisMesh(neighborhood, Axis::X, Direction::NEGATIVE, sizeX, sizeY, sizeZ, mesh);
 
         // Y轴方向
-        generateAxisMesh(chunk, Axis::Y, Direction::POSITIVE, sizeX, sizeY, sizeZ);
-        generateAxisMesh(chunk, Axis::Y, Direction::NEGATIVE, sizeX, sizeY, sizeZ);
+        generateAxisMesh(neighborhood, Axis::Y, Direction::POSITIVE, sizeX, sizeY, sizeZ, mesh);
+        generateAxisMesh(neighborhood, Axis::Y, Direction::NEGATIVE, sizeX, sizeY, sizeZ, mesh);
 
         // Z轴方向
-        generateAxisMesh(chunk, Axis::Z, Direction::POSITIVE, sizeX, sizeY, sizeZ);
-        generateAxisMesh(chunk, Axis::Z, Direction::NEGATIVE, sizeX, sizeY, sizeZ);
+        generateAxisMesh(neighborhood, Axis::Z, Direction::POSITIVE, sizeX, sizeY, sizeZ, mesh);
+        generateAxisMesh(neighborhood, Axis::Z, Direction::NEGATIVE, sizeX, sizeY, sizeZ, mesh);
 
-        return std::move(meshes);
+        return mesh;
     }
 
     private:
-    renderer::TextureAtlas* atlas;
-    std::unordered_map<uint32_t, renderer::CubeMesh::MeshData> meshes;
+    const blocks::BlockTextureTable* textures;
 
     // 坐标轴枚举
     enum class Axis { X,
@@ -98,15 +102,18 @@ class GreedyMesher {
     /**
      * 为指定轴向生成网格
      */
-    void generateAxisMesh(const VoxelChunk& chunk,
+    void generateAxisMesh(const ChunkNeighborhood& neighborhood,
     Axis axis,
     Direction direction,
     int sizeX,
     int sizeY,
-    int sizeZ) {
+    int sizeZ,
+    renderer::ChunkMeshData& mesh) const {
+
+        const VoxelChunk& chunk = *neighborhood.center;
 
         // 根据轴向确定遍历的维度
-        int depth, width, height;
+        int depth = 0, width = 0, height = 0;
         getAxisDimensions(axis, sizeX, sizeY, sizeZ, depth, width, height);
 
         // 创建2D遮罩（width x height）
@@ -114,11 +121,16 @@ class GreedyMesher {
 
         // 遍历深度维度（沿着法线方向）
         for (int d = 0; d < depth; d++) {
+            // Y 轴切片整层落在空分段内时没有任何面
+            if (axis == Axis::Y && chunk.isSectionEmpty(d >> 4)) {
+                continue;
+            }
+
             // 1. 生成当前切片的遮罩
-            generateSliceMask(chunk, axis, direction, d, width, height, mask);
+            generateSliceMask(neighborhood, axis, direction, d, width, height, mask);
 
             // 2. 从遮罩生成合并的矩形
-            generateQuadsFromMask(mask, width, height, axis, direction, d);
+            generateQuadsFromMask(*neighborhood.properties, mask, width, height, axis, direction, d, mesh);
 
             // 3. 清空遮罩准备下一个切片
             std::fill(mask.begin(), mask.end(), MaskEntry());
@@ -128,27 +140,32 @@ class GreedyMesher {
     /**
      * 生成单个切片的遮罩
      */
-    void generateSliceMask(const VoxelChunk& chunk,
+    void generateSliceMask(const ChunkNeighborhood& neighborhood,
     Axis axis,
     Direction direction,
     int depth,
     int width,
     int height,
-    std::vector<MaskEntry>& mask) {
+    std::vector<MaskEntry>& mask) const {
+
+        const VoxelChunk& chunk = *neighborhood.center;
 
         for (int h = 0; h < height; h++) {
+            // X/Z 轴切片中 h 即 Y 坐标，空分段内的整行跳过
+            if (axis != Axis::Y && chunk.isSectionEmpty(h >> 4)) {
+                continue;
+            }
+
             for (int w = 0; w < width; w++) {
                 // 获取3D坐标
                 glm::ivec3 pos         = get3DPosition(axis, w, h, depth);
                 glm::ivec3 neighborPos = pos + getNormalOffset(axis, direction);
 
-                // 获取当前方块和邻居方块
-                uint32_t currentBlock  = chunk.getBlock(pos.x, pos.y, pos.z);
-                uint32_t neighborBlock = chunk.getBlock(neighborPos.x, neighborPos.y, neighborPos.z);
+                // 获取当前方块；邻居位置可能落在相邻区块内
+                uint32_t currentBlock = chunk.getBlock(pos.x, pos.y, pos.z);
 
                 // 判断是否需要渲染这个面
-                bool shouldRender = shouldRenderFace(chunk, currentBlock, neighborBlock,
-                neighborPos);
+                bool shouldRender = shouldRenderFace(neighborhood, currentBlock, neighborPos);
 
                 if (shouldRender) {
                     mask[h * width + w] = MaskEntry(currentBlock, true);
@@ -168,12 +185,14 @@ class GreedyMesher {
      * 3. 向下扩展，找到最大高度
      * 4. 生成矩形，标记已处理的区域
      */
-    void generateQuadsFromMask(std::vector<MaskEntry>& mask,
+    void generateQuadsFromMask(const blocks::BlockPropertyTable& properties,
+    std::vector<MaskEntry>& mask,
     int width,
     int height,
     Axis axis,
     Direction direction,
-    int depth) {
+    int depth,
+    renderer::ChunkMeshData& mesh) const {
 
         for (int h = 0; h < height; h++) {
             for (int w = 0; w < width;) {
@@ -219,7 +238,7 @@ class GreedyMesher {
 
                 // 3. 生成合并的矩形面
                 blocks::BlockFace face = getFaceFromAxisDirection(axis, direction);
-                createMergedQuad(blockType, axis, direction, depth,
+                createMergedQuad(properties, mesh, blockType, axis, direction, depth,
                 w, h, rectWidth, rectHeight, face);
 
                 // 4. 清除遮罩中已处理的区域
@@ -238,7 +257,9 @@ class GreedyMesher {
     /**
      * 创建合并的矩形面
      */
-    void createMergedQuad(uint32_t blockType,
+    void createMergedQuad(const blocks::BlockPropertyTable& properties,
+    renderer::ChunkMeshData& meshData,
+    uint32_t blockType,
     Axis axis,
     Direction direction,
     int depth,
@@ -246,68 +267,59 @@ class GreedyMesher {
     int startH,
     int width,
     int height,
-    blocks::BlockFace face) {
+    blocks::BlockFace face) const {
 
-        // 获取方块类型定义
-        auto* blockTypeDef = blocks::BlockTypeRegistry::getInstance().getBlockType(blockType);
-        if (!blockTypeDef) return;
+        if (!properties.isRegistered(blockType)) return;
 
-        // 获取纹理坐标
-        const std::string& textureName = blockTypeDef->getTexture(face);
-        renderer::TextureUV uv         = atlas->getUV(textureName);
+        // 纹理数组的层；UV 与平铺由着色器按位置和面推出
+        uint16_t textureLayer = textures->getLayer(blockType, face);
 
         // 计算4个顶点的3D位置
-        std::array<glm::vec3, 4> vertices = calculateQuadVertices(
+        std::array<glm::ivec3, 4> vertices = calculateQuadVertices(
         axis, direction, depth, startW, startH, width, height);
 
-        // 计算法线
-        glm::vec3 normal = calculateNormal(axis, direction);
-
-        // 计算UV坐标（支持纹理平铺）
-        std::array<glm::vec2, 4> uvCoords = calculateUVCoords(uv, width, height);
-
         // 添加到网格数据
-        addQuadToMesh(meshes[blockType], vertices, normal, uvCoords, uv);
+        meshData.addQuad(vertices, static_cast<int>(face), textureLayer);
     }
 
     /**
      * 计算矩形的4个顶点位置
      */
-    std::array<glm::vec3, 4> calculateQuadVertices(Axis axis,
+    std::array<glm::ivec3, 4> calculateQuadVertices(Axis axis,
     Direction direction,
     int depth,
     int startW,
     int startH,
     int width,
-    int height) {
-        std::array<glm::vec3, 4> vertices;
+    int height) const {
+        std::array<glm::ivec3, 4> vertices;
 
         // 基础偏移（用于正/负方向）
-        float depthOffset = (direction == Direction::POSITIVE) ? 1.0f : 0.0f;
+        int depthOffset = (direction == Direction::POSITIVE) ? 1 : 0;
 
         switch (axis) {
         case Axis::X:
             // X轴：YZ平面
-            vertices[0] = glm::vec3(depth + depthOffset, startH, startW);
-            vertices[1] = glm::vec3(depth + depthOffset, startH, startW + width);
-            vertices[2] = glm::vec3(depth + depthOffset, startH + height, startW + width);
-            vertices[3] = glm::vec3(depth + depthOffset, startH + height, startW);
+            vertices[0] = glm::ivec3(depth + depthOffset, startH, startW);
+            vertices[1] = glm::ivec3(depth + depthOffset, startH, startW + width);
+            vertices[2] = glm::ivec3(depth + depthOffset, startH + height, startW + width);
+            vertices[3] = glm::ivec3(depth + depthOffset, startH + height, startW);
             break;
 
         case Axis::Y:
             // Y轴：XZ平面
-            vertices[0] = glm::vec3(startW, depth + depthOffset, startH);
-            vertices[1] = glm::vec3(startW + width, depth + depthOffset, startH);
-            vertices[2] = glm::vec3(startW + width, depth + depthOffset, startH + height);
-            vertices[3] = glm::vec3(startW, depth + depthOffset, startH + height);
+            vertices[0] = glm::ivec3(startW, depth + depthOffset, startH);
+            vertices[1] = glm::ivec3(startW + width, depth + depthOffset, startH);
+            vertices[2] = glm::ivec3(startW + width, depth + depthOffset, startH + height);
+            vertices[3] = glm::ivec3(startW, depth + depthOffset, startH + height);
             break;
 
         case Axis::Z:
             // Z轴：XY平面
-            vertices[0] = glm::vec3(startW, startH, depth + depthOffset);
-            vertices[1] = glm::vec3(startW + width, startH, depth + depthOffset);
-            vertices[2] = glm::vec3(startW + width, startH + height, depth + depthOffset);
-            vertices[3] = glm::vec3(startW, startH + height, depth + depthOffset);
+            vertices[0] = glm::ivec3(startW, startH, depth + depthOffset);
+            vertices[1] = glm::ivec3(startW + width, startH, depth + depthOffset);
+            vertices[2] = glm::ivec3(startW + width, startH + height, depth + depthOffset);
+            vertices[3] = glm::ivec3(startW, startH + height, depth + depthOffset);
             break;
         }
 
@@ -319,99 +331,12 @@ class GreedyMesher {
         return vertices;
     }
 
-    /**
-     * 计算UV坐标（支持纹理平铺）
-     */
-    std::array<glm::vec2, 4> calculateUVCoords(const renderer::TextureUV& baseUV,
-    int width,
-    int height) {
-        std::array<glm::vec2, 4> uvCoords;
-
-        float uvWidth  = baseUV.max.x - baseUV.min.x;
-        float uvHeight = baseUV.max.y - baseUV.min.y;
-
-        // 添加小量内缩以避免纹理边缘渗色
-        // 对于图集纹理，即使使用 CLAMP_TO_EDGE，由于 mipmap 和浮点精度，
-        // 仍可能采样到相邻纹理。内缩半个像素可以避免此问题
-        constexpr float INSET_EPSILON = 0.0005f; // 约为半个像素（假设2048图集）
-
-        float insetMinU = baseUV.min.x + INSET_EPSILON;
-        float insetMinV = baseUV.min.y + INSET_EPSILON;
-        float insetMaxU = baseUV.max.x - INSET_EPSILON;
-        float insetMaxV = baseUV.max.y - INSET_EPSILON;
-
-        // 计算内缩后的UV范围
-        float insetWidth = insetMaxU - insetMinU;
-        float insetHeight = insetMaxV - insetMinV;
-
-        // UV坐标平铺，但限制在内缩的边界内
-        uvCoords[0] = glm::vec2(insetMinU, insetMinV);
-        uvCoords[1] = glm::vec2(insetMinU + insetWidth * width, insetMinV);
-        uvCoords[2] = glm::vec2(insetMinU + insetWidth * width, insetMinV + insetHeight * height);
-        uvCoords[3] = glm::vec2(insetMinU, insetMinV + insetHeight * height);
-
-        return uvCoords;
-    }
-
-    /**
-     * 计算法线向量
-     */
-    glm::vec3 calculateNormal(Axis axis, Direction direction) {
-        float sign = (direction == Direction::POSITIVE) ? 1.0f : -1.0f;
-
-        switch (axis) {
-        case Axis::X: return glm::vec3(sign, 0, 0);
-        case Axis::Y: return glm::vec3(0, sign, 0);
-        case Axis::Z: return glm::vec3(0, 0, sign);
-        }
-
-        return glm::vec3(0, 1, 0); // 默认
-    }
-
-    /**
-     * 添加矩形到网格数据
-     */
-    void addQuadToMesh(renderer::CubeMesh::MeshData& meshData,
-    const std::array<glm::vec3, 4>& vertices,
-    const glm::vec3& normal,
-    const std::array<glm::vec2, 4>& uvCoords,
-    const renderer::TextureUV& textureBounds) { // 新增参数
-
-        uint32_t baseIndex = meshData.vertices.size();
-
-        // 将纹理边界打包成 vec4
-        glm::vec4 bounds(
-        textureBounds.min.x,
-        textureBounds.min.y,
-        textureBounds.max.x,
-        textureBounds.max.y);
-
-        // 添加4个顶点
-        for (int i = 0; i < 4; i++) {
-            renderer::Vertex vertex;
-            vertex.position      = vertices[i];
-            vertex.normal        = normal;
-            vertex.texCoord      = uvCoords[i];
-            vertex.textureBounds = bounds; // 设置纹理边界
-            meshData.vertices.push_back(vertex);
-        }
-
-        // 添加索引（不变）
-        meshData.indices.push_back(baseIndex + 0);
-        meshData.indices.push_back(baseIndex + 1);
-        meshData.indices.push_back(baseIndex + 2);
-
-        meshData.indices.push_back(baseIndex + 0);
-        meshData.indices.push_back(baseIndex + 2);
-        meshData.indices.push_back(baseIndex + 3);
-    }
-
     // ========== 辅助函数 ==========
 
     /**
      * 根据轴向获取维度大小
      */
-    void getAxisDimensions(Axis axis, int sizeX, int sizeY, int sizeZ, int& depth, int& width, int& height) {
+    void getAxisDimensions(Axis axis, int sizeX, int sizeY, int sizeZ, int& depth, int& width, int& height) const {
         switch (axis) {
         case Axis::X:
             depth  = sizeX;
@@ -434,7 +359,7 @@ class GreedyMesher {
     /**
      * 从2D坐标转换为3D坐标
      */
-    glm::ivec3 get3DPosition(Axis axis, int w, int h, int d) {
+    glm::ivec3 get3DPosition(Axis axis, int w, int h, int d) const {
         switch (axis) {
         case Axis::X: return glm::ivec3(d, h, w);
         case Axis::Y: return glm::ivec3(w, d, h);
@@ -446,7 +371,7 @@ class GreedyMesher {
     /**
      * 获取法线方向的偏移
      */
-    glm::ivec3 getNormalOffset(Axis axis, Direction direction) {
+    glm::ivec3 getNormalOffset(Axis axis, Direction direction) const {
         int sign = (direction == Direction::POSITIVE) ? 1 : -1;
 
         switch (axis) {
@@ -461,7 +386,7 @@ class GreedyMesher {
     /**
      * 从轴向和方向获取BlockFace
      */
-    blocks::BlockFace getFaceFromAxisDirection(Axis axis, Direction direction) {
+    blocks::BlockFace getFaceFromAxisDirection(Axis axis, Direction direction) const {
         using namespace blocks;
 
         if (axis == Axis::X) {
@@ -476,18 +401,15 @@ class GreedyMesher {
     /**
      * 判断是否应该渲染面
      */
-    bool shouldRenderFace(const VoxelChunk& chunk,
+    bool shouldRenderFace(const ChunkNeighborhood& neighborhood,
     uint32_t currentBlock,
-    uint32_t neighborBlock,
-    const glm::ivec3& neighborPos) {
-        (void)neighborBlock;
+    const glm::ivec3& neighborPos) const {
 
         // 当前方块是空气，不渲染
         if (currentBlock == 0) return false;
 
-
-        // 邻居是实心方块，不渲染（被遮挡）
-        if (chunk.isBlockSolid(neighborPos.x, neighborPos.y, neighborPos.z)) {
+        // 邻居遮挡时不渲染，包括相邻区块的边界方块
+        if (neighborhood.isOccluding(neighborPos.x, neighborPos.y, neighborPos.z)) {
             return false;
         }
 
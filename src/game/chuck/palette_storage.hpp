@@ -0,0 +1,214 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace game::chuck {
+
+/**
+ * 调色板压缩的方块存储
+ *
+ * 每个位置只保存调色板索引，索引按位打包进 64 位字：
+ * - 调色板 <= 2 种方块：1 位/方块
+ * - 调色板 <= 4 / 16 / 256 / 65536 种：2 / 4 / 8 / 16 位/方块
+ *
+ * 位宽始终为 2 的幂，因此一个索引不会跨越两个字，读取只需一次移位和掩码。
+ * 调色板只增不减；出现新方块类型导致容量不足时整体重新打包到更宽的位宽。
+ */
+class PalettedBlockStorage {
+    public:
+    static constexpr int MAX_BITS = 16;
+
+    explicit PalettedBlockStorage(int entryCount, uint32_t initialType = 0)
+    : entryCount(entryCount) {
+        palette.push_back(initialType);
+        resize(1);
+    }
+
+    uint32_t get(int index) const {
+        return palette[readIndex(index)];
+    }
+
+    void set(int index, uint32_t typeId) {
+        writeIndex(index, getOrAddPaletteIndex(typeId));
+    }
+
+    // 从 first 开始按 stride 写入 count 个相同方块，调色板只查找一次
+    void fill(int first, int count, int stride, uint32_t typeId) {
+        uint32_t paletteIndex = getOrAddPaletteIndex(typeId);
+        for (int i = 0, index = first; i < count; i++, index += stride) {
+            writeIndex(index, paletteIndex);
+        }
+    }
+
+    // 存储实际占用的字节数（不含对象本身）
+    size_t getMemoryUsage() const {
+        return data.capacity() * sizeof(uint64_t) + palette.capacity() * sizeof(uint32_t);
+    }
+
+    int getBitsPerEntry() const { return 1 << bitsLog2; }
+    size_t getPaletteSize() const { return palette.size(); }
+    const std::vector<uint32_t>& getPalette() const { return palette; }
+    // 打包后的索引字，按位置顺序；序列化时原样写出
+    const std::vector<uint64_t>& getData() const { return data; }
+
+    // 从序列化的位宽、调色板和索引字恢复；任何字段不合法（含指向调色板之外的索引）时返回空指针
+    static std::unique_ptr<PalettedBlockStorage> fromRaw(int entryCount, int bits,
+    std::vector<uint32_t> palette, std::vector<uint64_t> data) {
+        if (bits <= 0 || bits > MAX_BITS || (bits & (bits - 1)) != 0) return nullptr;
+        if (palette.empty() || palette.size() > (size_t(1) << bits)) return nullptr;
+        if (data.size() != getWordCount(entryCount, bits)) return nullptr;
+
+        auto storage = fromPacked(entryCount, bits, std::move(palette), std::move(data));
+        if (storage->palette.size() == (size_t(1) << bits)) return storage; // 调色板占满，任何索引都合法
+        for (int i = 0; i < entryCount; i++) {
+            if (storage->readIndex(i) >= storage->palette.size()) return nullptr;
+        }
+        return storage;
+    }
+
+    // 由调用方直接打包好的数据构造，不做检查：位宽须为 2 的幂，data 长度为 getWordCount()，索引都在调色板内
+    static std::unique_ptr<PalettedBlockStorage> fromPacked(int entryCount, int bits,
+    std::vector<uint32_t> palette, std::vector<uint64_t> data) {
+        return std::unique_ptr<PalettedBlockStorage>(
+        new PalettedBlockStorage(entryCount, bits, std::move(palette), std::move(data)));
+    }
+
+    // 由每个位置的调色板索引构造，自动选择最小位宽；调用方保证索引都小于 palette.size() 且调色板不超过 65536 项
+    static std::unique_ptr<PalettedBlockStorage> fromIndices(int entryCount, std::vector<uint32_t> palette,
+    const uint16_t* indices) {
+        int needed = palette.size() > 1 ? 32 - __builtin_clz(static_cast<unsigned>(palette.size() - 1)) : 1;
+        int bits   = 1;
+        while (bits < needed) bits *= 2;
+
+        std::vector<uint64_t> data(getWordCount(entryCount, bits), 0);
+        switch (bits) {
+        case 1: packWords<1>(indices, entryCount, data); break;
+        case 2: packWords<2>(indices, entryCount, data); break;
+        case 4: packWords<4>(indices, entryCount, data); break;
+        case 8: packWords<8>(indices, entryCount, data); break;
+        default: packWords<16>(indices, entryCount, data); break;
+        }
+        return fromPacked(entryCount, bits, std::move(palette), std::move(data));
+    }
+
+    static size_t getWordCount(int entryCount, int bits) {
+        return (static_cast<size_t>(entryCount) * bits + 63) / 64;
+    }
+
+    // 按位置顺序展开全部调色板索引，比逐个 get() 快得多；out 至少 entryCount 项
+    void unpackIndices(uint16_t* out) const {
+        switch (bitsLog2) {
+        case 0: unpackWords<1>(out); break;
+        case 1: unpackWords<2>(out); break;
+        case 2: unpackWords<4>(out); break;
+        case 3: unpackWords<8>(out); break;
+        default: unpackWords<16>(out); break;
+        }
+    }
+
+    private:
+    int entryCount;
+    int bitsLog2           = 0;    // log2(每个索引的位数)
+    int entriesPerWordLog2 = 6;    // log2(每个 64 位字容纳的索引数)
+    uint64_t entryMask     = 1;    // 取出单个索引的掩码
+    std::vector<uint32_t> palette; // 调色板索引 -> 方块 ID
+    std::vector<uint64_t> data;    // 打包后的调色板索引
+
+    PalettedBlockStorage(int entryCount, int bits, std::vector<uint32_t> palette, std::vector<uint64_t> data)
+    : entryCount(entryCount),
+      bitsLog2(__builtin_ctz(static_cast<unsigned>(bits))),
+      entriesPerWordLog2(6 - bitsLog2),
+      entryMask((uint64_t(1) << bits) - 1),
+      palette(std::move(palette)),
+      data(std::move(data)) {}
+
+    // 位宽为编译期常量，内层循环可以完全展开
+    template <int Bits>
+    void unpackWords(uint16_t* out) const {
+        constexpr int PER_WORD = 64 / Bits;
+        constexpr uint64_t MASK = (uint64_t(1) << Bits) - 1;
+
+        int index = 0;
+        for (uint64_t word : data) {
+            int count = std::min(PER_WORD, entryCount - index);
+            for (int j = 0; j < count; j++) {
+                out[index + j] = static_cast<uint16_t>((word >> (j * Bits)) & MASK);
+            }
+            index += count;
+        }
+    }
+
+    template <int Bits>
+    static void packWords(const uint16_t* indices, int entryCount, std::vector<uint64_t>& data) {
+        constexpr int PER_WORD = 64 / Bits;
+
+        for (size_t w = 0; w < data.size(); w++) {
+            int first = static_cast<int>(w) * PER_WORD;
+            int count = std::min(PER_WORD, entryCount - first);
+            uint64_t word = 0;
+            for (int j = 0; j < count; j++) {
+                word |= static_cast<uint64_t>(indices[first + j]) << (j * Bits);
+            }
+            data[w] = word;
+        }
+    }
+
+    uint32_t readIndex(int index) const {
+        uint64_t word = data[index >> entriesPerWordLog2];
+        int shift     = (index & ((1 << entriesPerWordLog2) - 1)) << bitsLog2;
+        return static_cast<uint32_t>((word >> shift) & entryMask);
+    }
+
+    void writeIndex(int index, uint32_t paletteIndex) {
+        uint64_t& word = data[index >> entriesPerWordLog2];
+        int shift      = (index & ((1 << entriesPerWordLog2) - 1)) << bitsLog2;
+        word           = (word & ~(entryMask << shift)) | (static_cast<uint64_t>(paletteIndex) << shift);
+    }
+
+    uint32_t getOrAddPaletteIndex(uint32_t typeId) {
+        // 调色板通常只有几项，线性查找比哈希表更快
+        for (size_t i = 0; i < palette.size(); i++) {
+            if (palette[i] == typeId) return static_cast<uint32_t>(i);
+        }
+
+        if (palette.size() == (size_t(1) << getBitsPerEntry())) {
+            if (getBitsPerEntry() == MAX_BITS) {
+                throw std::runtime_error("Too many distinct block types in one palette");
+            }
+            resize(getBitsPerEntry() * 2);
+        }
+
+        palette.push_back(typeId);
+        return static_cast<uint32_t>(palette.size() - 1);
+    }
+
+    // 按新的位宽重新打包所有索引：逐个旧字展开到新数组，不经过临时索引表
+    void resize(int bits) {
+        std::vector<uint64_t> old;
+        old.swap(data);
+        int oldBitsLog2       = bitsLog2;
+        int oldPerWordLog2    = entriesPerWordLog2;
+        uint64_t oldEntryMask = entryMask;
+
+        bitsLog2           = __builtin_ctz(static_cast<unsigned>(bits));
+        entriesPerWordLog2 = 6 - bitsLog2;
+        entryMask          = (uint64_t(1) << bits) - 1;
+
+        data.assign(((entryCount << bitsLog2) + 63) / 64, 0);
+
+        int index = 0;
+        for (uint64_t word : old) {
+            for (int j = 0; j < (1 << oldPerWordLog2) && index < entryCount; j++, index++) {
+                uint64_t value = (word >> (j << oldBitsLog2)) & oldEntryMask;
+                int shift      = (index & ((1 << entriesPerWordLog2) - 1)) << bitsLog2;
+                data[index >> entriesPerWordLog2] |= value << shift;
+            }
+        }
+    }
+};
+
+} // namespace game::chuck
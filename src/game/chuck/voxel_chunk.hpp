@@ -0,0 +1,137 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include "game/blocks/blocks_types.hpp"
+#include "game/chuck/chunk_section.hpp"
+
+namespace game::chuck {
+
+// 简化的方块世界表示
+// 由 16 个 16x16x16 垂直分段组成；全空气或全同一方块的分段不占存储，
+// 其余分段以调色板 + 位打包索引存储
+class VoxelChunk {
+    public:
+    static constexpr int SECTION_SIZE  = ChunkSection::SIZE;
+    static constexpr int SECTION_COUNT = 16;
+
+    private:
+    static constexpr int CHUNK_SIZE_X = 16;
+    static constexpr int CHUNK_SIZE_Y = SECTION_SIZE * SECTION_COUNT;
+    static constexpr int CHUNK_SIZE_Z = 16;
+
+    std::array<ChunkSection, SECTION_COUNT> sections;
+
+    public:
+    void setBlock(int x, int y, int z, uint32_t typeId) {
+        if (x >= 0 && x < CHUNK_SIZE_X &&
+        y >= 0 && y < CHUNK_SIZE_Y &&
+        z >= 0 && z < CHUNK_SIZE_Z) {
+            sections[y >> 4].set(x, y & 15, z, typeId);
+        }
+    }
+
+    // 把 (x, z) 列的 [y0, y1) 写成同一方块，按分段拆开；超出区块的部分被裁掉
+    void fillColumn(int x, int z, int y0, int y1, uint32_t typeId) {
+        if (x < 0 || x >= CHUNK_SIZE_X || z < 0 || z >= CHUNK_SIZE_Z) return;
+
+        y0 = std::max(y0, 0);
+        y1 = std::min(y1, CHUNK_SIZE_Y);
+        while (y0 < y1) {
+            int base = y0 & ~(SECTION_SIZE - 1);
+            int end  = std::min(y1, base + SECTION_SIZE);
+            sections[y0 >> 4].fillColumn(x, z, y0 - base, end - base, typeId);
+            y0 = end;
+        }
+    }
+
+    // 把 [y0, y1) 的整层写成同一方块；被完全覆盖的分段不分配存储
+    void fillLayers(int y0, int y1, uint32_t typeId) {
+        y0 = std::max(y0, 0);
+        y1 = std::min(y1, CHUNK_SIZE_Y);
+        while (y0 < y1) {
+            int base = y0 & ~(SECTION_SIZE - 1);
+            int end  = std::min(y1, base + SECTION_SIZE);
+            sections[y0 >> 4].fillLayers(y0 - base, end - base, typeId);
+            y0 = end;
+        }
+    }
+
+    uint32_t getBlock(int x, int y, int z) const {
+        if (x < 0 || x >= CHUNK_SIZE_X ||
+        y < 0 || y >= CHUNK_SIZE_Y ||
+        z < 0 || z >= CHUNK_SIZE_Z) {
+            return 0;
+        }
+        return sections[y >> 4].get(x, y & 15, z);
+    }
+
+    const ChunkSection& getSection(int index) const { return sections[index]; }
+    ChunkSection& getSection(int index) { return sections[index]; }
+    bool isSectionEmpty(int index) const { return sections[index].isEmpty(); }
+
+    // 批量写入后调用：把变得均匀的分段收缩为零存储
+    void compact() {
+        for (auto& section : sections) {
+            section.compact();
+        }
+    }
+
+    // 最低 / 最高的非空分段，整个区块为空时返回 -1
+    int getLowestNonEmptySection() const {
+        for (int i = 0; i < SECTION_COUNT; i++) {
+            if (!sections[i].isEmpty()) return i;
+        }
+        return -1;
+    }
+
+    int getHighestNonEmptySection() const {
+        for (int i = SECTION_COUNT - 1; i >= 0; i--) {
+            if (!sections[i].isEmpty()) return i;
+        }
+        return -1;
+    }
+
+    // 方块数据占用的堆内存（字节）
+    size_t getMemoryUsage() const {
+        size_t bytes = 0;
+        for (const auto& section : sections) {
+            bytes += section.getMemoryUsage();
+        }
+        return bytes;
+    }
+
+    // 碰撞查询；未注册的方块视为空气
+    bool isBlockSolid(int x, int y, int z) const {
+        return blocks::getBlockProperties().isSolid(getBlock(x, y, z));
+    }
+
+    // 检查某个面是否需要渲染（相邻方块是否遮挡）
+    bool shouldRenderFace(int x, int y, int z, blocks::BlockFace face) const {
+        if (getBlock(x, y, z) == 0) return false; // 空气不渲染
+
+        using namespace blocks;
+
+        // 检查相邻方块
+        int nx = x, ny = y, nz = z;
+        switch (face) {
+        case BlockFace::FRONT: nz++; break;
+        case BlockFace::BACK: nz--; break;
+        case BlockFace::LEFT: nx--; break;
+        case BlockFace::RIGHT: nx++; break;
+        case BlockFace::TOP: ny++; break;
+        case BlockFace::BOTTOM: ny--; break;
+        }
+
+        // 相邻方块不遮挡时需要渲染这个面
+        return !blocks::getBlockProperties().isOccluding(getBlock(nx, ny, nz));
+    }
+
+    int getSizeX() const { return CHUNK_SIZE_X; }
+    int getSizeY() const { return CHUNK_SIZE_Y; }
+    int getSizeZ() const { return CHUNK_SIZE_Z; }
+};
+
+} // namespace game::chuck
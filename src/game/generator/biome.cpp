@@ -0,0 +1,47 @@
+#include "biome.hpp"
+
+#include "game/blocks/blocks.hpp"
+
+namespace game::generator {
+
+namespace {
+
+using namespace ::game::blocks::BlockIDs;
+
+// Indexed by BiomeType. PLAINS keeps the block choices of biome-less terrain.
+constexpr Biome BIOMES[] = {
+    { "plains", GRASS, DIRT, SAND, 0.0, 0.5, 0 },
+    { "forest", GRASS, DIRT, SAND, 3.0, 0.8, 0 },
+    { "desert", SAND, SAND, SAND, 2.0, 0.35, -6 },
+    { "swamp", GRASS, DIRT, DIRT, -4.0, 0.2, 1 },
+    { "mountains", GRASS, DIRT, STONE, 14.0, 1.3, 0 },
+};
+
+static_assert(sizeof(BIOMES) / sizeof(BIOMES[0]) == static_cast<size_t>(BiomeType::COUNT));
+
+} // namespace
+
+const Biome& getBiome(BiomeType type) {
+    return BIOMES[static_cast<size_t>(type)];
+}
+
+/**
+ * @brief Map a climate to a biome
+ *
+ * Cold climates are mountains whatever their humidity; warm and dry ones
+ * are desert. The rest splits by humidity into plains, forest and, the
+ * wettest, swamp.
+ *
+ * @param temperature Temperature noise, roughly [-1, 1]
+ * @param humidity Humidity noise, roughly [-1, 1]
+ * @return Biome of the climate
+ */
+BiomeType classifyBiome(double temperature, double humidity) {
+    if (temperature < -0.15) return BiomeType::MOUNTAINS;
+    if (temperature > 0.05 && humidity < -0.05) return BiomeType::DESERT;
+    if (humidity > 0.2) return BiomeType::SWAMP;
+    if (humidity > 0.05) return BiomeType::FOREST;
+    return BiomeType::PLAINS;
+}
+
+} // namespace game::generator
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+
+namespace game::generator {
+
+/**
+ * @brief Climate zones the terrain generator distinguishes
+ */
+enum class BiomeType : uint8_t {
+    PLAINS,    // Gentle grassland, the terrain of worlds without biomes
+    FOREST,    // Somewhat higher and hillier grassland
+    DESERT,    // Low sand dunes, water table well below the ground
+    SWAMP,     // Flat, barely above the water, muddy shores
+    MOUNTAINS, // High and steep, rocky shores
+    COUNT
+};
+
+/**
+ * @brief What a biome changes about the terrain
+ *
+ * Height parameters are blended between neighbouring biomes so their
+ * borders never form cliffs; block choices switch per column.
+ */
+struct Biome {
+    const char* name;
+    uint32_t surfaceBlock; // Top block of a column
+    uint32_t soilBlock;    // The two blocks under the surface
+    uint32_t shoreBlock;   // Surface and soil within two blocks of the water level
+    double heightOffset;   // Blocks added to the base height
+    double heightScale;    // Multiplies the generator's max height variation
+    int waterOffset;       // Blocks added to the generator's water level
+};
+
+/**
+ * @brief Parameters of a biome
+ */
+const Biome& getBiome(BiomeType type);
+
+/**
+ * @brief Biome of a climate
+ * @param temperature Temperature noise, roughly [-1, 1]
+ * @param humidity Humidity noise, roughly [-1, 1]
+ */
+BiomeType classifyBiome(double temperature, double humidity);
+
+} // namespace game::generator
@@ -0,0 +1,133 @@
+#include "climate_map.hpp"
+
+#include <cmath>
+
+namespace game::generator {
+
+namespace {
+
+constexpr int CLIMATE_OCTAVES        = 3;
+constexpr double CLIMATE_PERSISTENCE = 0.5;
+
+// Floor division, so negative coordinates map to the region that contains them
+int floorDiv(int v, int d) {
+    return v >= 0 ? v / d : (v + 1) / d - 1;
+}
+
+} // namespace
+
+/**
+ * @brief Construct a climate map
+ *
+ * Scale 0.002 gives climate zones several hundred blocks across, against
+ * hills some 20 blocks across at the terrain's default scale.
+ *
+ * @param seed Random seed for temperature; humidity uses seed + 1
+ */
+ClimateMap::ClimateMap(unsigned int seed)
+: temperatureNoise(seed),
+  humidityNoise(seed + 1),
+  scale(0.002f),
+  regionCache(REGION_CACHE_CAPACITY) {}
+
+/**
+ * @brief Interpolate climate for a block of columns
+ *
+ * Consecutive columns almost always fall in the same region, so the
+ * region is only looked up again when a column leaves it.
+ */
+void ClimateMap::sampleColumns(int startX, int startZ, int sizeX, int sizeZ, ColumnClimate* out) const {
+    constexpr int CELL    = ClimateRegion::CELL;
+    constexpr int SIZE    = ClimateRegion::SIZE;
+    constexpr int SAMPLES = ClimateRegion::SAMPLES;
+
+    std::shared_ptr<const ClimateRegion> region;
+    int regionX = 0, regionZ = 0;
+
+    for (int x = 0; x < sizeX; x++) {
+        for (int z = 0; z < sizeZ; z++) {
+            int worldX = startX + x;
+            int worldZ = startZ + z;
+
+            int rx = floorDiv(worldX, SIZE);
+            int rz = floorDiv(worldZ, SIZE);
+            if (!region || rx != regionX || rz != regionZ) {
+                region  = getRegion(rx, rz);
+                regionX = rx;
+                regionZ = rz;
+            }
+
+            int localX = worldX - rx * SIZE;
+            int localZ = worldZ - rz * SIZE;
+            double fx  = (localX % CELL) / double(CELL);
+            double fz  = (localZ % CELL) / double(CELL);
+
+            int s00 = (localX / CELL) * SAMPLES + localZ / CELL;
+            int s01 = s00 + 1;
+            int s10 = s00 + SAMPLES;
+            int s11 = s10 + 1;
+
+            double w00 = (1.0 - fx) * (1.0 - fz);
+            double w01 = (1.0 - fx) * fz;
+            double w10 = fx * (1.0 - fz);
+            double w11 = fx * fz;
+
+            auto blend = [&](const std::array<double, SAMPLES * SAMPLES>& v) {
+                return w00 * v[s00] + w01 * v[s01] + w10 * v[s10] + w11 * v[s11];
+            };
+
+            const Biome& b00 = getBiome(region->biomes[s00]);
+            const Biome& b01 = getBiome(region->biomes[s01]);
+            const Biome& b10 = getBiome(region->biomes[s10]);
+            const Biome& b11 = getBiome(region->biomes[s11]);
+
+            ColumnClimate& climate = out[x * sizeZ + z];
+            climate.biome          = classifyBiome(blend(region->temperature), blend(region->humidity));
+            climate.heightOffset   = w00 * b00.heightOffset + w01 * b01.heightOffset + w10 * b10.heightOffset + w11 * b11.heightOffset;
+            climate.heightScale    = w00 * b00.heightScale + w01 * b01.heightScale + w10 * b10.heightScale + w11 * b11.heightScale;
+            climate.waterOffset    = static_cast<int>(std::lround(
+            w00 * b00.waterOffset + w01 * b01.waterOffset + w10 * b10.waterOffset + w11 * b11.waterOffset));
+        }
+    }
+}
+
+std::shared_ptr<const ClimateRegion> ClimateMap::getRegion(int regionX, int regionZ) const {
+    if (auto cached = regionCache.find(regionX, regionZ)) {
+        return cached;
+    }
+
+    auto region = computeRegion(regionX, regionZ);
+    regionCache.insert(regionX, regionZ, region);
+    return region;
+}
+
+/**
+ * @brief Sample temperature and humidity on a region's cell corners
+ *
+ * @param regionX Region X index
+ * @param regionZ Region Z index
+ * @return Newly sampled region
+ */
+std::shared_ptr<const ClimateRegion> ClimateMap::computeRegion(int regionX, int regionZ) const {
+    constexpr int SAMPLES = ClimateRegion::SAMPLES;
+    constexpr int COUNT   = SAMPLES * SAMPLES;
+
+    std::array<double, COUNT> xs, zs;
+    for (int x = 0; x < SAMPLES; x++) {
+        for (int z = 0; z < SAMPLES; z++) {
+            xs[x * SAMPLES + z] = (regionX * ClimateRegion::SIZE + x * ClimateRegion::CELL) * scale;
+            zs[x * SAMPLES + z] = (regionZ * ClimateRegion::SIZE + z * ClimateRegion::CELL) * scale;
+        }
+    }
+
+    auto region = std::make_shared<ClimateRegion>();
+    temperatureNoise.fbmBatch(xs.data(), zs.data(), region->temperature.data(), COUNT, CLIMATE_OCTAVES, CLIMATE_PERSISTENCE);
+    humidityNoise.fbmBatch(xs.data(), zs.data(), region->humidity.data(), COUNT, CLIMATE_OCTAVES, CLIMATE_PERSISTENCE);
+
+    for (int i = 0; i < COUNT; i++) {
+        region->biomes[i] = classifyBiome(region->temperature[i], region->humidity[i]);
+    }
+    return region;
+}
+
+} // namespace game::generator
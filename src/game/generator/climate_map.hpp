@@ -0,0 +1,103 @@
+#pragma once
+
+#include "game/generator/biome.hpp"
+#include "game/generator/grid_cache.hpp"
+#include "game/generator/perlin_noise.hpp"
+
+#include <array>
+#include <memory>
+
+namespace game::generator {
+
+/**
+ * @brief Biome and blended terrain parameters of one column
+ */
+struct ColumnClimate {
+    BiomeType biome     = BiomeType::PLAINS;
+    double heightOffset = 0.0; // Blocks added to the base height
+    double heightScale  = 1.0; // Multiplies the max height variation
+    int waterOffset     = 0;   // Blocks added to the water level
+};
+
+/**
+ * @brief Temperature and humidity samples covering one region
+ *
+ * A region is REGION_CELLS x REGION_CELLS climate cells; samples sit on
+ * the cell corners, so the last row and column are shared with the
+ * neighbouring regions.
+ */
+struct ClimateRegion {
+    static constexpr int CELL         = 32; // Blocks between climate samples
+    static constexpr int REGION_CELLS = 8;  // Cells per region side
+    static constexpr int SIZE         = CELL * REGION_CELLS;
+    static constexpr int SAMPLES      = REGION_CELLS + 1;
+
+    std::array<double, SAMPLES * SAMPLES> temperature; // Index x * SAMPLES + z
+    std::array<double, SAMPLES * SAMPLES> humidity;
+    std::array<BiomeType, SAMPLES * SAMPLES> biomes;   // Biome of each sample's climate
+};
+
+/**
+ * @brief Low-frequency temperature and humidity, and the biomes they imply
+ *
+ * Climate varies over hundreds of blocks, so it is sampled only every
+ * ClimateRegion::CELL blocks, one region of samples at a time, and
+ * bilinearly interpolated per column. Regions are kept in a small LRU;
+ * a chunk costs one cache lookup and a few multiplications per column.
+ *
+ * Each column's biome comes from its interpolated climate. Its height and
+ * water parameters are interpolated from the biomes at the four
+ * surrounding samples instead, so they change gradually across borders.
+ *
+ * Thread-safe like TerrainGenerator: parameters must only be changed
+ * before workers start.
+ */
+class ClimateMap {
+    private:
+    PerlinNoise temperatureNoise;
+    PerlinNoise humidityNoise;
+    float scale; // Noise sampling scale, much smaller than the terrain's
+
+    mutable GridCache<ClimateRegion> regionCache; // Recently sampled regions
+
+    public:
+    static constexpr size_t REGION_CACHE_CAPACITY = 64;
+
+    /**
+     * @brief Construct a climate map
+     * @param seed Random seed; temperature and humidity use seed and seed + 1
+     */
+    explicit ClimateMap(unsigned int seed);
+
+    /**
+     * @brief Change the noise sampling scale, dropping cached regions
+     */
+    void setScale(float s) {
+        scale = s;
+        regionCache.clear();
+    }
+
+    float getScale() const { return scale; }
+
+    /**
+     * @brief Climate of a rectangular block of columns
+     * @param startX World X of the first column
+     * @param startZ World Z of the first column
+     * @param sizeX Columns along X
+     * @param sizeZ Columns along Z
+     * @param out Receives sizeX * sizeZ entries, index x * sizeZ + z
+     */
+    void sampleColumns(int startX, int startZ, int sizeX, int sizeZ, ColumnClimate* out) const;
+
+    GridCacheStats getCacheStats() const { return regionCache.getStats(); }
+
+    private:
+    /**
+     * @brief Region from the cache or freshly sampled
+     */
+    std::shared_ptr<const ClimateRegion> getRegion(int regionX, int regionZ) const;
+
+    std::shared_ptr<const ClimateRegion> computeRegion(int regionX, int regionZ) const;
+};
+
+} // namespace game::generator
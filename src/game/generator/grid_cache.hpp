@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace game::generator {
+
+/**
+ * @brief Hit and miss counters of a GridCache
+ */
+struct GridCacheStats {
+    size_t hits     = 0;
+    size_t misses   = 0;
+    size_t entries  = 0;
+    size_t capacity = 0;
+};
+
+/**
+ * @brief Bounded LRU of immutable values keyed by 2D grid cell (chunk or region)
+ *
+ * Thread-safe: chunk workers look up and insert concurrently. Entries are
+ * shared_ptrs, so evicting one never invalidates a value still held
+ * elsewhere.
+ */
+template <typename T>
+class GridCache {
+    private:
+    using Entry = std::pair<uint64_t, std::shared_ptr<const T>>;
+
+    std::list<Entry> m_entries; // Most recently used first
+    std::unordered_map<uint64_t, typename std::list<Entry>::iterator> m_index;
+    size_t m_capacity;
+    size_t m_hits   = 0;
+    size_t m_misses = 0;
+    mutable std::mutex m_mutex;
+
+    public:
+    explicit GridCache(size_t capacity) : m_capacity(capacity) {}
+
+    /**
+     * @brief Look up a cell and mark it most recently used
+     * @return The value, or nullptr on a miss
+     */
+    std::shared_ptr<const T> find(int cellX, int cellZ) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_index.find(makeKey(cellX, cellZ));
+        if (it == m_index.end()) {
+            m_misses++;
+            return nullptr;
+        }
+
+        m_hits++;
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return it->second->second;
+    }
+
+    /**
+     * @brief Add or replace a cell's value as most recently used, evicting the least recently used entry if full
+     *
+     * Two workers may compute the same cell concurrently; the later insert
+     * simply replaces the earlier, identical value.
+     */
+    void insert(int cellX, int cellZ, std::shared_ptr<const T> value) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_capacity == 0) return;
+
+        uint64_t key = makeKey(cellX, cellZ);
+        auto it      = m_index.find(key);
+        if (it != m_index.end()) {
+            it->second->second = std::move(value);
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            return;
+        }
+
+        m_entries.emplace_front(key, std::move(value));
+        m_index[key] = m_entries.begin();
+        evictToCapacity();
+    }
+
+    /**
+     * @brief Change the capacity; 0 disables caching
+     */
+    void setCapacity(size_t capacity) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_capacity = capacity;
+        evictToCapacity();
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.clear();
+        m_index.clear();
+    }
+
+    GridCacheStats getStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        GridCacheStats stats;
+        stats.hits     = m_hits;
+        stats.misses   = m_misses;
+        stats.entries  = m_entries.size();
+        stats.capacity = m_capacity;
+        return stats;
+    }
+
+    private:
+    static uint64_t makeKey(int cellX, int cellZ) {
+        return static_cast<uint64_t>(static_cast<uint32_t>(cellX)) << 32 | static_cast<uint32_t>(cellZ);
+    }
+
+    // Caller holds m_mutex
+    void evictToCapacity() {
+        while (m_entries.size() > m_capacity) {
+            m_index.erase(m_entries.back().first);
+            m_entries.pop_back();
+        }
+    }
+};
+
+} // namespace game::generator
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "game/generator/biome.hpp"
+#include "game/generator/grid_cache.hpp"
+
+#include <array>
+#include <cstddef>
+
+namespace game::generator {
+
+/**
+ * @brief Surface heights and column metadata of one 16x16 chunk
+ *
+ * Produced once per chunk from noise and then shared read-only: the
+ * generator's cache keeps it for neighbour queries, and the generated
+ * chunk keeps it for culling, so neither samples noise again.
+ */
+struct ChunkHeightmap {
+    static constexpr int SIZE = 16;
+
+    std::array<int, SIZE * SIZE> heights;        // Surface Y per column, index x * SIZE + z
+    std::array<BiomeType, SIZE * SIZE> biomes;   // Biome per column, same index
+    std::array<int, SIZE * SIZE> waterLevels;    // Water surface Y per column, same index
+    int minHeight = 0;                           // Lowest surface Y in the chunk
+    int maxHeight = 0;                           // Highest surface Y in the chunk
+    int maxWaterLevel = 0;                       // Highest water surface Y in the chunk
+    int maxSolidY = -1;                          // Highest Y holding a solid block, -1 if none
+
+    int get(int x, int z) const { return heights[x * SIZE + z]; }
+};
+
+using HeightmapCacheStats = GridCacheStats;
+
+/**
+ * @brief Bounded LRU of recently generated chunk heightmaps, keyed by chunk
+ */
+using HeightmapCache = GridCache<ChunkHeightmap>;
+
+inline constexpr size_t HEIGHTMAP_CACHE_CAPACITY = 1024;
+
+} // namespace game::generator
@@ -1,7 +1,34 @@
 #include "perlin_noise.hpp"
 
+#include <stdexcept>
+#include <string>
+#include <utility>
+
 namespace game::generator {
 
+namespace {
+
+// Octave frequencies 2^i, exactly the values fbm() reaches by doubling
+constexpr auto FBM_FREQUENCIES = [] {
+    std::array<double, MAX_FBM_OCTAVES> frequencies{};
+    double frequency = 1.0;
+    for (double& f : frequencies) {
+        f = frequency;
+        frequency *= 2.0;
+    }
+    return frequencies;
+}();
+
+} // namespace
+
+#if NT_NOISE_HAS_AVX2
+// perlin_noise_avx2.cpp, compiled for AVX2 regardless of the global flags
+void fbmBatchAvx2(const int* perm, const double* xs, const double* ys, double* out, size_t count,
+int octaves, double persistence);
+void fbmBatchAvx2(const int* perm, const double* xs, const double* ys, const double* zs, double* out,
+size_t count, int octaves, double persistence);
+#endif
+
 /**
  * @brief Construct a new Perlin Noise generator
  *
@@ -42,7 +69,7 @@ PerlinNoise::PerlinNoise(unsigned int seed) {
  * @param y Y coordinate in noise space
  * @return Noise value approximately in range [-1, 1]
  */
-double PerlinNoise::noise(double x, double y) {
+double PerlinNoise::noise(double x, double y) const {
     // Find unit grid cell coordinates (wrapped to 0-255)
     int X = (int)floor(x) & 255;
     int Y = (int)floor(y) & 255;
@@ -70,6 +97,47 @@ double PerlinNoise::noise(double x, double y) {
     grad(p[B + 1], x - 1, y - 1)));   // Top-right
 }
 
+/**
+ * @brief Generate 3D Perlin noise value
+ *
+ * Same scheme as the 2D version with a third axis: hash the eight corners
+ * of the unit cube, then interpolate along X, Y and finally Z. The
+ * duplicated permutation table keeps every lookup in range (at most 511).
+ *
+ * @param x X coordinate in noise space
+ * @param y Y coordinate in noise space
+ * @param z Z coordinate in noise space
+ * @return Noise value approximately in range [-1, 1]
+ */
+double PerlinNoise::noise(double x, double y, double z) const {
+    int X = (int)floor(x) & 255;
+    int Y = (int)floor(y) & 255;
+    int Z = (int)floor(z) & 255;
+
+    x -= floor(x);
+    y -= floor(y);
+    z -= floor(z);
+
+    double u = fade(x);
+    double v = fade(y);
+    double w = fade(z);
+
+    int A  = p[X] + Y;
+    int AA = p[A] + Z;
+    int AB = p[A + 1] + Z;
+    int B  = p[X + 1] + Y;
+    int BA = p[B] + Z;
+    int BB = p[B + 1] + Z;
+
+    return lerp(w,
+    lerp(v,
+    lerp(u, grad(p[AA], x, y, z), grad(p[BA], x - 1, y, z)),
+    lerp(u, grad(p[AB], x, y - 1, z), grad(p[BB], x - 1, y - 1, z))),
+    lerp(v,
+    lerp(u, grad(p[AA + 1], x, y, z - 1), grad(p[BA + 1], x - 1, y, z - 1)),
+    lerp(u, grad(p[AB + 1], x, y - 1, z - 1), grad(p[BB + 1], x - 1, y - 1, z - 1))));
+}
+
 /**
  * @brief Generate Fractal Brownian Motion (FBM) noise
  *
@@ -89,7 +157,7 @@ double PerlinNoise::noise(double x, double y) {
  * @param persistence Amplitude decay factor (0.5 = half amplitude per octave)
  * @return Normalized noise value in range approximately [-1, 1]
  */
-double PerlinNoise::fbm(double x, double y, int octaves, double persistence) {
+double PerlinNoise::fbm(double x, double y, int octaves, double persistence) const {
     double total     = 0.0; // Accumulated noise value
     double frequency = 1.0; // Current frequency multiplier
     double amplitude = 1.0; // Current amplitude multiplier
@@ -113,6 +181,183 @@ double PerlinNoise::fbm(double x, double y, int octaves, double persistence) {
     return total / maxValue;
 }
 
+/**
+ * @brief FBM with a compile-time octave count
+ *
+ * The fold expands to one noise() call per octave with constant
+ * frequencies. Octaves accumulate in the same order and with the same
+ * operations as fbm(), and the normalisation divides by the same sum.
+ *
+ * @param x X coordinate in noise space
+ * @param y Y coordinate in noise space
+ * @param weights Amplitudes from makeFbmWeights(Octaves, persistence)
+ * @return Normalized noise value in range approximately [-1, 1]
+ */
+template <int Octaves>
+double PerlinNoise::fbm(double x, double y, const FbmWeights& weights) const {
+    static_assert(Octaves >= 1 && Octaves <= MAX_FBM_OCTAVES, "No fbm kernel for this octave count");
+
+    double total = 0.0;
+    [&]<size_t... I>(std::index_sequence<I...>) {
+        ((total += noise(x * FBM_FREQUENCIES[I], y * FBM_FREQUENCIES[I]) * weights.amplitudes[I]), ...);
+    }(std::make_index_sequence<Octaves>{});
+
+    return total / weights.maxValue;
+}
+
+template double PerlinNoise::fbm<1>(double, double, const FbmWeights&) const;
+template double PerlinNoise::fbm<2>(double, double, const FbmWeights&) const;
+template double PerlinNoise::fbm<3>(double, double, const FbmWeights&) const;
+template double PerlinNoise::fbm<4>(double, double, const FbmWeights&) const;
+template double PerlinNoise::fbm<5>(double, double, const FbmWeights&) const;
+template double PerlinNoise::fbm<6>(double, double, const FbmWeights&) const;
+template double PerlinNoise::fbm<7>(double, double, const FbmWeights&) const;
+template double PerlinNoise::fbm<8>(double, double, const FbmWeights&) const;
+
+/**
+ * @brief Look up the fbm<Octaves>() instantiation for an octave count
+ *
+ * @param octaves Runtime octave count, e.g. from TerrainGenerator::setOctaves()
+ * @return Member pointer to the kernel, or nullptr if none is instantiated
+ */
+PerlinNoise::FbmKernel PerlinNoise::getFbmKernel(int octaves) {
+    static constexpr auto KERNELS = []<size_t... I>(std::index_sequence<I...>) {
+        return std::array<FbmKernel, sizeof...(I)>{ &PerlinNoise::fbm<static_cast<int>(I) + 1>... };
+    }(std::make_index_sequence<MAX_FBM_OCTAVES>{});
+
+    if (octaves < 1 || octaves > MAX_FBM_OCTAVES) return nullptr;
+    return KERNELS[octaves - 1];
+}
+
+/**
+ * @brief Generate 3D Fractal Brownian Motion noise
+ *
+ * Octaves are accumulated exactly as in the 2D fbm().
+ *
+ * @param x X coordinate in noise space
+ * @param y Y coordinate in noise space
+ * @param z Z coordinate in noise space
+ * @param octaves Number of noise layers
+ * @param persistence Amplitude decay factor
+ * @return Normalized noise value in range approximately [-1, 1]
+ */
+double PerlinNoise::fbm(double x, double y, double z, int octaves, double persistence) const {
+    double total     = 0.0;
+    double frequency = 1.0;
+    double amplitude = 1.0;
+    double maxValue  = 0.0;
+
+    for (int i = 0; i < octaves; i++) {
+        total += noise(x * frequency, y * frequency, z * frequency) * amplitude;
+        maxValue += amplitude;
+        amplitude *= persistence;
+        frequency *= 2.0;
+    }
+
+    return total / maxValue;
+}
+
+/**
+ * @brief Evaluate FBM for many points with the best available backend
+ */
+void PerlinNoise::fbmBatch(const double* xs, const double* ys, double* out, size_t count,
+int octaves, double persistence) const {
+    static const NoiseBackend best = getBestBackend();
+    fbmBatch(xs, ys, out, count, octaves, persistence, best);
+}
+
+/**
+ * @brief Evaluate FBM for many points with a specific backend
+ *
+ * The SIMD kernels mirror fbm(), noise(), fade(), lerp() and grad()
+ * operation for operation; they deliberately avoid FMA, which would round
+ * differently from the scalar code.
+ */
+void PerlinNoise::fbmBatch(const double* xs, const double* ys, double* out, size_t count,
+int octaves, double persistence, NoiseBackend backend) const {
+    if (!isBackendSupported(backend)) {
+        throw std::runtime_error(std::string("Noise backend not supported: ") + getBackendName(backend));
+    }
+
+    switch (backend) {
+#if NT_NOISE_HAS_AVX2
+    case NoiseBackend::AVX2:
+        fbmBatchAvx2(p.data(), xs, ys, out, count, octaves, persistence);
+        return;
+#endif
+    default:
+        if (FbmKernel kernel = getFbmKernel(octaves)) {
+            FbmWeights weights = makeFbmWeights(octaves, persistence);
+            for (size_t i = 0; i < count; i++) {
+                out[i] = (this->*kernel)(xs[i], ys[i], weights);
+            }
+            return;
+        }
+        for (size_t i = 0; i < count; i++) {
+            out[i] = fbm(xs[i], ys[i], octaves, persistence);
+        }
+        return;
+    }
+}
+
+/**
+ * @brief Evaluate 3D FBM for many points with the best available backend
+ */
+void PerlinNoise::fbmBatch(const double* xs, const double* ys, const double* zs, double* out, size_t count,
+int octaves, double persistence) const {
+    static const NoiseBackend best = getBestBackend();
+    fbmBatch(xs, ys, zs, out, count, octaves, persistence, best);
+}
+
+/**
+ * @brief Evaluate 3D FBM for many points with a specific backend
+ */
+void PerlinNoise::fbmBatch(const double* xs, const double* ys, const double* zs, double* out, size_t count,
+int octaves, double persistence, NoiseBackend backend) const {
+    if (!isBackendSupported(backend)) {
+        throw std::runtime_error(std::string("Noise backend not supported: ") + getBackendName(backend));
+    }
+
+    switch (backend) {
+#if NT_NOISE_HAS_AVX2
+    case NoiseBackend::AVX2:
+        fbmBatchAvx2(p.data(), xs, ys, zs, out, count, octaves, persistence);
+        return;
+#endif
+    default:
+        for (size_t i = 0; i < count; i++) {
+            out[i] = fbm(xs[i], ys[i], zs[i], octaves, persistence);
+        }
+        return;
+    }
+}
+
+NoiseBackend PerlinNoise::getBestBackend() {
+    return isBackendSupported(NoiseBackend::AVX2) ? NoiseBackend::AVX2 : NoiseBackend::SCALAR;
+}
+
+bool PerlinNoise::isBackendSupported(NoiseBackend backend) {
+    switch (backend) {
+    case NoiseBackend::SCALAR:
+        return true;
+    case NoiseBackend::AVX2:
+#if NT_NOISE_HAS_AVX2
+        return __builtin_cpu_supports("avx2");
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+const char* PerlinNoise::getBackendName(NoiseBackend backend) {
+    switch (backend) {
+    case NoiseBackend::SCALAR: return "scalar";
+    case NoiseBackend::AVX2: return "avx2";
+    }
+    return "unknown";
+}
+
 /**
  * @brief Fade function using improved Perlin smoothstep
  *
@@ -123,7 +368,7 @@ double PerlinNoise::fbm(double x, double y, int octaves, double persistence) {
  * @param t Input value in range [0, 1]
  * @return Smoothed value in range [0, 1] with zero derivatives at endpoints
  */
-double PerlinNoise::fade(double t) {
+double PerlinNoise::fade(double t) const {
     return t * t * t * (t * (t * 6 - 15) + 10);
 }
 
@@ -135,7 +380,7 @@ double PerlinNoise::fade(double t) {
  * @param b End value
  * @return Value between a and b
  */
-double PerlinNoise::lerp(double t, double a, double b) {
+double PerlinNoise::lerp(double t, double a, double b) const {
     return a + t * (b - a);
 }
 
@@ -155,7 +400,7 @@ double PerlinNoise::lerp(double t, double a, double b) {
  * @param y Y distance from grid point
  * @return Gradient dot product contribution
  */
-double PerlinNoise::grad(int hash, double x, double y) {
+double PerlinNoise::grad(int hash, double x, double y) const {
     // Use bottom 4 bits to select from 16 gradient directions
     int h = hash & 15;
 
@@ -167,4 +412,22 @@ double PerlinNoise::grad(int hash, double x, double y) {
     return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
 }
 
+/**
+ * @brief Calculate 3D gradient contribution at grid point
+ *
+ * Improved Perlin noise gradient set (GRADIENTS_3D). A table lookup rather
+ * than the classic chain of conditionals, so the data-dependent hash never
+ * drives a branch.
+ *
+ * @param hash Hash value (from permutation table)
+ * @param x X distance from grid point
+ * @param y Y distance from grid point
+ * @param z Z distance from grid point
+ * @return Gradient dot product contribution
+ */
+double PerlinNoise::grad(int hash, double x, double y, double z) const {
+    const double* g = GRADIENTS_3D[hash & 15];
+    return g[0] * x + g[1] * y + g[2] * z;
+}
+
 } // namespace game::generator
\ No newline at end of file
@@ -1,12 +1,73 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
 #include <random>
 #include <vector>
 
+// The AVX2 backend needs x86 and GCC/Clang target attributes; other builds use the scalar path
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define NT_NOISE_HAS_AVX2 1
+#else
+#define NT_NOISE_HAS_AVX2 0
+#endif
+
 namespace game::generator {
 
+/**
+ * @brief Instruction set used by PerlinNoise::fbmBatch
+ */
+enum class NoiseBackend {
+    SCALAR, // One sample at a time through fbm()
+    AVX2    // Four double lanes, x86-64 CPUs with AVX2
+};
+
+/**
+ * @brief Gradient vectors of 3D improved Perlin noise, selected by hash & 15
+ *
+ * The 12 cube-edge directions, with (1,1,0), (0,-1,1), (-1,1,0) and
+ * (0,-1,-1) repeated to fill 16 slots. Shared by the scalar and SIMD paths.
+ */
+inline constexpr double GRADIENTS_3D[16][3] = {
+    { 1, 1, 0 }, { -1, 1, 0 }, { 1, -1, 0 }, { -1, -1, 0 },
+    { 1, 0, 1 }, { -1, 0, 1 }, { 1, 0, -1 }, { -1, 0, -1 },
+    { 0, 1, 1 }, { 0, -1, 1 }, { 0, 1, -1 }, { 0, -1, -1 },
+    { 1, 1, 0 }, { 0, -1, 1 }, { -1, 1, 0 }, { 0, -1, -1 }
+};
+
+/**
+ * @brief Largest octave count with a compile-time specialised fbm kernel
+ */
+inline constexpr int MAX_FBM_OCTAVES = 8;
+
+/**
+ * @brief Octave amplitudes and their sum for one octaves/persistence pair
+ *
+ * Built by the same multiply-and-add sequence as the loop in
+ * PerlinNoise::fbm(), so the specialised kernels reproduce its results
+ * exactly. Computed at compile time when persistence is a constant.
+ */
+struct FbmWeights {
+    std::array<double, MAX_FBM_OCTAVES> amplitudes{};
+    double maxValue = 0.0; // Sum of all amplitudes (for normalization)
+};
+
+/**
+ * @brief Amplitude table for up to MAX_FBM_OCTAVES octaves
+ */
+constexpr FbmWeights makeFbmWeights(int octaves, double persistence) {
+    FbmWeights weights;
+    double amplitude = 1.0;
+    for (int i = 0; i < octaves && i < MAX_FBM_OCTAVES; i++) {
+        weights.amplitudes[i] = amplitude;
+        weights.maxValue += amplitude;
+        amplitude *= persistence;
+    }
+    return weights;
+}
+
 /**
  * @brief Perlin noise generator for procedural terrain generation
  *
@@ -38,7 +99,20 @@ class PerlinNoise {
      * @param y Y coordinate in noise space
      * @return Noise value in range [-1, 1]
      */
-    double noise(double x, double y);
+    double noise(double x, double y) const;
+
+    /**
+     * @brief Generate 3D Perlin noise value
+     *
+     * Ken Perlin's improved noise in three dimensions, trilinearly
+     * interpolating the gradients at the eight corners of the unit cube.
+     *
+     * @param x X coordinate in noise space
+     * @param y Y coordinate in noise space
+     * @param z Z coordinate in noise space
+     * @return Noise value in range [-1, 1]
+     */
+    double noise(double x, double y, double z) const;
 
     /**
      * @brief Generate Fractal Brownian Motion (FBM) noise
@@ -53,7 +127,94 @@ class PerlinNoise {
      * @param persistence Amplitude multiplier per octave (controls roughness)
      * @return Normalized noise value in range [-1, 1]
      */
-    double fbm(double x, double y, int octaves = 4, double persistence = 0.5);
+    double fbm(double x, double y, int octaves = 4, double persistence = 0.5) const;
+
+    /**
+     * @brief FBM with the octave count fixed at compile time
+     *
+     * The octave loop is fully unrolled, frequencies come from a constant
+     * table and the amplitudes and their sum from precomputed weights.
+     * Equals fbm(x, y, Octaves, persistence) bitwise when weights is
+     * makeFbmWeights(Octaves, persistence). Instantiated for 1 to
+     * MAX_FBM_OCTAVES octaves.
+     *
+     * @param x X coordinate in noise space
+     * @param y Y coordinate in noise space
+     * @param weights Amplitudes for Octaves octaves
+     * @return Normalized noise value in range [-1, 1]
+     */
+    template <int Octaves>
+    double fbm(double x, double y, const FbmWeights& weights) const;
+
+    /**
+     * @brief One fbm<Octaves>() specialisation, chosen at runtime
+     */
+    using FbmKernel = double (PerlinNoise::*)(double x, double y, const FbmWeights& weights) const;
+
+    /**
+     * @brief Map a runtime octave count onto its specialised kernel
+     * @return The kernel, or nullptr outside 1..MAX_FBM_OCTAVES (use fbm() then)
+     */
+    static FbmKernel getFbmKernel(int octaves);
+
+    /**
+     * @brief Generate 3D Fractal Brownian Motion noise, e.g. terrain density
+     *
+     * @param x X coordinate in noise space
+     * @param y Y coordinate in noise space
+     * @param z Z coordinate in noise space
+     * @param octaves Number of noise layers to combine
+     * @param persistence Amplitude multiplier per octave
+     * @return Normalized noise value in range [-1, 1]
+     */
+    double fbm(double x, double y, double z, int octaves, double persistence) const;
+
+    /**
+     * @brief Evaluate fbm() for many points at once
+     *
+     * Uses the fastest backend the CPU supports, detected once at runtime.
+     * Every backend works in double precision and performs the same
+     * operations in the same order as fbm(), so results are bitwise
+     * identical to calling fbm() per point.
+     *
+     * @param xs X coordinates, count entries
+     * @param ys Y coordinates, count entries
+     * @param out Receives count noise values
+     * @param count Number of points
+     * @param octaves Number of noise layers to combine
+     * @param persistence Amplitude multiplier per octave
+     */
+    void fbmBatch(const double* xs, const double* ys, double* out, size_t count,
+    int octaves = 4, double persistence = 0.5) const;
+
+    /**
+     * @brief fbmBatch() with an explicit backend; it must be supported
+     */
+    void fbmBatch(const double* xs, const double* ys, double* out, size_t count,
+    int octaves, double persistence, NoiseBackend backend) const;
+
+    /**
+     * @brief Evaluate the 3D fbm() for many points at once
+     *
+     * Same backend selection and bitwise guarantee as the 2D fbmBatch().
+     */
+    void fbmBatch(const double* xs, const double* ys, const double* zs, double* out, size_t count,
+    int octaves = 4, double persistence = 0.5) const;
+
+    /**
+     * @brief 3D fbmBatch() with an explicit backend; it must be supported
+     */
+    void fbmBatch(const double* xs, const double* ys, const double* zs, double* out, size_t count,
+    int octaves, double persistence, NoiseBackend backend) const;
+
+    /**
+     * @brief Fastest backend available on this CPU
+     */
+    static NoiseBackend getBestBackend();
+
+    static bool isBackendSupported(NoiseBackend backend);
+
+    static const char* getBackendName(NoiseBackend backend);
 
     private:
     /**
@@ -65,7 +226,7 @@ class PerlinNoise {
      * @param t Input value in range [0, 1]
      * @return Smoothed value in range [0, 1]
      */
-    double fade(double t);
+    double fade(double t) const;
 
     /**
      * @brief Linear interpolation between two values
@@ -74,7 +235,7 @@ class PerlinNoise {
      * @param b End value
      * @return Interpolated value
      */
-    double lerp(double t, double a, double b);
+    double lerp(double t, double a, double b) const;
 
     /**
      * @brief Calculate gradient at grid point
@@ -87,7 +248,21 @@ class PerlinNoise {
      * @param y Y distance from grid point
      * @return Gradient contribution
      */
-    double grad(int hash, double x, double y);
+    double grad(int hash, double x, double y) const;
+
+    /**
+     * @brief Calculate 3D gradient at grid point
+     *
+     * Looks up one of GRADIENTS_3D and returns its dot product with the
+     * distance vector.
+     *
+     * @param hash Hash value determining gradient direction
+     * @param x X distance from grid point
+     * @param y Y distance from grid point
+     * @param z Z distance from grid point
+     * @return Gradient contribution
+     */
+    double grad(int hash, double x, double y, double z) const;
 };
 
 } // namespace game::generator
\ No newline at end of file
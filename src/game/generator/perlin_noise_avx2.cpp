@@ -0,0 +1,298 @@
+#include "perlin_noise.hpp"
+
+#if NT_NOISE_HAS_AVX2
+
+// Only the functions in this file are compiled for AVX2; callers check
+// __builtin_cpu_supports("avx2") first. FMA is intentionally not enabled:
+// fused multiply-adds round differently from the scalar fbm().
+#pragma GCC push_options
+#pragma GCC target("avx2")
+
+#include <array>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace game::generator {
+
+namespace {
+
+/**
+ * @brief Widen four 32-bit lane masks to four 64-bit double lane masks
+ */
+inline __m256d widenMask(__m128i mask) {
+    return _mm256_castsi256_pd(_mm256_cvtepi32_epi64(mask));
+}
+
+/**
+ * @brief PerlinNoise::fade() for four lanes, same evaluation order
+ */
+inline __m256d fade(__m256d t) {
+    __m256d inner = _mm256_add_pd(
+    _mm256_mul_pd(t, _mm256_sub_pd(_mm256_mul_pd(t, _mm256_set1_pd(6.0)), _mm256_set1_pd(15.0))),
+    _mm256_set1_pd(10.0));
+    return _mm256_mul_pd(_mm256_mul_pd(_mm256_mul_pd(t, t), t), inner);
+}
+
+/**
+ * @brief PerlinNoise::lerp() for four lanes
+ */
+inline __m256d lerp(__m256d t, __m256d a, __m256d b) {
+    return _mm256_add_pd(a, _mm256_mul_pd(t, _mm256_sub_pd(b, a)));
+}
+
+/**
+ * @brief PerlinNoise::grad() for four lanes
+ *
+ * Branches become blends; negation flips the sign bit exactly like unary
+ * minus, so even signed zeros match the scalar result.
+ */
+inline __m256d grad(__m128i hash, __m256d x, __m256d y) {
+    __m128i h = _mm_and_si128(hash, _mm_set1_epi32(15));
+
+    __m256d below8 = widenMask(_mm_cmplt_epi32(h, _mm_set1_epi32(8)));
+    __m256d below4 = widenMask(_mm_cmplt_epi32(h, _mm_set1_epi32(4)));
+    __m256d useX   = widenMask(_mm_or_si128(
+    _mm_cmpeq_epi32(h, _mm_set1_epi32(12)), _mm_cmpeq_epi32(h, _mm_set1_epi32(14))));
+
+    __m256d u = _mm256_blendv_pd(y, x, below8);
+    __m256d v = _mm256_blendv_pd(_mm256_blendv_pd(_mm256_setzero_pd(), x, useX), y, below4);
+
+    __m256d signBit = _mm256_set1_pd(-0.0);
+    __m256d flipU   = widenMask(_mm_cmpeq_epi32(_mm_and_si128(h, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+    __m256d flipV   = widenMask(_mm_cmpeq_epi32(_mm_and_si128(h, _mm_set1_epi32(2)), _mm_set1_epi32(2)));
+
+    u = _mm256_xor_pd(u, _mm256_and_pd(flipU, signBit));
+    v = _mm256_xor_pd(v, _mm256_and_pd(flipV, signBit));
+    return _mm256_add_pd(u, v);
+}
+
+/**
+ * @brief PerlinNoise::noise() for four lanes; permutation lookups are gathers
+ */
+inline __m256d noise(const int* perm, __m256d x, __m256d y) {
+    __m256d floorX = _mm256_floor_pd(x);
+    __m256d floorY = _mm256_floor_pd(y);
+
+    __m128i byteMask = _mm_set1_epi32(255);
+    __m128i one      = _mm_set1_epi32(1);
+    __m128i X        = _mm_and_si128(_mm256_cvttpd_epi32(floorX), byteMask);
+    __m128i Y        = _mm_and_si128(_mm256_cvttpd_epi32(floorY), byteMask);
+
+    x = _mm256_sub_pd(x, floorX);
+    y = _mm256_sub_pd(y, floorY);
+
+    __m256d u = fade(x);
+    __m256d v = fade(y);
+
+    __m128i A = _mm_add_epi32(_mm_i32gather_epi32(perm, X, 4), Y);
+    __m128i B = _mm_add_epi32(_mm_i32gather_epi32(perm, _mm_add_epi32(X, one), 4), Y);
+
+    __m128i hashAA = _mm_i32gather_epi32(perm, A, 4);
+    __m128i hashBA = _mm_i32gather_epi32(perm, B, 4);
+    __m128i hashAB = _mm_i32gather_epi32(perm, _mm_add_epi32(A, one), 4);
+    __m128i hashBB = _mm_i32gather_epi32(perm, _mm_add_epi32(B, one), 4);
+
+    __m256d oneD = _mm256_set1_pd(1.0);
+    __m256d x1   = _mm256_sub_pd(x, oneD);
+    __m256d y1   = _mm256_sub_pd(y, oneD);
+
+    return lerp(v,
+    lerp(u, grad(hashAA, x, y), grad(hashBA, x1, y)),
+    lerp(u, grad(hashAB, x, y1), grad(hashBB, x1, y1)));
+}
+
+/**
+ * @brief One component of GRADIENTS_3D as 16 signed bytes, for pshufb lookups
+ */
+constexpr std::array<int8_t, 16> gradientColumn(int axis) {
+    std::array<int8_t, 16> column{};
+    for (int h = 0; h < 16; h++) column[h] = static_cast<int8_t>(GRADIENTS_3D[h][axis]);
+    return column;
+}
+
+constexpr std::array<int8_t, 16> GRADIENT_X = gradientColumn(0);
+constexpr std::array<int8_t, 16> GRADIENT_Y = gradientColumn(1);
+constexpr std::array<int8_t, 16> GRADIENT_Z = gradientColumn(2);
+
+/**
+ * @brief Look up a gradient component per lane and widen it to double
+ *
+ * pshufb indexes the table with the low byte of each 32-bit lane; the
+ * shifts keep that byte and sign-extend it to the whole lane.
+ */
+inline __m256d gradientComponent(const std::array<int8_t, 16>& column, __m128i h) {
+    __m128i bytes = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(column.data())), h);
+    return _mm256_cvtepi32_pd(_mm_srai_epi32(_mm_slli_epi32(bytes, 24), 24));
+}
+
+/**
+ * @brief 3D PerlinNoise::grad() for four lanes
+ *
+ * Same table and dot product order as the scalar code,
+ * (gx * x + gy * y) + gz * z, so results are bitwise identical.
+ */
+inline __m256d grad(__m128i hash, __m256d x, __m256d y, __m256d z) {
+    __m128i h = _mm_and_si128(hash, _mm_set1_epi32(15));
+
+    __m256d gx = gradientComponent(GRADIENT_X, h);
+    __m256d gy = gradientComponent(GRADIENT_Y, h);
+    __m256d gz = gradientComponent(GRADIENT_Z, h);
+
+    return _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(gx, x), _mm256_mul_pd(gy, y)), _mm256_mul_pd(gz, z));
+}
+
+/**
+ * @brief 3D PerlinNoise::noise() for four lanes
+ */
+inline __m256d noise(const int* perm, __m256d x, __m256d y, __m256d z) {
+    __m256d floorX = _mm256_floor_pd(x);
+    __m256d floorY = _mm256_floor_pd(y);
+    __m256d floorZ = _mm256_floor_pd(z);
+
+    __m128i byteMask = _mm_set1_epi32(255);
+    __m128i one      = _mm_set1_epi32(1);
+    __m128i X        = _mm_and_si128(_mm256_cvttpd_epi32(floorX), byteMask);
+    __m128i Y        = _mm_and_si128(_mm256_cvttpd_epi32(floorY), byteMask);
+    __m128i Z        = _mm_and_si128(_mm256_cvttpd_epi32(floorZ), byteMask);
+
+    x = _mm256_sub_pd(x, floorX);
+    y = _mm256_sub_pd(y, floorY);
+    z = _mm256_sub_pd(z, floorZ);
+
+    __m256d u = fade(x);
+    __m256d v = fade(y);
+    __m256d w = fade(z);
+
+    __m128i A  = _mm_add_epi32(_mm_i32gather_epi32(perm, X, 4), Y);
+    __m128i AA = _mm_add_epi32(_mm_i32gather_epi32(perm, A, 4), Z);
+    __m128i AB = _mm_add_epi32(_mm_i32gather_epi32(perm, _mm_add_epi32(A, one), 4), Z);
+    __m128i B  = _mm_add_epi32(_mm_i32gather_epi32(perm, _mm_add_epi32(X, one), 4), Y);
+    __m128i BA = _mm_add_epi32(_mm_i32gather_epi32(perm, B, 4), Z);
+    __m128i BB = _mm_add_epi32(_mm_i32gather_epi32(perm, _mm_add_epi32(B, one), 4), Z);
+
+    __m256d oneD = _mm256_set1_pd(1.0);
+    __m256d x1   = _mm256_sub_pd(x, oneD);
+    __m256d y1   = _mm256_sub_pd(y, oneD);
+    __m256d z1   = _mm256_sub_pd(z, oneD);
+
+    auto hash = [&](__m128i index) { return _mm_i32gather_epi32(perm, index, 4); };
+
+    return lerp(w,
+    lerp(v,
+    lerp(u, grad(hash(AA), x, y, z), grad(hash(BA), x1, y, z)),
+    lerp(u, grad(hash(AB), x, y1, z), grad(hash(BB), x1, y1, z))),
+    lerp(v,
+    lerp(u, grad(hash(_mm_add_epi32(AA, one)), x, y, z1), grad(hash(_mm_add_epi32(BA, one)), x1, y, z1)),
+    lerp(u, grad(hash(_mm_add_epi32(AB, one)), x, y1, z1), grad(hash(_mm_add_epi32(BB, one)), x1, y1, z1))));
+}
+
+} // namespace
+
+/**
+ * @brief PerlinNoise::fbm() over four points per iteration
+ *
+ * Frequency, amplitude and normalisation are shared by all lanes and are
+ * accumulated as scalars in the same order as fbm(). A tail of fewer than
+ * four points is padded by repeating the last point.
+ */
+void fbmBatchAvx2(const int* perm, const double* xs, const double* ys, double* out, size_t count,
+int octaves, double persistence) {
+    for (size_t i = 0; i < count; i += 4) {
+        __m256d x, y;
+        size_t lanes = count - i < 4 ? count - i : 4;
+        if (lanes == 4) {
+            x = _mm256_loadu_pd(xs + i);
+            y = _mm256_loadu_pd(ys + i);
+        } else {
+            alignas(32) double tx[4], ty[4];
+            for (size_t l = 0; l < 4; l++) {
+                tx[l] = xs[i + (l < lanes ? l : lanes - 1)];
+                ty[l] = ys[i + (l < lanes ? l : lanes - 1)];
+            }
+            x = _mm256_load_pd(tx);
+            y = _mm256_load_pd(ty);
+        }
+
+        __m256d total    = _mm256_setzero_pd();
+        double frequency = 1.0;
+        double amplitude = 1.0;
+        double maxValue  = 0.0;
+
+        for (int o = 0; o < octaves; o++) {
+            __m256d f = _mm256_set1_pd(frequency);
+            __m256d n = noise(perm, _mm256_mul_pd(x, f), _mm256_mul_pd(y, f));
+            total     = _mm256_add_pd(total, _mm256_mul_pd(n, _mm256_set1_pd(amplitude)));
+
+            maxValue += amplitude;
+            amplitude *= persistence;
+            frequency *= 2.0;
+        }
+
+        __m256d result = _mm256_div_pd(total, _mm256_set1_pd(maxValue));
+        if (lanes == 4) {
+            _mm256_storeu_pd(out + i, result);
+        } else {
+            alignas(32) double tmp[4];
+            _mm256_store_pd(tmp, result);
+            for (size_t l = 0; l < lanes; l++) out[i + l] = tmp[l];
+        }
+    }
+}
+
+/**
+ * @brief 3D PerlinNoise::fbm() over four points per iteration
+ *
+ * Same structure and tail handling as the 2D kernel.
+ */
+void fbmBatchAvx2(const int* perm, const double* xs, const double* ys, const double* zs, double* out,
+size_t count, int octaves, double persistence) {
+    for (size_t i = 0; i < count; i += 4) {
+        __m256d x, y, z;
+        size_t lanes = count - i < 4 ? count - i : 4;
+        if (lanes == 4) {
+            x = _mm256_loadu_pd(xs + i);
+            y = _mm256_loadu_pd(ys + i);
+            z = _mm256_loadu_pd(zs + i);
+        } else {
+            alignas(32) double tx[4], ty[4], tz[4];
+            for (size_t l = 0; l < 4; l++) {
+                tx[l] = xs[i + (l < lanes ? l : lanes - 1)];
+                ty[l] = ys[i + (l < lanes ? l : lanes - 1)];
+                tz[l] = zs[i + (l < lanes ? l : lanes - 1)];
+            }
+            x = _mm256_load_pd(tx);
+            y = _mm256_load_pd(ty);
+            z = _mm256_load_pd(tz);
+        }
+
+        __m256d total    = _mm256_setzero_pd();
+        double frequency = 1.0;
+        double amplitude = 1.0;
+        double maxValue  = 0.0;
+
+        for (int o = 0; o < octaves; o++) {
+            __m256d f = _mm256_set1_pd(frequency);
+            __m256d n = noise(perm, _mm256_mul_pd(x, f), _mm256_mul_pd(y, f), _mm256_mul_pd(z, f));
+            total     = _mm256_add_pd(total, _mm256_mul_pd(n, _mm256_set1_pd(amplitude)));
+
+            maxValue += amplitude;
+            amplitude *= persistence;
+            frequency *= 2.0;
+        }
+
+        __m256d result = _mm256_div_pd(total, _mm256_set1_pd(maxValue));
+        if (lanes == 4) {
+            _mm256_storeu_pd(out + i, result);
+        } else {
+            alignas(32) double tmp[4];
+            _mm256_store_pd(tmp, result);
+            for (size_t l = 0; l < lanes; l++) out[i + l] = tmp[l];
+        }
+    }
+}
+
+} // namespace game::generator
+
+#pragma GCC pop_options
+
+#endif
@@ -1,7 +1,26 @@
 #include "terrain_generator.hpp"
 
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <vector>
+
 namespace game::generator {
 
+namespace {
+
+/**
+ * @brief Surface height of a column from its noise value and climate
+ *
+ * The one formula getTerrainHeight() and getTerrainHeights() share, so
+ * both round identically.
+ */
+int biomeHeight(int baseHeight, int maxHeight, double noiseValue, const ColumnClimate& climate) {
+    return baseHeight + static_cast<int>(noiseValue * (maxHeight * climate.heightScale) + climate.heightOffset);
+}
+
+} // namespace
+
 /**
  * @brief Construct terrain generator with default parameters
  *
@@ -12,6 +31,11 @@ namespace game::generator {
  * - Base height 32: Mid-range elevation
  * - Max variation ±32: Height range [0, 64]
  * - Water level 28: Slightly below base height for lakes/rivers
+ * - Heightmap mode; density mode uses 2 octaves at scale 0.03 (a third,
+ *   8-block wavelength would alias on the 4-block lattice), surfaces
+ *   moving up to 8 blocks and caves down to 24 blocks below the surface
+ * - Biomes disabled; when enabled, the climate noise uses seeds
+ *   seed + 3 and seed + 4
  *
  * @param seed Random seed for reproducible worlds
  */
@@ -22,7 +46,20 @@ TerrainGenerator::TerrainGenerator(unsigned int seed)
   persistence(0.5f),
   baseHeight(32),
   maxHeight(32),
-  waterLevel(28) {}
+  waterLevel(28),
+  mode(TerrainMode::HEIGHTMAP),
+  densityNoise(seed + 1),
+  caveNoise(seed + 2),
+  densityScale(0.03f),
+  densityOctaves(2),
+  overhangDepth(8),
+  caveThreshold(0.35f),
+  caveDepth(24),
+  biomes(false),
+  climate(seed + 3),
+  heightmapCache(HEIGHTMAP_CACHE_CAPACITY) {
+    selectFbmKernel();
+}
 
 /**
  * @brief Calculate terrain surface height at given coordinates
@@ -37,13 +74,23 @@ TerrainGenerator::TerrainGenerator(unsigned int seed)
  * - Noise returns 0.0 → height = 32 + (0.0 * 32) = 32
  * - Noise returns 1.0 → height = 32 + (1.0 * 32) = 64
  *
+ * With biomes enabled the column's blended height offset is added and
+ * maxHeight is scaled by its blended height scale.
+ *
  * @param x World X coordinate
  * @param z World Z coordinate
  * @return Terrain surface Y coordinate
  */
-int TerrainGenerator::getTerrainHeight(int x, int z) {
-    // Generate FBM noise value in range [-1, 1]
-    double noiseValue = noise.fbm(x * scale, z * scale, octaves, persistence);
+int TerrainGenerator::getTerrainHeight(int x, int z) const {
+    // Generate FBM noise value in range [-1, 1], unrolled for the configured octave count if possible
+    double noiseValue = fbmKernel ? (noise.*fbmKernel)(x * scale, z * scale, fbmWeights)
+                                  : noise.fbm(x * scale, z * scale, octaves, persistence);
+
+    if (biomes) {
+        ColumnClimate columnClimate;
+        climate.sampleColumns(x, z, 1, 1, &columnClimate);
+        return biomeHeight(baseHeight, maxHeight, noiseValue, columnClimate);
+    }
 
     // Map to height range and add to baseline
     int height = baseHeight + static_cast<int>(noiseValue * maxHeight);
@@ -51,6 +98,156 @@ int TerrainGenerator::getTerrainHeight(int x, int z) {
     return height;
 }
 
+/**
+ * @brief Calculate terrain heights for a block of columns
+ *
+ * Sample coordinates are computed exactly as in getTerrainHeight()
+ * (int times float scale, then widened to double), so the batched noise
+ * sees the same inputs and yields the same integer heights.
+ * Climate comes from the same cached regions as well.
+ *
+ * @param startX World X of the first column
+ * @param startZ World Z of the first column
+ * @param sizeX Number of columns along X
+ * @param sizeZ Number of columns along Z
+ * @param heights Output, sizeX * sizeZ entries indexed x * sizeZ + z
+ * @param climates Optional output, climate per column with the same index;
+ *                 the neutral ColumnClimate while biomes are disabled
+ */
+void TerrainGenerator::getTerrainHeights(int startX, int startZ, int sizeX, int sizeZ, int* heights, ColumnClimate* climates) const {
+    size_t count = static_cast<size_t>(sizeX) * sizeZ;
+
+    std::vector<double> xs(count), zs(count), values(count);
+    for (int x = 0; x < sizeX; x++) {
+        for (int z = 0; z < sizeZ; z++) {
+            xs[x * sizeZ + z] = (startX + x) * scale;
+            zs[x * sizeZ + z] = (startZ + z) * scale;
+        }
+    }
+
+    noise.fbmBatch(xs.data(), zs.data(), values.data(), count, octaves, persistence);
+
+    if (!biomes) {
+        for (size_t i = 0; i < count; i++) {
+            heights[i] = baseHeight + static_cast<int>(values[i] * maxHeight);
+        }
+        if (climates) std::fill(climates, climates + count, ColumnClimate{});
+        return;
+    }
+
+    std::vector<ColumnClimate> local;
+    if (!climates) {
+        local.resize(count);
+        climates = local.data();
+    }
+    climate.sampleColumns(startX, startZ, sizeX, sizeZ, climates);
+
+    for (size_t i = 0; i < count; i++) {
+        heights[i] = biomeHeight(baseHeight, maxHeight, values[i], climates[i]);
+    }
+}
+
+/**
+ * @brief Chunk heightmap through the LRU cache
+ *
+ * On a miss the heightmap is sampled outside the cache lock, so workers
+ * generating different chunks never wait on each other's noise.
+ *
+ * @param chunkX Chunk X index
+ * @param chunkZ Chunk Z index
+ * @return Shared heightmap for the chunk
+ */
+std::shared_ptr<const ChunkHeightmap> TerrainGenerator::getHeightmap(int chunkX, int chunkZ) const {
+    if (auto cached = heightmapCache.find(chunkX, chunkZ)) {
+        return cached;
+    }
+
+    auto heightmap = computeHeightmap(chunkX, chunkZ);
+    heightmapCache.insert(chunkX, chunkZ, heightmap);
+    return heightmap;
+}
+
+/**
+ * @brief Heightmap of the chunk containing a world column
+ *
+ * @param x World X coordinate
+ * @param z World Z coordinate
+ * @param index Receives the column's index within the heightmap
+ * @return Shared heightmap for the chunk
+ */
+std::shared_ptr<const ChunkHeightmap> TerrainGenerator::getColumnHeightmap(int x, int z, int& index) const {
+    constexpr int SIZE = ChunkHeightmap::SIZE;
+
+    // floor division, so negative coordinates map to the chunk that contains them
+    int chunkX = x >= 0 ? x / SIZE : (x + 1) / SIZE - 1;
+    int chunkZ = z >= 0 ? z / SIZE : (z + 1) / SIZE - 1;
+
+    index = (x - chunkX * SIZE) * SIZE + (z - chunkZ * SIZE);
+    return getHeightmap(chunkX, chunkZ);
+}
+
+/**
+ * @brief Surface height of a world column via its chunk's heightmap
+ *
+ * @param x World X coordinate
+ * @param z World Z coordinate
+ * @return Terrain surface Y coordinate
+ */
+int TerrainGenerator::getColumnHeight(int x, int z) const {
+    int index;
+    return getColumnHeightmap(x, z, index)->heights[index];
+}
+
+/**
+ * @brief Biome of a world column via its chunk's heightmap
+ *
+ * @param x World X coordinate
+ * @param z World Z coordinate
+ * @return Biome of the column
+ */
+BiomeType TerrainGenerator::getColumnBiome(int x, int z) const {
+    int index;
+    return getColumnHeightmap(x, z, index)->biomes[index];
+}
+
+/**
+ * @brief Sample one chunk's surface heights and derive column metadata
+ *
+ * The surface block of every column is solid (grass, sand or stone) and
+ * only water lies above it, so the highest solid block is the highest
+ * surface clamped to the world. Density terrain can rise at most
+ * overhangDepth blocks above the surface, which bounds it instead.
+ * Each column's biome and water level are recorded alongside its height.
+ *
+ * @param chunkX Chunk X index
+ * @param chunkZ Chunk Z index
+ * @return Newly computed heightmap
+ */
+std::shared_ptr<const ChunkHeightmap> TerrainGenerator::computeHeightmap(int chunkX, int chunkZ) const {
+    constexpr int SIZE    = ChunkHeightmap::SIZE;
+    constexpr int WORLD_Y = chuck::VoxelChunk::SECTION_SIZE * chuck::VoxelChunk::SECTION_COUNT;
+
+    auto heightmap = std::make_shared<ChunkHeightmap>();
+    std::array<ColumnClimate, SIZE * SIZE> climates;
+    getTerrainHeights(chunkX * SIZE, chunkZ * SIZE, SIZE, SIZE, heightmap->heights.data(), climates.data());
+
+    heightmap->maxWaterLevel = waterLevel + climates[0].waterOffset;
+    for (int i = 0; i < SIZE * SIZE; i++) {
+        heightmap->biomes[i]      = climates[i].biome;
+        heightmap->waterLevels[i] = waterLevel + climates[i].waterOffset;
+        heightmap->maxWaterLevel  = std::max(heightmap->maxWaterLevel, heightmap->waterLevels[i]);
+    }
+
+    auto [lowest, highest] = std::minmax_element(heightmap->heights.begin(), heightmap->heights.end());
+    heightmap->minHeight   = *lowest;
+    heightmap->maxHeight   = *highest;
+
+    int top              = *highest + (mode == TerrainMode::DENSITY ? overhangDepth : 0);
+    heightmap->maxSolidY = top < 0 ? -1 : std::min(top, WORLD_Y - 1);
+
+    return heightmap;
+}
+
 /**
  * @brief Generate all blocks for a chunk
  *
@@ -74,7 +271,7 @@ int TerrainGenerator::getTerrainHeight(int x, int z) {
 std::vector<TerrainBlock> TerrainGenerator::generateChunk(
 int chunkX,
 int chunkZ,
-int chunkSize) {
+int chunkSize) const {
 
     std::vector<TerrainBlock> blocks;
 
@@ -82,18 +279,58 @@ int chunkSize) {
     int startX = chunkX * chunkSize;
     int startZ = chunkZ * chunkSize;
 
+    // Density terrain is only generated as voxels; read the blocks back
+    if (mode == TerrainMode::DENSITY) {
+        if (chunkSize != ChunkHeightmap::SIZE) {
+            throw std::invalid_argument("Density terrain requires 16x16 chunks");
+        }
+
+        chuck::VoxelChunk chunk;
+        generateChunk(chunkX, chunkZ, chunk);
+        for (int x = 0; x < chunkSize; x++)
+            for (int z = 0; z < chunkSize; z++)
+                for (int y = 0; y < chunk.getSizeY(); y++)
+                    if (uint32_t id = chunk.getBlock(x, y, z); id != ::game::blocks::BlockIDs::AIR)
+                        blocks.emplace_back(glm::ivec3(startX + x, y, startZ + z), id);
+        return blocks;
+    }
+
+    // Standard chunks share the cached heightmap; other sizes sample their own batch
+    std::shared_ptr<const ChunkHeightmap> heightmap;
+    std::vector<int> heights;
+    std::vector<ColumnClimate> climates;
+    if (chunkSize == ChunkHeightmap::SIZE) {
+        heightmap = getHeightmap(chunkX, chunkZ);
+    } else {
+        heights.resize(chunkSize * chunkSize);
+        climates.resize(chunkSize * chunkSize);
+        getTerrainHeights(startX, startZ, chunkSize, chunkSize, heights.data(), climates.data());
+    }
+
     // Generate blocks for each XZ column in chunk
     for (int x = 0; x < chunkSize; x++) {
         for (int z = 0; z < chunkSize; z++) {
             int worldX = startX + x;
             int worldZ = startZ + z;
 
-            // Get terrain surface height for this column
-            int height = getTerrainHeight(worldX, worldZ);
+            // Get terrain surface height, biome and water level for this column
+            int height;
+            BiomeType biome;
+            int water;
+            if (heightmap) {
+                height = heightmap->get(x, z);
+                biome  = heightmap->biomes[x * chunkSize + z];
+                water  = heightmap->waterLevels[x * chunkSize + z];
+            } else {
+                height = heights[x * chunkSize + z];
+                biome  = climates[x * chunkSize + z].biome;
+                water  = waterLevel + climates[x * chunkSize + z].waterOffset;
+            }
+            const Biome& columnBiome = getBiome(biome);
 
             // Generate terrain blocks from bedrock to surface
             for (int y = 0; y <= height; y++) {
-                uint32_t blockType = getBlockTypeAtPosition(worldX, y, worldZ, height);
+                uint32_t blockType = getBlockTypeAtPosition(y, height, columnBiome, water);
 
                 // Only add non-air blocks
                 if (blockType != 0) {
@@ -102,8 +339,8 @@ int chunkSize) {
             }
 
             // Fill water if terrain is below water level
-            if (height < waterLevel) {
-                for (int y = height + 1; y <= waterLevel; y++) {
+            if (height < water) {
+                for (int y = height + 1; y <= water; y++) {
                     blocks.emplace_back(
                     glm::ivec3(worldX, y, worldZ),
                     ::game::blocks::BlockIDs::WATER);
@@ -121,6 +358,312 @@ int chunkSize) {
     return blocks;
 }
 
+/**
+ * @brief Generate a chunk straight into a VoxelChunk
+ *
+ * Each column is classified bottom-up exactly like the TerrainBlock path
+ * (terrain up to the surface, then water up to the water level), but
+ * consecutive equal blocks are merged into runs and written with one
+ * fillColumn() each. Air runs are skipped because the chunk starts empty.
+ * Surface heights come from the chunk's heightmap (cached or sampled in
+ * one batch), which is returned so the caller can keep it.
+ *
+ * The lowest run of every column (stone from bedrock up) is held back.
+ * Once all columns are known, the height every column shares is written
+ * with a single fillLayers() and only the remainders go column by column.
+ *
+ * @param chunkX Chunk X index
+ * @param chunkZ Chunk Z index
+ * @param chunk Empty chunk to fill
+ * @return Heightmap the chunk was generated from
+ */
+std::shared_ptr<const ChunkHeightmap> TerrainGenerator::generateChunk(int chunkX, int chunkZ, chuck::VoxelChunk& chunk) const {
+    using ::game::blocks::BlockIDs::AIR;
+    using ::game::blocks::BlockIDs::WATER;
+
+    struct ColumnRun {
+        int y0      = 0;
+        int y1      = 0;
+        uint32_t id = AIR;
+    };
+
+    constexpr int sizeX = ChunkHeightmap::SIZE;
+    constexpr int sizeZ = ChunkHeightmap::SIZE;
+    const int sizeY     = chunk.getSizeY();
+
+    std::array<ColumnRun, sizeX * sizeZ> bottoms;
+    auto heightmap = getHeightmap(chunkX, chunkZ);
+
+    if (mode == TerrainMode::DENSITY) {
+        generateDensityChunk(chunkX, chunkZ, *heightmap, chunk);
+        return heightmap;
+    }
+
+    for (int x = 0; x < sizeX; x++) {
+        for (int z = 0; z < sizeZ; z++) {
+            int height         = heightmap->get(x, z);
+            int water          = heightmap->waterLevels[x * sizeZ + z];
+            const Biome& biome = getBiome(heightmap->biomes[x * sizeZ + z]);
+            int top            = std::min(std::max(height, water), sizeY - 1);
+
+            auto blockAt = [&](int y) {
+                if (y <= height) return getBlockTypeAtPosition(y, height, biome, water);
+                return y <= water ? WATER : AIR;
+            };
+
+            ColumnRun run{ 0, 0, blockAt(0) };
+            bool bottom = true;
+
+            // y == top + 1 acts as an air sentinel that closes the last run
+            for (int y = 1; y <= top + 1; y++) {
+                uint32_t id = y <= top ? blockAt(y) : AIR;
+                if (id == run.id) continue;
+
+                run.y1 = y;
+                if (bottom) {
+                    bottoms[x * sizeZ + z] = run;
+                    bottom                 = false;
+                } else if (run.id != AIR) {
+                    chunk.fillColumn(x, z, run.y0, run.y1, run.id);
+                }
+                run = ColumnRun{ y, y, id };
+            }
+        }
+    }
+
+    // Layers shared by every column: same bottom block type, up to the lowest run top
+    uint32_t commonId = bottoms[0].id;
+    int commonTop     = commonId == AIR ? 0 : sizeY;
+    for (int i = 0; i < sizeX * sizeZ && commonTop > 0; i++) {
+        commonTop = bottoms[i].id == commonId ? std::min(commonTop, bottoms[i].y1) : 0;
+    }
+    chunk.fillLayers(0, commonTop, commonId);
+
+    for (int x = 0; x < sizeX; x++) {
+        for (int z = 0; z < sizeZ; z++) {
+            const ColumnRun& run = bottoms[x * sizeZ + z];
+            if (run.id != AIR) {
+                chunk.fillColumn(x, z, std::max(run.y0, commonTop), run.y1, run.id);
+            }
+        }
+    }
+
+    return heightmap;
+}
+
+/**
+ * @brief Generate a chunk from interpolated 3D density
+ *
+ * Only a vertical band can differ from plain stone: from caveDepth (or
+ * overhangDepth) plus three topsoil blocks below the chunk's lowest
+ * surface up to overhangDepth above its highest one. Everything below the
+ * band is solid anyway, since (surface - y) / overhangDepth exceeds 1
+ * there and the density noise never goes below -1.
+ *
+ * Within the band, density and cave noise are sampled on a lattice every
+ * DENSITY_CELL blocks (5x5 columns per chunk) with fbmBatch() and
+ * trilinearly interpolated: bilinearly per column once, then linearly per
+ * block. Each column is then classified top-down. The first solid block is
+ * the surface (stone, shore or the biome's surface block by height, as in
+ * heightmap mode), the two below it are soil or shore, and everything
+ * further down, including cave floors and ground under overhangs, is
+ * stone. Air above the first solid block and below the column's water
+ * level becomes water; caves stay dry.
+ *
+ * Stone is written as whole layers up to the shallowest topsoil in the
+ * chunk and caves are then carved out of it, so only the cave blocks and
+ * the surface runs go through fillColumn().
+ *
+ * @param chunkX Chunk X index
+ * @param chunkZ Chunk Z index
+ * @param heightmap Surface heights the density is centred on
+ * @param chunk Empty chunk to fill
+ */
+void TerrainGenerator::generateDensityChunk(int chunkX, int chunkZ, const ChunkHeightmap& heightmap, chuck::VoxelChunk& chunk) const {
+    using namespace ::game::blocks::BlockIDs;
+
+    constexpr int SIZE    = ChunkHeightmap::SIZE;
+    constexpr int LATTICE = SIZE / DENSITY_CELL + 1; // Lattice points per horizontal axis
+
+    const int sizeY       = chunk.getSizeY();
+    const double invDepth = 1.0 / std::max(overhangDepth, 1);
+    const bool caves      = caveThreshold < 1.0f;
+
+    // Locals, since the byte and block ID stores below could alias the members
+    const double threshold    = caveThreshold;
+    const double mountainLine = baseHeight + maxHeight * 0.7;
+
+    int startX = chunkX * SIZE;
+    int startZ = chunkZ * SIZE;
+
+    int bandTop    = std::min(heightmap.maxHeight + overhangDepth, sizeY - 1);
+    int bandBottom = std::max(heightmap.minHeight - std::max(overhangDepth, caveDepth) - 3, 1);
+    int columnTop  = std::max(bandTop, std::min(heightmap.maxWaterLevel, sizeY - 1)); // Water may lie above the band
+    if (columnTop < bandBottom) {
+        chunk.fillLayers(0, std::min(bandBottom, sizeY), STONE);
+        return;
+    }
+
+    // Lattice levels cover [bandBottom, bandTop] with one spare level on top for interpolation
+    int level0 = bandBottom / DENSITY_CELL;
+    int levels = bandTop >= bandBottom ? bandTop / DENSITY_CELL + 2 - level0 : 0;
+
+    // Blocks more than overhangDepth under the surface are solid whatever the
+    // shape noise says, so levels only used by them keep a shape of 0
+    int shapeLevel0 = std::clamp(std::max(heightmap.minHeight - overhangDepth, 0) / DENSITY_CELL - level0, 0, levels);
+
+    // Level-major sample points, so the shape levels are one contiguous tail
+    constexpr int PLANE = LATTICE * LATTICE;
+    const size_t count  = static_cast<size_t>(PLANE) * levels;
+
+    std::vector<double> xs(count), ys(count), zs(count);
+    for (int ly = 0; ly < levels; ly++) {
+        for (int lx = 0; lx < LATTICE; lx++) {
+            for (int lz = 0; lz < LATTICE; lz++) {
+                size_t i = ly * PLANE + lx * LATTICE + lz;
+                xs[i]    = (startX + lx * DENSITY_CELL) * densityScale;
+                ys[i]    = (level0 + ly) * DENSITY_CELL * densityScale;
+                zs[i]    = (startZ + lz * DENSITY_CELL) * densityScale;
+            }
+        }
+    }
+
+    size_t shapeStart = static_cast<size_t>(PLANE) * shapeLevel0;
+    std::vector<double> shape(count, 0.0), cave(caves ? count : 0);
+    densityNoise.fbmBatch(xs.data() + shapeStart, ys.data() + shapeStart, zs.data() + shapeStart,
+    shape.data() + shapeStart, count - shapeStart, densityOctaves, persistence);
+    for (size_t i = shapeStart; i < count; i++) {
+        shape[i] = std::clamp(shape[i], -1.0, 1.0);
+    }
+    if (caves) {
+        caveNoise.fbmBatch(xs.data(), ys.data(), zs.data(), cave.data(), count, densityOctaves, persistence);
+    }
+
+    const int span = columnTop - bandBottom + 1;
+    std::vector<double> columnShape(levels), columnCave(levels);
+    std::vector<uint32_t> ids(SIZE * SIZE * span);
+    std::vector<uint8_t> solid(span); // Every column overwrites [bandBottom, bandTop]; above stays empty
+    int commonTop = columnTop + 1; // Below this every column is stone or cave air
+
+    for (int x = 0; x < SIZE; x++) {
+        for (int z = 0; z < SIZE; z++) {
+            uint32_t* column = &ids[(x * SIZE + z) * span];
+
+            // Bilinear weights between the four lattice columns around this one
+            int lx = x / DENSITY_CELL, lz = z / DENSITY_CELL;
+            double fx = (x % DENSITY_CELL) / double(DENSITY_CELL);
+            double fz = (z % DENSITY_CELL) / double(DENSITY_CELL);
+
+            size_t c00 = lx * LATTICE + lz;
+            size_t c01 = c00 + 1;
+            size_t c10 = c00 + LATTICE;
+            size_t c11 = c10 + 1;
+
+            auto bilinear = [&](const std::vector<double>& v, int ly) {
+                const double* plane = &v[ly * PLANE];
+                double a            = plane[c00] + fz * (plane[c01] - plane[c00]);
+                double b            = plane[c10] + fz * (plane[c11] - plane[c10]);
+                return a + fx * (b - a);
+            };
+            for (int ly = 0; ly < levels; ly++) {
+                columnShape[ly] = bilinear(shape, ly);
+                if (caves) columnCave[ly] = bilinear(cave, ly);
+            }
+
+            // Solid mask, one lattice cell at a time: density and cave noise change linearly within it
+            int height = heightmap.get(x, z);
+            for (int ly = 0; ly + 1 < levels; ly++) {
+                int cellY        = (level0 + ly) * DENSITY_CELL;
+                double shape0    = columnShape[ly];
+                double shapeStep = (columnShape[ly + 1] - shape0) / DENSITY_CELL;
+                double cave0     = caves ? columnCave[ly] : 0.0;
+                double caveStep  = caves ? (columnCave[ly + 1] - cave0) / DENSITY_CELL : 0.0;
+
+                double density0    = (height - cellY) * invDepth + shape0;
+                double densityStep = shapeStep - invDepth;
+
+                int k0 = std::max(bandBottom - cellY, 0);
+                int k1 = std::min(bandTop - cellY + 1, DENSITY_CELL);
+                for (int k = k0; k < k1; k++) {
+                    bool carved = caves && cave0 + k * caveStep > threshold;
+                    solid[cellY + k - bandBottom] = density0 + k * densityStep > 0.0 && !carved;
+                }
+            }
+
+            // Classify top-down: surface block, topsoil under it, stone below; water over the surface
+            const Biome& biome    = getBiome(heightmap.biomes[x * SIZE + z]);
+            const int water       = heightmap.waterLevels[x * SIZE + z];
+            const uint32_t ground = biome.surfaceBlock;
+            const uint32_t soil   = biome.soilBlock;
+            const uint32_t shore  = biome.shoreBlock;
+
+            bool seenSolid = false;
+            int surfaceY   = 0;
+            int below      = 0; // Consecutive solid blocks under the surface
+
+            int y = columnTop;
+            for (; y >= bandBottom && below < 3; y--) {
+                uint32_t id;
+                if (!solid[y - bandBottom]) {
+                    id = !seenSolid && y <= water ? WATER : AIR;
+                    if (seenSolid) below = 3; // Topsoil ends at the first gap
+                } else if (!seenSolid) {
+                    seenSolid = true;
+                    surfaceY  = y;
+                    below     = 0;
+                    if (y > mountainLine) {
+                        id = STONE;
+                    } else if (y <= water + 2) {
+                        id = shore;
+                    } else {
+                        id = ground;
+                    }
+                } else {
+                    below++;
+                    id = below >= 3 ? STONE : (surfaceY <= water + 2 ? shore : soil);
+                }
+                column[y - bandBottom] = id;
+            }
+
+            // Past the topsoil only stone and cave air remain
+            for (; y >= bandBottom; y--) {
+                column[y - bandBottom] = solid[y - bandBottom] ? STONE : AIR;
+            }
+
+            // The shared stone layers end where the shallowest topsoil begins
+            commonTop = std::min(commonTop, seenSolid ? std::max(surfaceY - 2, bandBottom) : bandBottom);
+        }
+    }
+
+    // Writing the few cave blocks is much cheaper than writing the stone around them
+    chunk.fillLayers(0, std::min(commonTop, sizeY), STONE);
+
+    // Calls write(y0, y1, id) for each run of equal blocks in [y0, y1) of a column
+    auto forEachRun = [&](const uint32_t* column, int y0, int y1, auto&& write) {
+        int runStart = y0;
+        for (int y = y0 + 1; y <= y1; y++) {
+            if (y < y1 && column[y - bandBottom] == column[runStart - bandBottom]) continue;
+            write(runStart, y, column[runStart - bandBottom]);
+            runStart = y;
+        }
+    };
+
+    for (int x = 0; x < SIZE; x++) {
+        for (int z = 0; z < SIZE; z++) {
+            const uint32_t* column = &ids[(x * SIZE + z) * span];
+
+            forEachRun(column, bandBottom, commonTop, [&](int y0, int y1, uint32_t id) {
+                if (id == AIR) chunk.fillColumn(x, z, y0, y1, AIR);
+            });
+
+            // Above the shared stone, air is skipped because the chunk starts empty
+            forEachRun(column, commonTop, columnTop + 1, [&](int y0, int y1, uint32_t id) {
+                if (id != AIR) chunk.fillColumn(x, z, y0, y1, id);
+            });
+        }
+    }
+}
+
 /**
  * @brief Generate flat rectangular terrain region
  *
@@ -140,7 +683,7 @@ std::vector<TerrainBlock> TerrainGenerator::generateFlatTerrain(
 int sizeX,
 int sizeZ,
 int centerX,
-int centerZ) {
+int centerZ) const {
 
     std::vector<TerrainBlock> blocks;
 
@@ -154,11 +697,14 @@ int centerZ) {
             int worldX = startX + x;
             int worldZ = startZ + z;
 
-            int height = getTerrainHeight(worldX, worldZ);
+            int index;
+            auto heightmap     = getColumnHeightmap(worldX, worldZ, index);
+            int height         = heightmap->heights[index];
+            const Biome& biome = getBiome(heightmap->biomes[index]);
 
             // Generate terrain layers (no water in this method)
             for (int y = 0; y <= height; y++) {
-                uint32_t blockType = getBlockTypeAtPosition(worldX, y, worldZ, height);
+                uint32_t blockType = getBlockTypeAtPosition(y, height, biome, heightmap->waterLevels[index]);
 
                 if (blockType != 0) {
                     blocks.emplace_back(glm::ivec3(worldX, y, worldZ), blockType);
@@ -178,12 +724,12 @@ int centerZ) {
  * Layer structure (from top to bottom):
  * 1. Surface (Y = surfaceHeight):
  *    - High altitude (>70% max height): Stone mountains
- *    - Near water (±2 blocks): Sandy beaches
- *    - Normal altitude: Grass-covered plains
+ *    - Near water (±2 blocks): The biome's shore block (sandy beaches)
+ *    - Normal altitude: The biome's surface block (grass-covered plains)
  *
  * 2. Subsurface (1-3 blocks below surface):
- *    - Below beaches: Sand continues
- *    - Below grass: Dirt layer
+ *    - Below shores: The shore block continues
+ *    - Elsewhere: The biome's soil (dirt layer)
  *
  * 3. Deep underground (>3 blocks below surface):
  *    - Stone
@@ -191,17 +737,13 @@ int centerZ) {
  * 4. Bedrock (Y = 0):
  *    - Stone (representing unbreakable bottom)
  *
- * @param x World X coordinate (reserved for future biome logic)
  * @param y World Y coordinate (current depth)
- * @param z World Z coordinate (reserved for future biome logic)
  * @param surfaceHeight Surface Y coordinate for this column
+ * @param biome Biome of this column
+ * @param columnWaterLevel Water surface Y of this column
  * @return Block type ID (AIR = 0 if no block needed)
  */
-uint32_t TerrainGenerator::getBlockTypeAtPosition(
-__attribute_maybe_unused__ int x,
-__attribute_maybe_unused__ int y,
-__attribute_maybe_unused__ int z,
-int surfaceHeight) {
+uint32_t TerrainGenerator::getBlockTypeAtPosition(int y, int surfaceHeight, const Biome& biome, int columnWaterLevel) const {
 
     using namespace ::game::blocks::BlockIDs;
 
@@ -216,25 +758,25 @@ int surfaceHeight) {
         if (y > baseHeight + maxHeight * 0.7) {
             return STONE;
         }
-        // Beach biome - near water level
-        else if (y <= waterLevel + 2) {
-            return SAND;
+        // Shore - near water level
+        else if (y <= columnWaterLevel + 2) {
+            return biome.shoreBlock;
         }
-        // Grassland biome - normal elevation
+        // Biome surface - normal elevation
         else {
-            return GRASS;
+            return biome.surfaceBlock;
         }
     }
 
     // Subsurface layer (1-3 blocks below surface)
     if (y > surfaceHeight - 3 && y < surfaceHeight) {
-        // Sand continues below beaches
-        if (surfaceHeight <= waterLevel + 2) {
-            return SAND;
+        // Shore block continues below shores
+        if (surfaceHeight <= columnWaterLevel + 2) {
+            return biome.shoreBlock;
         }
-        // Dirt layer below grassland
+        // Soil layer below the surface
         else {
-            return DIRT;
+            return biome.soilBlock;
         }
     }
 
@@ -2,10 +2,14 @@
 
 #include "game/blocks/blocks.hpp"
 #include "game/blocks/blocks_types.hpp"
+#include "game/chuck/voxel_chunk.hpp"
+#include "game/generator/climate_map.hpp"
+#include "game/generator/heightmap_cache.hpp"
 #include "game/generator/perlin_noise.hpp"
 #include "utils/logger/logger.hpp"
 
 #include <glm/glm.hpp>
+#include <memory>
 #include <vector>
 
 namespace game::generator {
@@ -22,16 +26,33 @@ struct TerrainBlock {
     : position(pos), blockTypeId(id) {}
 };
 
+/**
+ * @brief How TerrainGenerator decides which blocks are solid
+ */
+enum class TerrainMode {
+    HEIGHTMAP, // Solid up to a 2D noise surface per column
+    DENSITY    // 3D density noise around that surface: overhangs, cliffs and caves
+};
+
 /**
  * @brief Procedural terrain generator using Perlin noise
  *
  * Generates realistic 3D terrain with:
- * - Height-based biomes (grass, sand, stone)
+ * - Height-based surface blocks (grass, sand, stone)
+ * - Optional climate biomes choosing surface blocks, hilliness and water level
  * - Multi-layer subsurface structure (grass/dirt/stone)
  * - Water bodies at configurable sea level
  * - Chunk-based generation for efficient world streaming
  *
  * Uses Fractal Brownian Motion (FBM) for natural-looking height variation.
+ * In TerrainMode::DENSITY, 3D FBM perturbs that surface and carves caves;
+ * it is sampled on a coarse lattice and interpolated to bound its cost.
+ *
+ * Chunk heightmaps are kept in a bounded LRU, so regenerating a chunk or
+ * asking for the height of a neighbouring column does not sample noise again.
+ *
+ * All generation methods are const and may be called concurrently from
+ * chunk worker threads; parameters must only be changed before workers start.
  */
 class TerrainGenerator {
     private:
@@ -41,10 +62,30 @@ class TerrainGenerator {
     float scale;       // Noise sampling scale (smaller = more zoomed out)
     int octaves;       // Number of noise layers (more = more detail)
     float persistence; // Amplitude decay per octave (controls roughness)
+
+    PerlinNoise::FbmKernel fbmKernel; // fbm<octaves>() specialisation, nullptr if none
+    FbmWeights fbmWeights;            // Its amplitude table for the current persistence
     int baseHeight;    // Baseline terrain height (sea level offset)
     int maxHeight;     // Maximum height variation above/below baseline
     int waterLevel;    // Y-level for water surface
 
+    // 3D density parameters, used in TerrainMode::DENSITY
+    TerrainMode mode;            // Heightmap or density terrain
+    PerlinNoise densityNoise;    // Displaces the surface: overhangs and cliffs
+    PerlinNoise caveNoise;       // Carves caves where it exceeds caveThreshold
+    float densityScale;          // 3D noise sampling scale
+    int densityOctaves;          // Number of 3D noise layers
+    int overhangDepth;           // Blocks the surface may move up or down
+    float caveThreshold;         // Higher = fewer, smaller caves; above 1 disables caves
+    int caveDepth;               // Caves reach this far below the lowest surface in a chunk
+
+    static constexpr int DENSITY_CELL = 4; // Lattice spacing of density samples, in blocks
+
+    bool biomes;        // Whether the climate map shapes the terrain
+    ClimateMap climate; // Temperature/humidity noise and the biomes it implies
+
+    mutable HeightmapCache heightmapCache; // Recently generated chunk heightmaps
+
     public:
     /**
      * @brief Construct a new Terrain Generator
@@ -52,25 +93,120 @@ class TerrainGenerator {
      */
     TerrainGenerator(unsigned int seed = 12345);
 
-    // Parameter setters for terrain customization
-    void setScale(float s) { scale = s; }
-    void setOctaves(int o) { octaves = o; }
-    void setPersistence(float p) { persistence = p; }
-    void setBaseHeight(int h) { baseHeight = h; }
-    void setMaxHeight(int h) { maxHeight = h; }
-    void setWaterLevel(int w) { waterLevel = w; }
+    // Parameter setters for terrain customization; height parameters invalidate cached heightmaps
+    void setScale(float s) {
+        scale = s;
+        heightmapCache.clear();
+    }
+    void setOctaves(int o) {
+        octaves = o;
+        selectFbmKernel();
+        heightmapCache.clear();
+    }
+    void setPersistence(float p) {
+        persistence = p;
+        selectFbmKernel();
+        heightmapCache.clear();
+    }
+    void setBaseHeight(int h) {
+        baseHeight = h;
+        heightmapCache.clear();
+    }
+    void setMaxHeight(int h) {
+        maxHeight = h;
+        heightmapCache.clear();
+    }
+    void setWaterLevel(int w) {
+        waterLevel = w;
+        heightmapCache.clear();
+    }
+
+    // Density setters; the mode and overhang depth change each heightmap's maxSolidY
+    void setTerrainMode(TerrainMode m) {
+        mode = m;
+        heightmapCache.clear();
+    }
+    void setOverhangDepth(int d) {
+        overhangDepth = d;
+        heightmapCache.clear();
+    }
+    void setDensityScale(float s) { densityScale = s; }
+    void setDensityOctaves(int o) { densityOctaves = o; }
+    void setCaveThreshold(float t) { caveThreshold = t; }
+    void setCaveDepth(int d) { caveDepth = d; }
+
+    TerrainMode getTerrainMode() const { return mode; }
+
+    // Biome setters; biomes change heights and water levels, so both invalidate cached heightmaps
+    void setBiomesEnabled(bool enabled) {
+        biomes = enabled;
+        heightmapCache.clear();
+    }
+    void setClimateScale(float s) {
+        climate.setScale(s);
+        heightmapCache.clear();
+    }
+
+    bool getBiomesEnabled() const { return biomes; }
+
+    GridCacheStats getClimateCacheStats() const { return climate.getCacheStats(); }
+
+    /**
+     * @brief Limit the number of cached chunk heightmaps; 0 disables the cache
+     */
+    void setHeightmapCacheCapacity(size_t capacity) { heightmapCache.setCapacity(capacity); }
+
+    HeightmapCacheStats getHeightmapCacheStats() const { return heightmapCache.getStats(); }
 
     /**
      * @brief Calculate terrain height at given coordinates
      *
      * Uses FBM noise to generate smooth, natural-looking height variation.
-     * Height is mapped from noise range [-1, 1] to [baseHeight - maxHeight, baseHeight + maxHeight].
+     * Height is mapped from noise range [-1, 1] to [baseHeight - maxHeight, baseHeight + maxHeight];
+     * with biomes enabled, the column's biome shifts the base and scales the range.
      *
      * @param x World X coordinate
      * @param z World Z coordinate
      * @return Terrain surface height (Y coordinate)
      */
-    int getTerrainHeight(int x, int z);
+    int getTerrainHeight(int x, int z) const;
+
+    /**
+     * @brief Terrain heights of a rectangular block of columns in one batch
+     *
+     * Evaluates the noise with PerlinNoise::fbmBatch(), which vectorises
+     * across columns; every height equals getTerrainHeight() for the same column.
+     *
+     * @param startX World X of the first column
+     * @param startZ World Z of the first column
+     * @param sizeX Columns along X
+     * @param sizeZ Columns along Z
+     * @param heights Receives sizeX * sizeZ heights, index x * sizeZ + z
+     * @param climates Optional, receives the climate of each column, same index
+     */
+    void getTerrainHeights(int startX, int startZ, int sizeX, int sizeZ, int* heights, ColumnClimate* climates = nullptr) const;
+
+    /**
+     * @brief Heightmap of a 16x16 chunk, from the cache or freshly sampled
+     * @param chunkX Chunk X coordinate (in chunk space)
+     * @param chunkZ Chunk Z coordinate (in chunk space)
+     * @return Shared, immutable heightmap
+     */
+    std::shared_ptr<const ChunkHeightmap> getHeightmap(int chunkX, int chunkZ) const;
+
+    /**
+     * @brief Surface height of any world column through its chunk's cached heightmap
+     *
+     * Meant for neighbour queries across chunk borders; equals getTerrainHeight().
+     */
+    int getColumnHeight(int x, int z) const;
+
+    /**
+     * @brief Biome of any world column through its chunk's cached heightmap
+     *
+     * Always BiomeType::PLAINS while biomes are disabled.
+     */
+    BiomeType getColumnBiome(int x, int z) const;
 
     /**
      * @brief Generate terrain blocks for a chunk
@@ -80,12 +216,36 @@ class TerrainGenerator {
      * - Water bodies where terrain is below water level
      * - Proper block types based on height and depth
      *
+     * In TerrainMode::DENSITY the blocks are read back from the voxel path,
+     * which only supports 16x16 chunks.
+     *
      * @param chunkX Chunk X coordinate (in chunk space)
      * @param chunkZ Chunk Z coordinate (in chunk space)
      * @param chunkSize Size of chunk in blocks (default 16x16)
      * @return Vector of all blocks in the chunk
      */
-    std::vector<TerrainBlock> generateChunk(int chunkX, int chunkZ, int chunkSize = 16);
+    std::vector<TerrainBlock> generateChunk(int chunkX, int chunkZ, int chunkSize = 16) const;
+
+    /**
+     * @brief Generate a chunk directly into voxel storage
+     *
+     * Produces the same blocks as the TerrainBlock overload without the
+     * intermediate list: every column is written as a few run-length
+     * fillColumn() calls, and the bottom layers shared by all columns are
+     * written with fillLayers(), so fully covered sections stay uniform and
+     * never allocate storage.
+     *
+     * In TerrainMode::DENSITY the columns between the deepest cave and the
+     * highest overhang are classified from interpolated 3D density instead.
+     *
+     * The chunk is expected to be empty; call VoxelChunk::compact() afterwards.
+     *
+     * @param chunkX Chunk X coordinate (in chunk space)
+     * @param chunkZ Chunk Z coordinate (in chunk space)
+     * @param chunk Destination, 16x16 columns
+     * @return The heightmap the chunk was generated from, for the caller to keep
+     */
+    std::shared_ptr<const ChunkHeightmap> generateChunk(int chunkX, int chunkZ, chuck::VoxelChunk& chunk) const;
 
     /**
      * @brief Generate flat rectangular terrain region
@@ -103,34 +263,57 @@ class TerrainGenerator {
     int sizeX,
     int sizeZ,
     int centerX = 0,
-    int centerZ = 0);
+    int centerZ = 0) const;
 
     private:
+    /**
+     * @brief Pick the fbm kernel and amplitudes for the current octaves and persistence
+     */
+    void selectFbmKernel() {
+        fbmKernel  = PerlinNoise::getFbmKernel(octaves);
+        fbmWeights = makeFbmWeights(octaves, persistence);
+    }
+
+    /**
+     * @brief Sample noise for one chunk's heightmap, bypassing the cache
+     */
+    std::shared_ptr<const ChunkHeightmap> computeHeightmap(int chunkX, int chunkZ) const;
+
+    /**
+     * @brief Fill a chunk from 3D density around its heightmap (TerrainMode::DENSITY)
+     *
+     * Density is sampled every DENSITY_CELL blocks and trilinearly
+     * interpolated. Solid where (surface - y) / overhangDepth plus the
+     * density noise is positive, unless the cave noise carves it out.
+     */
+    void generateDensityChunk(int chunkX, int chunkZ, const ChunkHeightmap& heightmap, chuck::VoxelChunk& chunk) const;
+
+    /**
+     * @brief Heightmap of the chunk holding a world column, and the column's index in it
+     */
+    std::shared_ptr<const ChunkHeightmap> getColumnHeightmap(int x, int z, int& index) const;
+
     /**
      * @brief Determine block type based on position and terrain height
      *
      * Implements biome and layer logic:
      * - Y=0: Bedrock (stone)
-     * - Surface: Grass, sand, or stone based on elevation
-     * - Subsurface (1-3 blocks deep): Dirt or sand
+     * - Surface: The biome's surface or shore block, or stone by elevation
+     * - Subsurface (1-3 blocks deep): The biome's soil or shore block
      * - Deep underground: Stone
      *
-     * Biome rules:
+     * Surface rules:
      * - High elevation (>70% of max height): Stone mountains
-     * - Near water level (±2 blocks): Sandy beaches
-     * - Normal elevation: Grass-covered terrain
+     * - Near the column's water level (±2 blocks): Shore, sandy beaches in most biomes
+     * - Otherwise: The biome's surface, grass in most biomes
      *
-     * @param x World X coordinate (unused in current implementation)
      * @param y World Y coordinate (depth)
-     * @param z World Z coordinate (unused in current implementation)
      * @param surfaceHeight Height of terrain surface at this column
+     * @param biome Biome of this column
+     * @param columnWaterLevel Water surface Y of this column
      * @return Block type ID (or AIR if no block should be placed)
      */
-    uint32_t getBlockTypeAtPosition(
-    __attribute_maybe_unused__ int x,
-    __attribute_maybe_unused__ int y,
-    __attribute_maybe_unused__ int z,
-    int surfaceHeight);
+    uint32_t getBlockTypeAtPosition(int y, int surfaceHeight, const Biome& biome, int columnWaterLevel) const;
 };
 
 } // namespace game::generator
\ No newline at end of file
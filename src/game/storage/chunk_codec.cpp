@@ -0,0 +1,203 @@
+#include "chunk_codec.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <stdexcept>
+
+#include "game/chuck/chunk_serializer.hpp"
+#include "utils/binary_io.hpp"
+#include "utils/compression/lz.hpp"
+
+namespace game::storage {
+
+namespace {
+
+using game::chuck::ChunkSection;
+using game::chuck::VoxelChunk;
+
+constexpr int SECTION_SIZE = ChunkSection::SIZE;
+constexpr int VOLUME       = ChunkSection::VOLUME;
+
+// an RLE encoding is at most one 5-byte varint per block, a palette entry per block and a header per section
+constexpr uint32_t MAX_RLE_SIZE = 2 * 5 * VOLUME * VoxelChunk::SECTION_COUNT + 5 * VoxelChunk::SECTION_COUNT + 5;
+
+// Block i of a section in RLE order: column (z, x), then y upwards
+constexpr int getSectionIndex(int column, int y) {
+    return y << 8 | column;
+}
+
+uint32_t getChunkPaletteIndex(std::vector<uint32_t>& palette, uint32_t type) {
+    auto it = std::find(palette.begin(), palette.end(), type);
+    if (it == palette.end()) it = palette.insert(palette.end(), type);
+    return static_cast<uint32_t>(it - palette.begin());
+}
+
+void encodeRuns(const VoxelChunk& chunk, std::vector<uint8_t>& out) {
+    // chunk palette first, so section headers can refer to it; chunks hold only a few block types
+    std::vector<uint32_t> palette;
+    std::array<uint32_t, VoxelChunk::SECTION_COUNT> uniformIndices;
+    std::vector<uint32_t> sectionPalettes; // storage palettes mapped to chunk palette indices, back to back
+    for (int s = 0; s < VoxelChunk::SECTION_COUNT; s++) {
+        const ChunkSection& section = chunk.getSection(s);
+        if (section.isUniform()) {
+            uniformIndices[s] = getChunkPaletteIndex(palette, section.getUniformType());
+            continue;
+        }
+        for (uint32_t type : section.getStorage()->getPalette()) {
+            sectionPalettes.push_back(getChunkPaletteIndex(palette, type));
+        }
+    }
+
+    utils::appendVarint(out, static_cast<uint32_t>(palette.size()));
+    for (uint32_t type : palette) {
+        utils::appendVarint(out, type);
+    }
+
+    // runs compare the storage's own palette indices, unpacked once; get() per block costs several times more
+    std::array<uint16_t, VOLUME> indices;
+    const uint32_t* sectionPalette = sectionPalettes.data();
+    for (int s = 0; s < VoxelChunk::SECTION_COUNT; s++) {
+        const game::chuck::PalettedBlockStorage* storage = chunk.getSection(s).getStorage();
+        if (!storage) {
+            utils::appendVarint(out, uniformIndices[s] << 1);
+            continue;
+        }
+
+        uint32_t paletteSize = static_cast<uint32_t>(storage->getPaletteSize());
+        utils::appendVarint(out, (paletteSize - 1) << 1 | 1);
+        for (uint32_t i = 0; i < paletteSize; i++) {
+            utils::appendVarint(out, sectionPalette[i]);
+        }
+        sectionPalette += paletteSize;
+
+        storage->unpackIndices(indices.data());
+        int indexBits     = static_cast<int>(std::bit_width(paletteSize - 1));
+        uint32_t runIndex = indices[0], runLength = 0;
+        for (int column = 0; column < SECTION_SIZE * SECTION_SIZE; column++) {
+            for (int y = 0; y < SECTION_SIZE; y++) {
+                uint32_t index = indices[getSectionIndex(column, y)];
+                if (index != runIndex) {
+                    utils::appendVarint(out, (runLength - 1) << indexBits | runIndex);
+                    runIndex  = index;
+                    runLength = 0;
+                }
+                runLength++;
+            }
+        }
+        utils::appendVarint(out, (runLength - 1) << indexBits | runIndex);
+    }
+}
+
+bool decodeRuns(const uint8_t* in, const uint8_t* end, VoxelChunk& chunk) {
+    uint32_t paletteSize;
+    if (!utils::readVarint(in, end, paletteSize)) return false;
+    // every palette entry takes at least one byte
+    if (paletteSize == 0 || paletteSize > static_cast<size_t>(end - in)) return false;
+
+    std::vector<uint32_t> palette(paletteSize);
+    for (uint32_t& type : palette) {
+        if (!utils::readVarint(in, end, type)) return false;
+    }
+
+    std::array<uint16_t, VOLUME> indices;
+    for (int s = 0; s < VoxelChunk::SECTION_COUNT; s++) {
+        uint32_t header;
+        if (!utils::readVarint(in, end, header)) return false;
+
+        if (!(header & 1)) {
+            if ((header >> 1) >= paletteSize) return false;
+            chunk.getSection(s).assignUniform(palette[header >> 1]);
+            continue;
+        }
+
+        uint32_t sectionPaletteSize = (header >> 1) + 1;
+        if (sectionPaletteSize > (1u << game::chuck::PalettedBlockStorage::MAX_BITS)) return false;
+        if (sectionPaletteSize > static_cast<size_t>(end - in)) return false;
+
+        std::vector<uint32_t> types(sectionPaletteSize);
+        for (uint32_t& type : types) {
+            uint32_t index;
+            if (!utils::readVarint(in, end, index) || index >= paletteSize) return false;
+            type = palette[index];
+        }
+
+        // runs carry the section palette indices, so the storage is packed from them without any lookup
+        int indexBits      = static_cast<int>(std::bit_width(sectionPaletteSize - 1));
+        uint32_t indexMask = (uint32_t(1) << indexBits) - 1;
+        for (int pos = 0; pos < VOLUME;) {
+            uint32_t value;
+            if (!utils::readVarint(in, end, value)) return false;
+
+            uint32_t index  = value & indexMask;
+            uint32_t length = (value >> indexBits) + 1;
+            if (index >= sectionPaletteSize || length > static_cast<uint32_t>(VOLUME - pos)) return false;
+
+            for (int last = pos + static_cast<int>(length); pos < last; pos++) {
+                indices[getSectionIndex(pos >> 4, pos & (SECTION_SIZE - 1))] = static_cast<uint16_t>(index);
+            }
+        }
+
+        chunk.getSection(s).assignStorage(
+        game::chuck::PalettedBlockStorage::fromIndices(VOLUME, std::move(types), indices.data()));
+    }
+    return in == end;
+}
+
+} // namespace
+
+const char* getChunkCodecName(ChunkCodec codec) {
+    switch (codec) {
+    case ChunkCodec::SECTIONS: return "sections";
+    case ChunkCodec::RLE: return "rle";
+    case ChunkCodec::RLE_LZ: return "rle+lz";
+    case ChunkCodec::COUNT: break;
+    }
+    return "unknown";
+}
+
+void encodeChunk(const VoxelChunk& chunk, ChunkCodec codec, std::vector<uint8_t>& out) {
+    out.push_back(static_cast<uint8_t>(codec));
+
+    switch (codec) {
+    case ChunkCodec::SECTIONS:
+        game::chuck::serializeChunk(chunk, out);
+        return;
+    case ChunkCodec::RLE:
+        encodeRuns(chunk, out);
+        return;
+    case ChunkCodec::RLE_LZ: {
+        std::vector<uint8_t> runs;
+        encodeRuns(chunk, runs);
+        utils::appendVarint(out, static_cast<uint32_t>(runs.size()));
+        utils::lzCompress(runs.data(), runs.size(), out);
+        return;
+    }
+    case ChunkCodec::COUNT: break;
+    }
+    throw std::invalid_argument("Unknown chunk codec");
+}
+
+bool decodeChunk(const uint8_t* data, size_t size, VoxelChunk& chunk) {
+    if (size == 0) return false;
+    const uint8_t* in  = data + 1;
+    const uint8_t* end = data + size;
+
+    switch (static_cast<ChunkCodec>(data[0])) {
+    case ChunkCodec::SECTIONS:
+        return game::chuck::deserializeChunk(in, end - in, chunk);
+    case ChunkCodec::RLE:
+        return decodeRuns(in, end, chunk);
+    case ChunkCodec::RLE_LZ: {
+        uint32_t rawSize;
+        if (!utils::readVarint(in, end, rawSize) || rawSize > MAX_RLE_SIZE) return false;
+        std::vector<uint8_t> runs(rawSize);
+        if (!utils::lzDecompress(in, end - in, runs.data(), rawSize)) return false;
+        return decodeRuns(runs.data(), runs.data() + rawSize, chunk);
+    }
+    case ChunkCodec::COUNT: break;
+    }
+    return false;
+}
+
+} // namespace game::storage
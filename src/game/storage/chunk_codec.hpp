@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "game/chuck/voxel_chunk.hpp"
+
+namespace game::storage {
+
+/**
+ * @brief Encoding of a stored chunk, the first byte of every encoded chunk
+ *
+ * Decoders dispatch on it, so data written with an older codec stays
+ * readable after a new one is added.
+ */
+enum class ChunkCodec : uint8_t {
+    SECTIONS = 0, // game::chuck::serializeChunk(): palette-packed sections as in memory
+    RLE      = 1, // Chunk palette, then runs along each column of every mixed section, bottom to top
+    RLE_LZ   = 2, // RLE bytes compressed again with utils::lzCompress()
+    COUNT
+};
+
+const char* getChunkCodecName(ChunkCodec codec);
+
+/**
+ * @brief Encode a chunk with the given codec, appending the codec byte and the data to out
+ *
+ * RLE stores a varint palette of the chunk's block types, then one varint
+ * header per section: a uniform section is just its palette index, so
+ * air and solid stone cost a byte. A mixed section lists its own palette
+ * (indices into the chunk palette) and then its blocks as runs, column by
+ * column (z, then x), each column from the bottom up, one varint per run:
+ * (length - 1) << indexBits | sectionPaletteIndex. Terrain columns are a
+ * few runs each (stone, dirt, grass, air), and the run indices are
+ * exactly what the decoded section storage holds, so decoding needs no
+ * palette lookups.
+ *
+ * RLE_LZ adds the varint length of the RLE bytes and compresses them;
+ * neighbouring columns repeat each other's run sequence, which the LZ
+ * stage collapses.
+ */
+void encodeChunk(const game::chuck::VoxelChunk& chunk, ChunkCodec codec, std::vector<uint8_t>& out);
+
+/**
+ * @brief Decode data written by encodeChunk(), overwriting every section of chunk
+ *
+ * The result is compact()ed. Input is not trusted: an unknown codec or
+ * malformed data returns false, leaving chunk unspecified.
+ */
+bool decodeChunk(const uint8_t* data, size_t size, game::chuck::VoxelChunk& chunk);
+
+} // namespace game::storage
@@ -0,0 +1,243 @@
+#include "region_file.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "utils/binary_io.hpp"
+#include "utils/logger/logger.hpp"
+
+namespace game::storage {
+
+namespace {
+
+constexpr uint8_t MAGIC[4] = { 'N', 'T', 'R', 'G' };
+
+std::runtime_error ioError(const std::string& what, const std::string& path) {
+    return std::runtime_error(what + ": " + path + ": " + std::strerror(errno));
+}
+
+} // namespace
+
+RegionFile::RegionFile(const std::string& path) : m_path(path) {
+    m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (m_fd < 0) {
+        throw ioError("cannot open region file", path);
+    }
+
+    try {
+        struct stat info;
+        if (::fstat(m_fd, &info) != 0) {
+            throw ioError("cannot stat region file", path);
+        }
+        m_fileSize = static_cast<uint64_t>(info.st_size);
+
+        if (m_fileSize == 0) {
+            // new file: header and an empty table
+            std::vector<uint8_t> bytes(PAYLOAD_OFFSET, 0);
+            std::memcpy(bytes.data(), MAGIC, sizeof(MAGIC));
+            bytes[4] = static_cast<uint8_t>(VERSION);
+            writeAt(bytes.data(), bytes.size(), 0);
+            m_fileSize = PAYLOAD_OFFSET;
+        }
+
+        m_mapping = utils::MappedFile(path);
+        readTable();
+    } catch (...) {
+        ::close(m_fd);
+        throw;
+    }
+}
+
+RegionFile::~RegionFile() {
+    ::close(m_fd);
+}
+
+void RegionFile::readTable() {
+    const uint8_t* data = m_mapping.data();
+    if (m_mapping.size() < PAYLOAD_OFFSET || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("not a region file: " + m_path);
+    }
+
+    uint32_t version = utils::readLE<uint32_t>(data + 4);
+    if (version != VERSION) {
+        throw std::runtime_error("unsupported region file version " + std::to_string(version) + ": " + m_path);
+    }
+
+    size_t dropped = 0;
+    for (int i = 0; i < CHUNKS; i++) {
+        const uint8_t* bytes = data + HEADER_SIZE + i * TABLE_ENTRY;
+        Entry entry{ utils::readLE<uint32_t>(bytes), utils::readLE<uint32_t>(bytes + 4) };
+
+        // an entry pointing outside the payloads can only come from a damaged file
+        if (entry.length != 0 &&
+        (entry.offset < PAYLOAD_OFFSET || uint64_t(entry.offset) + entry.length > m_fileSize)) {
+            entry = {};
+            dropped++;
+        }
+        m_table[i] = entry;
+    }
+
+    if (dropped > 0) {
+        LOG_WARN("Region file ", m_path, ": ignoring ", dropped, " table entries outside the file");
+    }
+}
+
+void RegionFile::writeAt(const uint8_t* data, size_t size, uint64_t offset) {
+    while (size > 0) {
+        ssize_t written = ::pwrite(m_fd, data, size, static_cast<off_t>(offset));
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            throw ioError("cannot write region file", m_path);
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+        offset += static_cast<uint64_t>(written);
+    }
+}
+
+bool RegionFile::hasChunk(int localX, int localZ) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_table[getIndex(localX, localZ)].length != 0;
+}
+
+bool RegionFile::loadChunk(int localX, int localZ, game::chuck::VoxelChunk& chunk) {
+    int index = getIndex(localX, localZ);
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        Entry entry = m_table[index];
+        if (entry.length == 0) return false;
+        if (uint64_t(entry.offset) + entry.length <= m_mapping.size()) {
+            return decodeChunk(m_mapping.data() + entry.offset, entry.length, chunk);
+        }
+    }
+
+    // saved after the file was last mapped
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    Entry entry = m_table[index];
+    if (uint64_t(entry.offset) + entry.length > m_mapping.size()) {
+        m_mapping = utils::MappedFile(m_path);
+    }
+    return decodeChunk(m_mapping.data() + entry.offset, entry.length, chunk);
+}
+
+size_t RegionFile::saveChunk(int localX, int localZ, const game::chuck::VoxelChunk& chunk, ChunkCodec codec) {
+    std::vector<uint8_t> payload;
+    encodeChunk(chunk, codec, payload);
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    if (m_fileSize + payload.size() > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("region file is full: " + m_path);
+    }
+
+    Entry entry{ static_cast<uint32_t>(m_fileSize), static_cast<uint32_t>(payload.size()) };
+    writeAt(payload.data(), payload.size(), m_fileSize);
+    m_fileSize += payload.size();
+
+    // the table entry goes last: until it is written the old version stays valid
+    int index = getIndex(localX, localZ);
+    std::vector<uint8_t> bytes;
+    utils::appendLE<uint32_t>(bytes, entry.offset);
+    utils::appendLE<uint32_t>(bytes, entry.length);
+    writeAt(bytes.data(), bytes.size(), HEADER_SIZE + index * TABLE_ENTRY);
+    m_table[index] = entry;
+
+    return payload.size();
+}
+
+uint64_t RegionFile::getFileSize() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_fileSize;
+}
+
+RegionStore::RegionStore(std::filesystem::path directory) : m_directory(std::move(directory)) {
+    std::filesystem::create_directories(m_directory);
+}
+
+std::string RegionStore::getRegionFileName(int regionX, int regionZ) {
+    return "r." + std::to_string(regionX) + "." + std::to_string(regionZ) + ".ntr";
+}
+
+RegionFile* RegionStore::getRegion(int regionX, int regionZ, bool create) {
+    std::lock_guard<std::mutex> lock(m_regionsMutex);
+
+    uint64_t key = static_cast<uint64_t>(static_cast<uint32_t>(regionX)) << 32 | static_cast<uint32_t>(regionZ);
+    auto it      = m_regions.find(key);
+    if (it != m_regions.end() && (it->second || !create)) {
+        return it->second.get();
+    }
+
+    std::filesystem::path path = m_directory / getRegionFileName(regionX, regionZ);
+    if (!create && !std::filesystem::exists(path)) {
+        m_regions[key] = nullptr;
+        return nullptr;
+    }
+
+    std::unique_ptr<RegionFile> region;
+    try {
+        region = std::make_unique<RegionFile>(path.string());
+    } catch (...) {
+        // report an unreadable file once; later loads treat its chunks as missing
+        if (!create) m_regions[key] = nullptr;
+        throw;
+    }
+
+    RegionFile* raw = region.get();
+    m_regions[key]  = std::move(region);
+    return raw;
+}
+
+bool RegionStore::loadChunk(int chunkX, int chunkZ, game::chuck::VoxelChunk& chunk) {
+    // >> rounds towards negative infinity, so chunk -1 is in region -1 at local 31
+    int regionX = chunkX >> 5, localX = chunkX & (RegionFile::SIZE - 1);
+    int regionZ = chunkZ >> 5, localZ = chunkZ & (RegionFile::SIZE - 1);
+    static_assert(RegionFile::SIZE == 32);
+
+    try {
+        RegionFile* region = getRegion(regionX, regionZ, false);
+        if (!region || !region->hasChunk(localX, localZ)) {
+            m_misses++;
+            return false;
+        }
+        if (region->loadChunk(localX, localZ, chunk)) {
+            m_loads++;
+            return true;
+        }
+        LOG_WARN("Stored chunk (", chunkX, ", ", chunkZ, ") is malformed; generating it again");
+    } catch (const std::exception& e) {
+        LOG_ERROR("Cannot load chunk (", chunkX, ", ", chunkZ, "): ", e.what());
+    }
+
+    m_failures++;
+    return false;
+}
+
+void RegionStore::saveChunk(int chunkX, int chunkZ, const game::chuck::VoxelChunk& chunk) {
+    RegionFile* region = getRegion(chunkX >> 5, chunkZ >> 5, true);
+    size_t bytes       = region->saveChunk(chunkX & (RegionFile::SIZE - 1), chunkZ & (RegionFile::SIZE - 1), chunk, m_codec);
+
+    m_saves++;
+    m_savedBytes += bytes;
+}
+
+RegionStoreStats RegionStore::getStats() {
+    RegionStoreStats stats;
+    stats.loads      = m_loads;
+    stats.misses     = m_misses;
+    stats.failures   = m_failures;
+    stats.saves      = m_saves;
+    stats.savedBytes = m_savedBytes;
+
+    std::lock_guard<std::mutex> lock(m_regionsMutex);
+    for (const auto& [key, region] : m_regions) {
+        if (region) stats.openRegions++;
+    }
+    return stats;
+}
+
+} // namespace game::storage
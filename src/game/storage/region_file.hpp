@@ -0,0 +1,169 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "game/chuck/voxel_chunk.hpp"
+#include "game/storage/chunk_codec.hpp"
+#include "utils/read_file/mapped_file.hpp"
+
+namespace game::storage {
+
+/**
+ * @brief One file holding up to SIZE x SIZE chunks
+ *
+ * Layout, all little-endian:
+ *
+ *   header   "NTRG", u32 version, 8 reserved bytes
+ *   table    CHUNKS entries of u32 offset, u32 length, index localZ * SIZE + localX;
+ *            length 0 means the chunk is not stored
+ *   payloads encodeChunk() bytes, in the order they were written
+ *
+ * Reads decode straight out of a shared read-only mapping, so loading a
+ * chunk is a table lookup plus a decode, with no read() copy. Writes
+ * append the payload with pwrite() and only then update the 8-byte table
+ * entry, so a crash mid-write leaves the previous version readable.
+ * Rewriting a chunk therefore leaves its old payload behind as garbage;
+ * the file only grows.
+ *
+ * Thread-safe: loads share a lock, saves take it exclusively.
+ */
+class RegionFile {
+    public:
+    static constexpr int SIZE              = 32;
+    static constexpr int CHUNKS            = SIZE * SIZE;
+    static constexpr uint32_t VERSION      = 1;
+    static constexpr size_t HEADER_SIZE    = 16;
+    static constexpr size_t TABLE_ENTRY    = 8;
+    static constexpr size_t PAYLOAD_OFFSET = HEADER_SIZE + CHUNKS * TABLE_ENTRY;
+
+    /**
+     * @brief Open a region file, creating an empty one if it does not exist
+     * @throws std::runtime_error on I/O errors or if the file is not a region file
+     */
+    explicit RegionFile(const std::string& path);
+    ~RegionFile();
+
+    RegionFile(const RegionFile&)            = delete;
+    RegionFile& operator=(const RegionFile&) = delete;
+
+    bool hasChunk(int localX, int localZ) const;
+
+    /**
+     * @brief Decode a stored chunk into chunk
+     * @return false if the chunk is not stored or its payload is malformed
+     */
+    bool loadChunk(int localX, int localZ, game::chuck::VoxelChunk& chunk);
+
+    /**
+     * @brief Store a chunk, replacing any earlier version
+     *
+     * The chunk should be compact()ed first; see serializeChunk().
+     * @return Payload size in bytes
+     * @throws std::runtime_error on write errors
+     */
+    size_t saveChunk(int localX, int localZ, const game::chuck::VoxelChunk& chunk, ChunkCodec codec);
+
+    uint64_t getFileSize() const;
+
+    private:
+    struct Entry {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+
+    std::string m_path;
+    int m_fd = -1;
+    uint64_t m_fileSize = 0;
+    std::array<Entry, CHUNKS> m_table;
+    utils::MappedFile m_mapping; // Remapped when a payload lies past its end
+    mutable std::shared_mutex m_mutex;
+
+    void readTable();
+    void writeAt(const uint8_t* data, size_t size, uint64_t offset);
+    static int getIndex(int localX, int localZ) { return localZ * SIZE + localX; }
+};
+
+/**
+ * @brief Counters of a RegionStore, accumulated since construction
+ */
+struct RegionStoreStats {
+    size_t loads        = 0; // Chunks decoded from disk
+    size_t misses       = 0; // Lookups of chunks that were not stored
+    size_t failures     = 0; // Stored chunks that failed to decode
+    size_t saves        = 0;
+    uint64_t savedBytes = 0;
+    size_t openRegions  = 0;
+};
+
+/**
+ * @brief A world directory of region files, addressed by chunk coordinate
+ *
+ * Region files are named r.<regionX>.<regionZ>.ntr and opened on first
+ * use; a region without a file is only created when one of its chunks is
+ * saved. Safe to call from any number of chunk workers.
+ */
+class RegionStore {
+    private:
+    std::filesystem::path m_directory;
+    std::mutex m_regionsMutex;
+    // nullptr: no file on disk yet, remembered so misses do not touch the file system
+    std::unordered_map<uint64_t, std::unique_ptr<RegionFile>> m_regions;
+
+    std::atomic<size_t> m_loads{ 0 };
+    std::atomic<size_t> m_misses{ 0 };
+    std::atomic<size_t> m_failures{ 0 };
+    std::atomic<size_t> m_saves{ 0 };
+    std::atomic<uint64_t> m_savedBytes{ 0 };
+    ChunkCodec m_codec = ChunkCodec::RLE_LZ;
+
+    RegionFile* getRegion(int regionX, int regionZ, bool create);
+
+    public:
+    /**
+     * @brief Use directory as the world directory, creating it if needed
+     * @throws std::filesystem::filesystem_error if it cannot be created
+     */
+    explicit RegionStore(std::filesystem::path directory);
+
+    /**
+     * @brief Load a chunk if it has been saved
+     *
+     * A file that cannot be opened or a payload that does not decode is
+     * logged and reported as missing, so the caller generates the chunk
+     * again instead of failing. After a failed decode the contents of
+     * chunk are unspecified; generate into a fresh chunk.
+     */
+    bool loadChunk(int chunkX, int chunkZ, game::chuck::VoxelChunk& chunk);
+
+    /**
+     * @brief Save a chunk, replacing any earlier version
+     * @throws std::runtime_error on I/O errors
+     */
+    void saveChunk(int chunkX, int chunkZ, const game::chuck::VoxelChunk& chunk);
+
+    /**
+     * @brief Codec for chunks saved from now on; set before workers start
+     *
+     * Chunks already on disk keep their codec and stay readable.
+     */
+    void setCodec(ChunkCodec codec) { m_codec = codec; }
+    ChunkCodec getCodec() const { return m_codec; }
+
+    RegionStoreStats getStats();
+
+    const std::filesystem::path& getDirectory() const { return m_directory; }
+
+    static std::string getRegionFileName(int regionX, int regionZ);
+};
+
+} // namespace game::storage
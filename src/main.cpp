@@ -6,28 +6,38 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <chrono>
 #include <exception>
 #include <iostream>
 #include <memory>
+#include <utility>
 
 #include "renderer/camera/camera.hpp"
 #include "renderer/mesh/frustum.hpp"
 #include "renderer/mesh/mesh.hpp"
 #include "renderer/render/instanced_block_renderer.hpp"
 #include "renderer/shader/shader.hpp"
-#include "renderer/texture/texture.hpp"
+#include "renderer/texture/texture_array.hpp"
 
+#include "game/blocks/block_texture_table.hpp"
 #include "game/blocks/blocks.hpp"
 #include "game/blocks/blocks_mesh_builder.hpp"
 #include "game/chuck/chuck_manager.hpp"
-#include "game/chuck/chunk_mesh_optimizer.hpp"
+#include "game/chuck/binary_greedy_mesher.hpp"
 #include "game/generator/terrain_generator.hpp"
+#include "game/storage/region_file.hpp"
 
 
 #include "utils/check.hpp"
 
 auto main(__attribute_maybe_unused__ int argc, __attribute_maybe_unused__ char** argv) -> int {
 
+    // 启动计时：从进程入口到第一帧、到第一帧出现地形
+    const auto startup_time = std::chrono::steady_clock::now();
+    auto ms_since_startup   = [&startup_time] {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startup_time).count();
+    };
+
     try {
 
         utils::log().setLevel(utils::LogLevel::DEBUG);
@@ -38,18 +48,27 @@ auto main(__attribute_maybe_unused__ int argc, __attribute_maybe_unused__ char**
         glfwInit();
 
         LOG_DEBUG("Set GLFW version");
-        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
         glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
+        // 优先 4.3 以便区块用 glMultiDrawElementsIndirect 一次绘制，不支持时回退到 3.3
         LOG_INFO("Creating game window");
-        std::shared_ptr<GLFWwindow> window(
-        glfwCreateWindow(1920, 1080, "National Technology", nullptr, nullptr),
-        [](GLFWwindow* win) {
+        GLFWwindow* rawWindow = nullptr;
+        for (auto [major, minor] : { std::pair{ 4, 3 }, std::pair{ 3, 3 } }) {
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, major);
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, minor);
+            rawWindow = glfwCreateWindow(1920, 1080, "National Technology", nullptr, nullptr);
+            if (rawWindow) {
+                LOG_INFO("Created OpenGL ", major, ".", minor, " context");
+                break;
+            }
+            LOG_WARN("OpenGL ", major, ".", minor, " context unavailable");
+        }
+        if (rawWindow == nullptr)
+            throw std::runtime_error("cannot create GL window");
+
+        std::shared_ptr<GLFWwindow> window(rawWindow, [](GLFWwindow* win) {
             glfwDestroyWindow(win);
         });
-        if (window == nullptr)
-            throw std::runtime_error("cannot create GL window");
 
         glfwMakeContextCurrent(window.get());
 
@@ -130,16 +149,12 @@ auto main(__attribute_maybe_unused__ int argc, __attribute_maybe_unused__ char**
             LOG_DEBUG("Shader created with ID: ", lighting_shader.get_id());
 
 
-            renderer::shader instanced_shader(
-            "resources/shaders/instanced/instanced.vert",
-            "resources/shaders/instanced/instanced.frag");
-            LOG_DEBUG("Shader created with ID: ", instanced_shader.get_id());
-
+            // 区块网格使用 8 字节打包顶点
+            renderer::shader chunk_shader(
+            "resources/shaders/chunk/chunk.vert",
+            "resources/shaders/chunk/chunk.frag");
+            LOG_DEBUG("Shader created with ID: ", chunk_shader.get_id());
 
-            // texture
-            LOG_INFO("Load texture atlas");
-            renderer::texture universe_atlas_texture("resources/textures/blocks/universe_block_atlas.png");
-            LOG_DEBUG("Texture loaded - ID: ", universe_atlas_texture.get_id(), ", Size: ", universe_atlas_texture.get_width(), "x", universe_atlas_texture.get_height());
 
             // block types
             LOG_INFO("Initializing block types");
@@ -155,15 +170,25 @@ auto main(__attribute_maybe_unused__ int argc, __attribute_maybe_unused__ char**
             terr_gen.setBaseHeight(30); // 提高基础高度
             terr_gen.setMaxHeight(40);  // 增加高度变化范围
             terr_gen.setWaterLevel(25); // 调整水面高度
-
-            LOG_INFO("Generating terrain...");
-            auto terrainBlocks = terr_gen.generateFlatTerrain(1024, 1024, 0, 0);
-            LOG_INFO("Generated ", terrainBlocks.size(), " terrain blocks");
+            terr_gen.setTerrainMode(game::generator::TerrainMode::HEIGHTMAP); // DENSITY: 3D 密度地形（悬崖、洞穴）
+            terr_gen.setBiomesEnabled(false); // true: 温度/湿度噪声决定的生物群系（沙漠、沼泽、山地等）
 
             // atlas metadata
-            LOG_INFO("Loading atlas metadata from JSON...");
+            LOG_INFO("Loading cooked atlas metadata...");
             renderer::TextureAtlas atlas;
-            atlas.loadFromJSON("resources/textures/blocks/universe_block_atlas.json");
+            atlas.loadFromBinary("resources/textures/blocks/universe_block_atlas.ntatlas");
+
+            // texture：图集按子纹理切成纹理数组，每个子纹理一层
+            // 优先用 texture_cook 预压缩的 KTX2（无需解码和生成 mipmap），不可用时退回解码 PNG
+            LOG_INFO("Load block textures");
+            std::unique_ptr<renderer::texture_array> block_texture_array;
+            try {
+                block_texture_array = std::make_unique<renderer::texture_array>("resources/textures/blocks/universe_block_atlas.ktx2");
+            } catch (const std::exception& e) {
+                LOG_WARN(e.what(), "; decoding the PNG atlas instead");
+                block_texture_array = std::make_unique<renderer::texture_array>("resources/textures/blocks/universe_block_atlas.png", atlas.getTextureSize());
+            }
+            LOG_DEBUG("Texture array loaded - ID: ", block_texture_array->get_id(), ", ", block_texture_array->get_layers(), " layers");
 
             if constexpr (false) {
 
@@ -180,10 +205,23 @@ auto main(__attribute_maybe_unused__ int argc, __attribute_maybe_unused__ char**
 
 
             // mesh builder
-            game::chuck::OptimizedChunkMeshBuilder meshBuilder(&atlas);
+            // 位掩码贪婪网格合并相邻的同类方块面；也可换成 GreedyMesher 或逐面的 OptimizedChunkMeshBuilder
+            // 方块每个面的子纹理在这里一次解析完，网格生成不再按名字查找
+            game::blocks::BlockTextureTable block_textures(atlas);
+            game::chuck::BinaryGreedyMesher mesher(&block_textures);
 
-            game::chuck::ChunkManager chunkManager(&meshBuilder, &terr_gen);
+            // 存档：已保存的区块直接读盘，新生成的区块随即写入；修改地形参数后需删除该目录才会重新生成
+            game::storage::RegionStore world_store("saves/world");
+            LOG_INFO("World directory: ", world_store.getDirectory().string());
+
+            game::chuck::ChunkManager chunkManager(&mesher, &terr_gen);
             chunkManager.setRenderDistance(8); // 8个区块的渲染距离
+            chunkManager.setWorldStore(&world_store);
+
+            // 地形全部由 ChunkManager 按区块生成；出生点附近先并行生成，其余在游戏中流式加载
+            constexpr int SPAWN_PREGEN_RADIUS = 4;
+            chunkManager.pregenerate(camera.position, SPAWN_PREGEN_RADIUS);
+            LOG_INFO("Spawn area ready after ", ms_since_startup(), " ms");
 
 
             LOG_SEPARATOR();
@@ -193,7 +231,14 @@ auto main(__attribute_maybe_unused__ int argc, __attribute_maybe_unused__ char**
             float last_frame_time  = 0.0f;
 
             __attribute_maybe_unused__ size_t frame_cnt = 0;
+            bool terrain_shown                          = false;
+
+            // 渲染统计：每 STATS_INTERVAL 帧输出一次平均 CPU 帧时间与绘制调用数
+            constexpr size_t STATS_INTERVAL = 120;
+            double cpu_frame_ms_total       = 0.0;
+
             while (!glfwWindowShouldClose(window.get())) {
+                double cpu_frame_start = glfwGetTime();
 
                 // frame time stat
                 float current_frame_time = glfwGetTime();
@@ -230,26 +275,54 @@ auto main(__attribute_maybe_unused__ int argc, __attribute_maybe_unused__ char**
                 GL_CHECK(glClearColor(0.2f, 0.3f, 0.3f, 1.0f));
                 GL_CHECK(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
 
-                universe_atlas_texture.bind(0);
+                block_texture_array->bind(0);
 
-                instanced_shader.activate();
-                instanced_shader.set("texture1", 0);
+                chunk_shader.activate();
+                chunk_shader.set("blockTextures", 0);
 
                 glm::mat4 view       = camera.getViewMatrix();
                 glm::mat4 projection = camera.getProjectionMatrix(1280.0f / 720.0f);
 
                 frustum.extractFromMatrix(projection * view);
 
-                instanced_shader.set("view", view);
-                instanced_shader.set("projection", projection);
-                instanced_shader.set("viewPos", camera.position);
-                instanced_shader.set("lightPos", glm::vec3(100.0f, 100.0f, 2.0f));
-                instanced_shader.set("lightColor", glm::vec3(1.0f, 1.0f, 1.0f));
+                chunk_shader.set("view", view);
+                chunk_shader.set("projection", projection);
+                chunk_shader.set("viewPos", camera.position);
+                chunk_shader.set("lightPos", glm::vec3(100.0f, 100.0f, 2.0f));
+                chunk_shader.set("lightColor", glm::vec3(1.0f, 1.0f, 1.0f));
 
                 chunkManager.render(frustum);
 
+                // CPU 帧时间不含 glfwSwapBuffers 中等待 GPU / 垂直同步的部分
+                cpu_frame_ms_total += (glfwGetTime() - cpu_frame_start) * 1000.0;
+                if (frame_cnt % STATS_INTERVAL == 0) {
+                    const auto& stats = chunkManager.getRenderStats();
+                    LOG_INFO("Render: ", stats.visibleChunks, " visible chunks, ", stats.drawCalls, " draw calls, ",
+                    stats.quads, " quads, CPU ", cpu_frame_ms_total / STATS_INTERVAL, " ms/frame");
+
+                    auto geometry = chunkManager.getGeometryStats();
+                    LOG_INFO("Chunk geometry: ", geometry.vertices.used * sizeof(renderer::ChunkVertex) / 1024, " / ",
+                    geometry.vertices.capacity * sizeof(renderer::ChunkVertex) / 1024, " KiB in ",
+                    geometry.vertices.allocations, " meshes, ", static_cast<int>(geometry.vertices.getFragmentation() * 100.0),
+                    "% fragmented, ", geometry.growths, " growths, ", geometry.defragmentations, " defragmentations");
+
+                    auto memory = chunkManager.getMemoryStats();
+                    LOG_INFO("Chunk voxels: ", memory.warmChunks, " chunks in ", memory.warmBytes / 1024, " KiB, ",
+                    memory.coldChunks, " cold chunks in ", memory.coldBytes / 1024, " KiB");
+                    cpu_frame_ms_total = 0.0;
+                }
+
                 glfwSwapBuffers(window.get());
                 glfwPollEvents();
+
+                if (frame_cnt == 1) {
+                    LOG_INFO("Time to first frame: ", ms_since_startup(), " ms");
+                }
+                // 网格在工作线程生成、按预算上传，所以地形通常晚几帧出现
+                if (!terrain_shown && chunkManager.getRenderStats().quads > 0) {
+                    terrain_shown = true;
+                    LOG_INFO("Time to first terrain frame: ", ms_since_startup(), " ms (frame ", frame_cnt, ")");
+                }
             }
 
             LOG_INFO("Exit game loop");
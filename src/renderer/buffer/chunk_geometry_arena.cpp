@@ -0,0 +1,244 @@
+#include "chunk_geometry_arena.hpp"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+
+#include "utils/logger/logger.hpp"
+
+namespace renderer {
+
+ChunkGeometryArena::ChunkGeometryArena(size_t initialVertexCapacity, double defragThreshold)
+: m_initial_capacity(std::max<size_t>(initialVertexCapacity, 4)), m_defrag_threshold(defragThreshold) {}
+
+ChunkGeometryArena::~ChunkGeometryArena() {
+    if (m_vao) glDeleteVertexArrays(1, &m_vao);
+    if (m_vbo) glDeleteBuffers(1, &m_vbo);
+    if (m_origin_vbo) glDeleteBuffers(1, &m_origin_vbo);
+    if (m_indirect_buffer) glDeleteBuffers(1, &m_indirect_buffer);
+}
+
+ChunkGeometryArena::Handle ChunkGeometryArena::allocate(const ChunkMeshData& mesh) {
+    if (mesh.empty()) return INVALID_HANDLE;
+
+    size_t count = mesh.vertices.size();
+
+    // the index buffer must exist before the first reallocate() binds it to the VAO
+    m_quad_indices.reserve(mesh.getQuadCount());
+
+    size_t offset = m_allocator.allocate(count);
+    if (offset == RangeAllocator::INVALID_OFFSET) {
+        size_t capacity = m_allocator.getCapacity();
+        size_t needed   = m_allocator.getStats().used + count;
+        size_t target   = capacity ? capacity * 2 : m_initial_capacity;
+        while (target < needed) target *= 2;
+
+        if (capacity) {
+            m_growths++;
+            LOG_INFO("Chunk geometry arena grows to ", target * sizeof(ChunkVertex) / (1024 * 1024), " MiB");
+        }
+
+        reallocate(target);
+        offset = m_allocator.allocate(count);
+    }
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_vbo);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, offset * sizeof(ChunkVertex), mesh.getByteSize(), mesh.vertices.data());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    Handle handle;
+    if (!m_free_handles.empty()) {
+        handle = m_free_handles.back();
+        m_free_handles.pop_back();
+    } else {
+        handle = static_cast<Handle>(m_ranges.size());
+        m_ranges.emplace_back();
+    }
+
+    m_ranges[handle] = Range{ offset, count };
+    return handle;
+}
+
+void ChunkGeometryArena::release(Handle handle) {
+    if (handle == INVALID_HANDLE) return;
+
+    Range& range = m_ranges[handle];
+    m_allocator.free(range.offset, range.count);
+    range = Range{};
+    m_free_handles.push_back(handle);
+}
+
+/**
+ * @brief Compact only when it buys a meaningfully larger contiguous range
+ *
+ * With little free space left the fragmentation ratio is noisy and the next
+ * failed allocation will grow (and thereby compact) the buffer anyway.
+ */
+void ChunkGeometryArena::maintain() {
+    RangeAllocatorStats stats = m_allocator.getStats();
+    if (stats.getFragmentation() <= m_defrag_threshold) return;
+    if (stats.getFree() < stats.capacity / 8) return;
+
+    LOG_DEBUG("Defragmenting chunk geometry arena: ", stats.freeRanges, " free ranges, ",
+    static_cast<int>(stats.getFragmentation() * 100.0), "% fragmented");
+
+    defragment();
+}
+
+void ChunkGeometryArena::defragment() {
+    if (!m_vbo) return;
+
+    m_defragmentations++;
+    reallocate(m_allocator.getCapacity());
+}
+
+size_t ChunkGeometryArena::draw(const std::vector<ChunkDraw>& draws) {
+    if (draws.empty() || !m_vao) return 0;
+
+    glBindVertexArray(m_vao);
+
+    if (!m_multi_draw_indirect) {
+        for (const auto& item : draws) {
+            const Range& range = m_ranges[item.mesh];
+            glVertexAttribI2i(1, item.origin.x, item.origin.y);
+            glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(range.count / 4 * 6), GL_UNSIGNED_INT, nullptr,
+            static_cast<GLint>(range.offset));
+        }
+        glBindVertexArray(0);
+        return draws.size();
+    }
+
+    // command i reads origin i through baseInstance
+    m_commands.clear();
+    m_origins.clear();
+    for (const auto& item : draws) {
+        const Range& range = m_ranges[item.mesh];
+        m_commands.push_back(DrawElementsIndirectCommand{
+        static_cast<uint32_t>(range.count / 4 * 6), 1, 0,
+        static_cast<int32_t>(range.offset), static_cast<uint32_t>(m_origins.size()) });
+        m_origins.push_back(item.origin);
+    }
+
+    // orphan and refill both streams; the previous frame's copies may still be in flight
+    glBindBuffer(GL_ARRAY_BUFFER, m_origin_vbo);
+    glBufferData(GL_ARRAY_BUFFER, m_origins.size() * sizeof(glm::ivec2), m_origins.data(), GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirect_buffer);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, m_commands.size() * sizeof(DrawElementsIndirectCommand),
+    m_commands.data(), GL_STREAM_DRAW);
+
+    glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, static_cast<GLsizei>(m_commands.size()), 0);
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    glBindVertexArray(0);
+    return 1;
+}
+
+ChunkGeometryStats ChunkGeometryArena::getStats() const {
+    ChunkGeometryStats stats;
+    stats.vertices         = m_allocator.getStats();
+    stats.growths          = m_growths;
+    stats.defragmentations = m_defragmentations;
+    return stats;
+}
+
+void ChunkGeometryArena::reallocate(size_t capacity) {
+    uint32_t buffer;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, capacity * sizeof(ChunkVertex), nullptr, GL_DYNAMIC_DRAW);
+
+    // live handles in buffer order, so neighbouring meshes stay neighbours
+    std::vector<Handle> live;
+    for (Handle handle = 0; handle < m_ranges.size(); handle++) {
+        if (m_ranges[handle].count) live.push_back(handle);
+    }
+    std::sort(live.begin(), live.end(), [this](Handle a, Handle b) {
+        return m_ranges[a].offset < m_ranges[b].offset;
+    });
+
+    RangeAllocator allocator(capacity);
+
+    if (m_vbo) {
+        glBindBuffer(GL_COPY_READ_BUFFER, m_vbo);
+
+        // ranges that were already contiguous are moved with a single copy
+        size_t runSrc = 0, runDst = 0, runSize = 0;
+        for (Handle handle : live) {
+            Range& range = m_ranges[handle];
+            size_t dst   = allocator.allocate(range.count);
+
+            if (runSize && range.offset == runSrc + runSize) {
+                runSize += range.count;
+            } else {
+                if (runSize) {
+                    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, runSrc * sizeof(ChunkVertex),
+                    runDst * sizeof(ChunkVertex), runSize * sizeof(ChunkVertex));
+                }
+                runSrc  = range.offset;
+                runDst  = dst;
+                runSize = range.count;
+            }
+
+            range.offset = dst;
+        }
+        if (runSize) {
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, runSrc * sizeof(ChunkVertex),
+            runDst * sizeof(ChunkVertex), runSize * sizeof(ChunkVertex));
+        }
+
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glDeleteBuffers(1, &m_vbo);
+    }
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    m_vbo       = buffer;
+    m_allocator = std::move(allocator);
+
+    if (!m_vao) createVertexArray();
+
+    // the attribute pointer captures the buffer, so it is re-specified on every reallocation
+    glBindVertexArray(m_vao);
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_quad_indices.getId());
+
+    // two 32-bit words handed to the shader as-is
+    glVertexAttribIPointer(0, 2, GL_UNSIGNED_INT, sizeof(ChunkVertex), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/**
+ * @brief Create the VAO once a GL context exists, and pick the draw path
+ *
+ * Attribute 1 carries the chunk origin. With multi-draw-indirect it is an
+ * instanced array, advanced once per command by baseInstance; without it
+ * the array stays disabled and draw() sets the attribute's constant value.
+ */
+void ChunkGeometryArena::createVertexArray() {
+    m_multi_draw_indirect = GLAD_GL_VERSION_4_3 != 0;
+    LOG_INFO("Chunk draw path: ", m_multi_draw_indirect ? "glMultiDrawElementsIndirect" : "one draw per chunk (GL 3.3)");
+
+    glGenVertexArrays(1, &m_vao);
+    glBindVertexArray(m_vao);
+
+    if (m_multi_draw_indirect) {
+        glGenBuffers(1, &m_origin_vbo);
+        glGenBuffers(1, &m_indirect_buffer);
+
+        glBindBuffer(GL_ARRAY_BUFFER, m_origin_vbo);
+        glVertexAttribIPointer(1, 2, GL_INT, sizeof(glm::ivec2), (void*)0);
+        glVertexAttribDivisor(1, 1);
+        glEnableVertexAttribArray(1);
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+} // namespace renderer
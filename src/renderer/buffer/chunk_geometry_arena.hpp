@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "renderer/buffer/quad_index_buffer.hpp"
+#include "renderer/buffer/range_allocator.hpp"
+#include "renderer/mesh/chunk_vertex.hpp"
+
+namespace renderer {
+
+/**
+ * @brief Arena usage, sizes in ChunkVertex units
+ */
+struct ChunkGeometryStats {
+    RangeAllocatorStats vertices;
+    size_t growths          = 0; // Times the vertex buffer was reallocated larger
+    size_t defragmentations = 0; // Times live ranges were compacted in place
+};
+
+/**
+ * @brief One visible chunk to draw this frame
+ */
+struct ChunkDraw {
+    uint32_t mesh;     // ChunkGeometryArena::Handle
+    glm::ivec2 origin; // World block coordinates of the chunk's (x, z) corner
+};
+
+/**
+ * @brief Layout of one command in GL_DRAW_INDIRECT_BUFFER, fixed by the GL spec
+ */
+struct DrawElementsIndirectCommand {
+    uint32_t count;
+    uint32_t instanceCount;
+    uint32_t firstIndex;
+    int32_t baseVertex;
+    uint32_t baseInstance;
+};
+
+/**
+ * @brief One shared vertex buffer holding the meshes of all chunks
+ *
+ * Chunks no longer own GL objects. A mesh is uploaded into a range of a
+ * single large VBO handed out by a RangeAllocator, and drawn with a base
+ * vertex so the shared QuadIndexBuffer serves every chunk. One VAO covers
+ * the whole arena, so drawing many chunks needs a single VAO bind.
+ *
+ * Callers hold a Handle rather than the raw range: compaction moves meshes,
+ * and only the arena's handle table has to be updated.
+ *
+ * On a GL 4.3 context a whole frame is one glMultiDrawElementsIndirect:
+ * every visible chunk becomes an indirect command, and its origin is read
+ * from an 8-byte per-instance attribute selected by the command's
+ * baseInstance. On GL 3.3 the same VAO is drawn chunk by chunk, with the
+ * origin set as a constant vertex attribute in between.
+ *
+ * GL objects are created on the first allocation, so the arena can be
+ * constructed without a GL context.
+ */
+class ChunkGeometryArena {
+    public:
+    using Handle = uint32_t;
+
+    static constexpr Handle INVALID_HANDLE = UINT32_MAX;
+
+    // 8 MiB of ChunkVertex, room for a few hundred typical chunks
+    static constexpr size_t DEFAULT_VERTEX_CAPACITY = 1 << 20;
+
+    /**
+     * @brief Location of one mesh inside the vertex buffer
+     */
+    struct Range {
+        size_t offset = 0; // First vertex
+        size_t count  = 0; // Vertex count, four per quad; 0 marks an unused handle
+    };
+
+    private:
+    uint32_t m_vao = 0;
+    uint32_t m_vbo = 0;
+    QuadIndexBuffer m_quad_indices;
+
+    // Multi-draw-indirect path, GL 4.3 only
+    bool m_multi_draw_indirect = false;
+    uint32_t m_origin_vbo      = 0;
+    uint32_t m_indirect_buffer = 0;
+    std::vector<DrawElementsIndirectCommand> m_commands; // Reused every frame
+    std::vector<glm::ivec2> m_origins;
+
+    RangeAllocator m_allocator;
+    std::vector<Range> m_ranges; // Indexed by handle
+    std::vector<Handle> m_free_handles;
+
+    size_t m_initial_capacity;
+    double m_defrag_threshold;
+    size_t m_growths          = 0;
+    size_t m_defragmentations = 0;
+
+    public:
+    /**
+     * @param initialVertexCapacity Size of the first vertex buffer, in vertices
+     * @param defragThreshold Fragmentation above which maintain() compacts the arena
+     */
+    explicit ChunkGeometryArena(size_t initialVertexCapacity = DEFAULT_VERTEX_CAPACITY,
+    double defragThreshold                                  = 0.5);
+
+    ChunkGeometryArena(const ChunkGeometryArena&)            = delete;
+    ChunkGeometryArena& operator=(const ChunkGeometryArena&) = delete;
+
+    ~ChunkGeometryArena();
+
+    /**
+     * @brief Upload a mesh into a free range, growing the buffer if none fits
+     * @return Handle to draw or release the mesh, INVALID_HANDLE for an empty mesh
+     */
+    Handle allocate(const ChunkMeshData& mesh);
+
+    /**
+     * @brief Return a mesh's range to the free list; INVALID_HANDLE is ignored
+     */
+    void release(Handle handle);
+
+    /**
+     * @brief Compact the arena if fragmentation exceeds the threshold
+     * Call once per frame, outside of any draw loop
+     */
+    void maintain();
+
+    /**
+     * @brief Move all live meshes to the front of a fresh buffer of the same size
+     */
+    void defragment();
+
+    /**
+     * @brief Draw a list of meshes with the bound chunk shader
+     * @return Number of GL draw calls issued: 1 with multi-draw-indirect, draws.size() otherwise
+     */
+    size_t draw(const std::vector<ChunkDraw>& draws);
+
+    bool usesMultiDrawIndirect() const { return m_multi_draw_indirect; }
+
+    const Range& getRange(Handle handle) const { return m_ranges[handle]; }
+
+    ChunkGeometryStats getStats() const;
+
+    private:
+    /**
+     * @brief Replace the vertex buffer with one of the given capacity
+     *
+     * Live meshes are copied GPU-side in offset order and packed to the
+     * front, so every reallocation also removes all fragmentation.
+     */
+    void reallocate(size_t capacity);
+
+    void createVertexArray();
+};
+
+} // namespace renderer
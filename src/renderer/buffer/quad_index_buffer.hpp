@@ -0,0 +1,55 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace renderer {
+
+// 所有区块共用的四边形索引缓冲：第 q 个四边形为 4q + (0, 1, 2, 0, 2, 3)
+// 区块网格因此不再携带索引；容量不足时原地扩容，已绑定它的 VAO 无需更新
+// 注意：首次 reserve() 之后 getId() 才非零
+class QuadIndexBuffer {
+    private:
+    uint32_t EBO        = 0;
+    size_t quadCapacity = 0;
+
+    public:
+    QuadIndexBuffer() = default;
+    QuadIndexBuffer(const QuadIndexBuffer&) = delete;
+    QuadIndexBuffer& operator=(const QuadIndexBuffer&) = delete;
+
+    ~QuadIndexBuffer() {
+        if (EBO) glDeleteBuffers(1, &EBO);
+    }
+
+    // 首次调用时才创建 GL 缓冲，没有 GL 上下文的工具可以安全构造
+    void reserve(size_t quadCount) {
+        if (quadCount <= quadCapacity) return;
+
+        size_t capacity = std::max(quadCount, quadCapacity * 2);
+        std::vector<uint32_t> indices;
+        indices.reserve(capacity * 6);
+        for (uint32_t q = 0; q < capacity; q++) {
+            for (uint32_t i : { 0u, 1u, 2u, 0u, 2u, 3u }) {
+                indices.push_back(q * 4 + i);
+            }
+        }
+
+        if (!EBO) glGenBuffers(1, &EBO);
+
+        // 用 COPY_WRITE 目标上传，不改动当前 VAO 的索引缓冲绑定
+        glBindBuffer(GL_COPY_WRITE_BUFFER, EBO);
+        glBufferData(GL_COPY_WRITE_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+        quadCapacity = capacity;
+    }
+
+    uint32_t getId() const { return EBO; }
+    size_t getQuadCapacity() const { return quadCapacity; }
+};
+
+} // namespace renderer
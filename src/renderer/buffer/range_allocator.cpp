@@ -0,0 +1,98 @@
+#include "range_allocator.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+namespace renderer {
+
+RangeAllocator::RangeAllocator(size_t capacity) : m_capacity(capacity) {
+    if (capacity > 0) {
+        m_free_ranges.emplace(0, capacity);
+    }
+}
+
+/**
+ * @brief Best-fit allocation
+ *
+ * Picking the smallest range that fits keeps large ranges intact for large
+ * meshes; an exact fit removes the free range entirely.
+ */
+size_t RangeAllocator::allocate(size_t size) {
+    if (size == 0) return INVALID_OFFSET;
+
+    auto best = m_free_ranges.end();
+    for (auto it = m_free_ranges.begin(); it != m_free_ranges.end(); ++it) {
+        if (it->second < size) continue;
+        if (best == m_free_ranges.end() || it->second < best->second) {
+            best = it;
+            if (best->second == size) break;
+        }
+    }
+
+    if (best == m_free_ranges.end()) return INVALID_OFFSET;
+
+    size_t offset    = best->first;
+    size_t remaining = best->second - size;
+    m_free_ranges.erase(best);
+    if (remaining > 0) {
+        m_free_ranges.emplace(offset + size, remaining);
+    }
+
+    m_used += size;
+    m_allocations++;
+    return offset;
+}
+
+/**
+ * @brief Free a range and merge it with adjacent free ranges
+ */
+void RangeAllocator::free(size_t offset, size_t size) {
+    if (size == 0) return;
+    if (offset > m_capacity || size > m_capacity - offset) {
+        throw std::runtime_error("RangeAllocator: freed range lies outside the capacity");
+    }
+
+    auto next = m_free_ranges.lower_bound(offset);
+    if (next != m_free_ranges.end() && next->first < offset + size) {
+        throw std::runtime_error("RangeAllocator: freed range overlaps free space");
+    }
+
+    auto prev = next == m_free_ranges.begin() ? m_free_ranges.end() : std::prev(next);
+    if (prev != m_free_ranges.end() && prev->first + prev->second > offset) {
+        throw std::runtime_error("RangeAllocator: freed range overlaps free space");
+    }
+
+    m_used -= size;
+    m_allocations--;
+
+    // merge with the following range
+    if (next != m_free_ranges.end() && next->first == offset + size) {
+        size += next->second;
+        m_free_ranges.erase(next);
+    }
+
+    // merge with the preceding range
+    if (prev != m_free_ranges.end() && prev->first + prev->second == offset) {
+        prev->second += size;
+        return;
+    }
+
+    m_free_ranges.emplace(offset, size);
+}
+
+RangeAllocatorStats RangeAllocator::getStats() const {
+    RangeAllocatorStats stats;
+    stats.capacity    = m_capacity;
+    stats.used        = m_used;
+    stats.allocations = m_allocations;
+    stats.freeRanges  = m_free_ranges.size();
+
+    for (const auto& [offset, size] : m_free_ranges) {
+        stats.largestFree = std::max(stats.largestFree, size);
+    }
+
+    return stats;
+}
+
+} // namespace renderer
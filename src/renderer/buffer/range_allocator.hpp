@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+namespace renderer {
+
+/**
+ * @brief Occupancy and fragmentation snapshot of a RangeAllocator
+ * All sizes are in the allocator's units (e.g. vertices, not bytes)
+ */
+struct RangeAllocatorStats {
+    size_t capacity    = 0; // Total units managed
+    size_t used        = 0; // Units held by live allocations
+    size_t allocations = 0; // Number of live allocations
+    size_t freeRanges  = 0; // Number of disjoint free ranges
+    size_t largestFree = 0; // Size of the largest free range
+
+    size_t getFree() const { return capacity - used; }
+
+    double getOccupancy() const {
+        return capacity ? static_cast<double>(used) / capacity : 0.0;
+    }
+
+    /**
+     * @brief Share of free space that is not part of the largest free range
+     * @return 0 when all free space is contiguous, approaching 1 as it splinters
+     */
+    double getFragmentation() const {
+        size_t free = getFree();
+        return free ? 1.0 - static_cast<double>(largestFree) / free : 0.0;
+    }
+};
+
+/**
+ * @brief Free-list suballocator for ranges of a fixed-size linear resource
+ *
+ * Knows nothing about GPU buffers: it only hands out [offset, offset + size)
+ * ranges of [0, capacity). Allocation is best-fit over the free list, and
+ * freed ranges are coalesced with their neighbours immediately, so two free
+ * ranges are never adjacent.
+ */
+class RangeAllocator {
+    private:
+    std::map<size_t, size_t> m_free_ranges; // offset -> size, sorted by offset
+    size_t m_capacity    = 0;
+    size_t m_used        = 0;
+    size_t m_allocations = 0;
+
+    public:
+    static constexpr size_t INVALID_OFFSET = SIZE_MAX;
+
+    explicit RangeAllocator(size_t capacity = 0);
+
+    /**
+     * @brief Reserve a range of the given size
+     * @param size Number of units, must be non-zero
+     * @return Offset of the range, or INVALID_OFFSET if no free range is large enough
+     */
+    size_t allocate(size_t size);
+
+    /**
+     * @brief Return a range obtained from allocate()
+     * @throws std::runtime_error if the range overlaps free space or lies outside the capacity
+     */
+    void free(size_t offset, size_t size);
+
+    size_t getCapacity() const { return m_capacity; }
+
+    /**
+     * @brief Compute occupancy and fragmentation, O(number of free ranges)
+     */
+    RangeAllocatorStats getStats() const;
+};
+
+} // namespace renderer
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace renderer {
+
+/**
+ * @brief Packed 8-byte vertex for chunk meshes
+ *
+ * Chunk-local corner positions are integers in [0, 16] x [0, 256] x [0, 16],
+ * the normal is one of the six block faces and the texture is a layer of the
+ * block texture array, so the whole vertex fits in two 32-bit words:
+ *
+ *   position: x (5 bits) | y (9 bits) | z (5 bits) | face (3 bits)
+ *   texture:  texture array layer (16 bits)
+ *
+ * Texture coordinates are not stored; the chunk shader derives them from the
+ * position and face in block units, and the layer's GL_REPEAT wrapping tiles
+ * the texture across merged quads.
+ * Meshes carry no indices either, see QuadIndexBuffer.
+ */
+struct ChunkVertex {
+    uint32_t position;
+    uint32_t texture;
+
+    static constexpr int X_SHIFT    = 0;
+    static constexpr int Y_SHIFT    = 5;
+    static constexpr int Z_SHIFT    = 14;
+    static constexpr int FACE_SHIFT = 19;
+
+    static ChunkVertex pack(const glm::ivec3& pos, int face, uint16_t layer) {
+        return ChunkVertex{
+            static_cast<uint32_t>(pos.x) << X_SHIFT |
+            static_cast<uint32_t>(pos.y) << Y_SHIFT |
+            static_cast<uint32_t>(pos.z) << Z_SHIFT |
+            static_cast<uint32_t>(face) << FACE_SHIFT,
+            layer
+        };
+    }
+
+    glm::ivec3 getPosition() const {
+        return glm::ivec3((position >> X_SHIFT) & 31u, (position >> Y_SHIFT) & 511u, (position >> Z_SHIFT) & 31u);
+    }
+
+    int getFace() const { return static_cast<int>((position >> FACE_SHIFT) & 7u); }
+
+    uint16_t getLayer() const { return static_cast<uint16_t>(texture & 0xFFFFu); }
+};
+
+static_assert(sizeof(ChunkVertex) == 8, "ChunkVertex must stay 8 bytes");
+
+/**
+ * @brief CPU-side mesh of one chunk: four ChunkVertex per quad
+ *
+ * Quads are drawn with the shared (0, 1, 2, 0, 2, 3) index pattern, so the
+ * corners must be given in winding order.
+ */
+struct ChunkMeshData {
+    std::vector<ChunkVertex> vertices;
+
+    void addQuad(const std::array<glm::ivec3, 4>& corners, int face, uint16_t layer) {
+        for (const auto& corner : corners) {
+            vertices.push_back(ChunkVertex::pack(corner, face, layer));
+        }
+    }
+
+    size_t getQuadCount() const { return vertices.size() / 4; }
+    size_t getByteSize() const { return vertices.size() * sizeof(ChunkVertex); }
+    bool empty() const { return vertices.empty(); }
+};
+
+} // namespace renderer
@@ -132,15 +132,11 @@ const glm::vec3& v2,
 const glm::vec3& v3,
 const glm::vec3& normal) {
 
-    // 打包纹理边界
-    glm::vec4 bounds(uv.min.x, uv.min.y, uv.max.x, uv.max.y);
-
     uint32_t base = mesh.vertices.size();
 
     // 添加4个顶点
     Vertex vert;
-    vert.normal        = normal;
-    vert.textureBounds = bounds; // 确保设置！
+    vert.normal = normal;
 
     vert.position = v0;
     vert.texCoord = glm::vec2(uv.min.x, uv.min.y);
@@ -18,7 +18,6 @@ struct Vertex {
     glm::vec3 position;
     glm::vec3 normal;
     glm::vec2 texCoord;
-    glm::vec4 textureBounds;
 };
 
 /**
@@ -0,0 +1,203 @@
+#include "ktx2_file.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include "utils/binary_io.hpp"
+
+namespace renderer {
+
+// KTX2 布局（Khronos KTX 2.0 规范，全部小端）：
+//   头部     12 字节标识, VkFormat, typeSize, 宽, 高, 深, 数组层数, 面数, mip 层数, 超压缩方案
+//   索引     DFD 偏移/长度, KVD 偏移/长度（u32），SGD 偏移/长度（u64）
+//   层索引   每层 mip 的 u64 偏移, 长度, 未压缩长度
+//   DFD      描述块压缩格式的 Basic Data Format Descriptor
+//   数据     从最小的 mip 到最大的 mip，每层按块大小对齐，层内依次是各数组层
+// 这里只写、也只接受：二维数组、单面、无超压缩、无键值数据的 BC1/BC3
+namespace {
+
+constexpr uint8_t IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+constexpr size_t HEADER_SIZE      = 80;
+constexpr size_t LEVEL_ENTRY_SIZE = 24;
+constexpr int MAX_LEVELS          = 16;
+
+bool is_supported(uint32_t vk_format) {
+    return vk_format == static_cast<uint32_t>(block_format::bc1) || vk_format == static_cast<uint32_t>(block_format::bc3);
+}
+
+// Basic DFD：颜色模型 BC1A/BC3，BT.709 原色，线性传递函数，4x4 块
+std::vector<uint8_t> make_dfd(block_format format) {
+    constexpr uint8_t MODEL_BC1A         = 128;
+    constexpr uint8_t MODEL_BC3          = 130;
+    constexpr uint8_t CHANNEL_BC1A_ALPHA = 1;
+    constexpr uint8_t CHANNEL_BC3_COLOR  = 0;
+    constexpr uint8_t CHANNEL_BC3_ALPHA  = 15;
+    constexpr uint8_t PRIMARIES_BT709    = 1;
+    constexpr uint8_t TRANSFER_LINEAR    = 1;
+
+    // BC1 一个 64 位样本；BC3 前 64 位 alpha，后 64 位颜色
+    struct sample {
+        uint16_t bit_offset;
+        uint8_t channel;
+    };
+    std::vector<sample> samples;
+    if (format == block_format::bc1) {
+        samples = { { 0, CHANNEL_BC1A_ALPHA } };
+    } else {
+        samples = { { 0, CHANNEL_BC3_ALPHA }, { 64, CHANNEL_BC3_COLOR } };
+    }
+
+    uint32_t block_size = 24 + 16 * static_cast<uint32_t>(samples.size());
+    std::vector<uint8_t> dfd;
+    utils::appendLE<uint32_t>(dfd, 4 + block_size);
+    utils::appendLE<uint32_t>(dfd, 0);                    // vendor Khronos, descriptor type basic
+    utils::appendLE<uint32_t>(dfd, 2 | block_size << 16); // version 2
+    dfd.insert(dfd.end(), { format == block_format::bc1 ? MODEL_BC1A : MODEL_BC3, PRIMARIES_BT709, TRANSFER_LINEAR, 0 });
+    dfd.insert(dfd.end(), { 3, 3, 0, 0 }); // 块尺寸 - 1
+    dfd.insert(dfd.end(), { static_cast<uint8_t>(get_block_bytes(format)), 0, 0, 0, 0, 0, 0, 0 });
+
+    for (const sample& s : samples) {
+        utils::appendLE<uint32_t>(dfd, s.bit_offset | 63u << 16 | uint32_t(s.channel) << 24);
+        utils::appendLE<uint32_t>(dfd, 0);
+        utils::appendLE<uint32_t>(dfd, 0);
+        utils::appendLE<uint32_t>(dfd, 0xFFFFFFFFu);
+    }
+    return dfd;
+}
+
+size_t align_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+auto get_block_bytes(block_format format) -> size_t {
+    return format == block_format::bc1 ? 8 : 16;
+}
+
+auto get_block_format_name(block_format format) -> const char* {
+    return format == block_format::bc1 ? "BC1" : "BC3";
+}
+
+auto get_level_bytes(block_format format, int width, int height, int level) -> size_t {
+    size_t blocks_x = (std::max(width >> level, 1) + 3) / 4;
+    size_t blocks_y = (std::max(height >> level, 1) + 3) / 4;
+    return blocks_x * blocks_y * get_block_bytes(format);
+}
+
+ktx2_file::ktx2_file(const std::string& path)
+: m_file(path), m_format(block_format::bc1), m_width(0), m_height(0), m_layers(0) {
+
+    const uint8_t* data = m_file.data();
+    size_t size         = m_file.size();
+    if (size < HEADER_SIZE || std::memcmp(data, IDENTIFIER, sizeof(IDENTIFIER)) != 0) {
+        throw std::runtime_error("Not a KTX2 file: " + path);
+    }
+
+    uint32_t vk_format   = utils::readLE<uint32_t>(data + 12);
+    uint32_t width       = utils::readLE<uint32_t>(data + 20);
+    uint32_t height      = utils::readLE<uint32_t>(data + 24);
+    uint32_t depth       = utils::readLE<uint32_t>(data + 28);
+    uint32_t layers      = utils::readLE<uint32_t>(data + 32);
+    uint32_t faces       = utils::readLE<uint32_t>(data + 36);
+    uint32_t level_count = utils::readLE<uint32_t>(data + 40);
+    uint32_t scheme      = utils::readLE<uint32_t>(data + 44);
+
+    if (!is_supported(vk_format)) {
+        throw std::runtime_error("KTX2 file " + path + " has VkFormat " + std::to_string(vk_format) + "; only BC1 and BC3 are supported");
+    }
+    if (scheme != 0) {
+        throw std::runtime_error("KTX2 file " + path + " is supercompressed; cook it without supercompression");
+    }
+    if (width == 0 || height == 0 || width > 16384 || height > 16384 || depth != 0 || faces != 1) {
+        throw std::runtime_error("KTX2 file " + path + " is not a 2D texture");
+    }
+    // 0 层表示“全部 mip 由运行时生成”，正好是这条路径要避免的
+    if (level_count == 0 || level_count > MAX_LEVELS || (std::max(width, height) >> (level_count - 1)) == 0) {
+        throw std::runtime_error("KTX2 file " + path + " has an invalid mip chain of " + std::to_string(level_count) + " levels");
+    }
+    if (size < HEADER_SIZE + size_t(level_count) * LEVEL_ENTRY_SIZE) {
+        throw std::runtime_error("Truncated KTX2 file: " + path);
+    }
+
+    m_format = static_cast<block_format>(vk_format);
+    m_width  = static_cast<int>(width);
+    m_height = static_cast<int>(height);
+    m_layers = static_cast<int>(std::max(layers, 1u));
+
+    m_levels.reserve(level_count);
+    for (uint32_t i = 0; i < level_count; i++) {
+        const uint8_t* entry = data + HEADER_SIZE + size_t(i) * LEVEL_ENTRY_SIZE;
+        uint64_t offset      = utils::readLE<uint64_t>(entry);
+        uint64_t length      = utils::readLE<uint64_t>(entry + 8);
+
+        uint64_t expected = uint64_t(get_level_bytes(m_format, m_width, m_height, static_cast<int>(i))) * m_layers;
+        if (length != expected || offset > size || length > size - offset) {
+            throw std::runtime_error("KTX2 file " + path + " has a damaged mip level " + std::to_string(i));
+        }
+        m_levels.push_back({ static_cast<size_t>(offset), static_cast<size_t>(length) });
+    }
+}
+
+void write_ktx2(const std::string& path, block_format format, int width, int height, int layers,
+const std::vector<std::vector<uint8_t>>& levels) {
+    for (size_t i = 0; i < levels.size(); i++) {
+        if (levels[i].size() != get_level_bytes(format, width, height, static_cast<int>(i)) * layers) {
+            throw std::invalid_argument("KTX2 mip level " + std::to_string(i) + " has the wrong size");
+        }
+    }
+
+    std::vector<uint8_t> dfd = make_dfd(format);
+    uint32_t level_count     = static_cast<uint32_t>(levels.size());
+    size_t dfd_offset        = HEADER_SIZE + levels.size() * LEVEL_ENTRY_SIZE;
+
+    // 数据从最小的 mip 开始，每层对齐到 lcm(块字节数, 4)，即块字节数
+    std::vector<size_t> offsets(levels.size());
+    size_t end = dfd_offset + dfd.size();
+    for (size_t i = levels.size(); i-- > 0;) {
+        offsets[i] = align_up(end, get_block_bytes(format));
+        end        = offsets[i] + levels[i].size();
+    }
+
+    std::vector<uint8_t> bytes(IDENTIFIER, IDENTIFIER + sizeof(IDENTIFIER));
+    utils::appendLE<uint32_t>(bytes, static_cast<uint32_t>(format));
+    utils::appendLE<uint32_t>(bytes, 1); // typeSize，块压缩格式为 1
+    utils::appendLE<uint32_t>(bytes, static_cast<uint32_t>(width));
+    utils::appendLE<uint32_t>(bytes, static_cast<uint32_t>(height));
+    utils::appendLE<uint32_t>(bytes, 0);
+    utils::appendLE<uint32_t>(bytes, static_cast<uint32_t>(layers));
+    utils::appendLE<uint32_t>(bytes, 1);
+    utils::appendLE<uint32_t>(bytes, level_count);
+    utils::appendLE<uint32_t>(bytes, 0);
+
+    utils::appendLE<uint32_t>(bytes, static_cast<uint32_t>(dfd_offset));
+    utils::appendLE<uint32_t>(bytes, static_cast<uint32_t>(dfd.size()));
+    utils::appendLE<uint32_t>(bytes, 0);
+    utils::appendLE<uint32_t>(bytes, 0);
+    utils::appendLE<uint64_t>(bytes, 0);
+    utils::appendLE<uint64_t>(bytes, 0);
+
+    for (size_t i = 0; i < levels.size(); i++) {
+        utils::appendLE<uint64_t>(bytes, offsets[i]);
+        utils::appendLE<uint64_t>(bytes, levels[i].size());
+        utils::appendLE<uint64_t>(bytes, levels[i].size());
+    }
+    bytes.insert(bytes.end(), dfd.begin(), dfd.end());
+
+    bytes.reserve(end);
+    for (size_t i = levels.size(); i-- > 0;) {
+        bytes.resize(offsets[i], 0);
+        bytes.insert(bytes.end(), levels[i].begin(), levels[i].end());
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!file) {
+        throw std::runtime_error("Failed to write KTX2 file: " + path);
+    }
+}
+
+} // namespace renderer
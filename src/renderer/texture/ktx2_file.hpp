@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "utils/read_file/mapped_file.hpp"
+
+namespace renderer {
+
+// 支持的块压缩格式，取值即 KTX2 头部的 VkFormat
+enum class block_format : uint32_t {
+    bc1 = 133, // VK_FORMAT_BC1_RGBA_UNORM_BLOCK，8 字节/4x4 块，1 位 alpha
+    bc3 = 137, // VK_FORMAT_BC3_UNORM_BLOCK，16 字节/4x4 块，8 位 alpha
+};
+
+auto get_block_bytes(block_format format) -> size_t;
+auto get_block_format_name(block_format format) -> const char*;
+
+// 第 level 层 mip 中一个数组层的字节数；不足 4x4 的 mip 仍占一个完整块
+auto get_level_bytes(block_format format, int width, int height, int level) -> size_t;
+
+/**
+ * 只读映射的 KTX2 纹理数组：块压缩、预先生成的 mip 链、无超压缩
+ *
+ * 构造时校验头部和每层 mip 的位置与大小，之后各层数据直接指向映射的文件，
+ * 可原样交给 glCompressedTexImage3D。文件不合法时抛出 std::runtime_error。
+ */
+class ktx2_file {
+    private:
+    struct level {
+        size_t offset;
+        size_t size;
+    };
+
+    utils::MappedFile m_file;
+    block_format m_format;
+    int m_width;
+    int m_height;
+    int m_layers;
+    std::vector<level> m_levels;
+
+    public:
+    explicit ktx2_file(const std::string& path);
+
+    auto get_format() const -> block_format { return m_format; }
+    auto get_width() const -> int { return m_width; }
+    auto get_height() const -> int { return m_height; }
+    auto get_layers() const -> int { return m_layers; }
+    auto get_level_count() const -> int { return static_cast<int>(m_levels.size()); }
+
+    // 第 level 层 mip，所有数组层依次排列
+    auto get_level_data(int level) const -> const uint8_t* { return m_file.data() + m_levels[level].offset; }
+    auto get_level_size(int level) const -> size_t { return m_levels[level].size; }
+};
+
+/**
+ * 写出 ktx2_file 读取的 KTX2 文件
+ *
+ * levels[i] 为第 i 层 mip（0 为原尺寸），每层包含 layers 个数组层的压缩块，
+ * 大小须等于 get_level_bytes() * layers。
+ */
+void write_ktx2(const std::string& path, block_format format, int width, int height, int layers,
+const std::vector<std::vector<uint8_t>>& levels);
+
+} // namespace renderer
@@ -0,0 +1,154 @@
+#include "texture_array.hpp"
+
+#include <stb/stb_image.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "ktx2_file.hpp"
+#include "utils/logger/logger.hpp"
+
+namespace renderer {
+
+namespace {
+
+// EXT_texture_compression_s3tc：桌面驱动普遍支持，但不是核心功能，glad 没有生成这些常量
+constexpr GLenum COMPRESSED_RGBA_S3TC_DXT1 = 0x83F1;
+constexpr GLenum COMPRESSED_RGBA_S3TC_DXT5 = 0x83F3;
+
+bool has_extension(const char* name) {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; i++) {
+        const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+        if (extension && std::strcmp(extension, name) == 0) return true;
+    }
+    return false;
+}
+
+void check_layers(const std::string& path, int layers) {
+    GLint max_layers = 0;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &max_layers);
+    if (layers > max_layers) {
+        throw std::runtime_error("Atlas " + path + " has " + std::to_string(layers) +
+        " tiles, more than the " + std::to_string(max_layers) + " texture array layers this GPU supports");
+    }
+}
+
+// 每层各自重复；放大保持 MC 风格的最近邻，缩小时在 mipmap 间插值以消除远处闪烁
+void set_parameters() {
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+}
+
+} // namespace
+
+texture_array::texture_array(const std::string& atlas_path, int tile_size, bool flip)
+: m_id(0), m_tile_size(tile_size), m_layers(0) {
+
+    stbi_set_flip_vertically_on_load(flip);
+
+    int width = 0, height = 0, channels = 0;
+    unsigned char* data = stbi_load(atlas_path.c_str(), &width, &height, &channels, 4);
+    if (!data) {
+        throw std::runtime_error("Failed to load texture: " + atlas_path);
+    }
+
+    if (tile_size <= 0 || width % tile_size != 0 || height % tile_size != 0) {
+        stbi_image_free(data);
+        throw std::runtime_error("Atlas " + atlas_path + " is not a whole number of " + std::to_string(tile_size) + "px tiles");
+    }
+
+    int columns = width / tile_size;
+    int rows    = height / tile_size;
+    m_layers    = columns * rows;
+
+    try {
+        check_layers(atlas_path, m_layers);
+    } catch (...) {
+        stbi_image_free(data);
+        throw;
+    }
+
+    // 逐层连续存放：第 row * columns + column 层取图像中对应的 tile_size x tile_size 块
+    size_t tile_row_bytes = static_cast<size_t>(tile_size) * 4;
+    std::vector<unsigned char> layers(static_cast<size_t>(m_layers) * tile_size * tile_row_bytes);
+    for (int row = 0; row < rows; row++) {
+        for (int column = 0; column < columns; column++) {
+            unsigned char* layer = layers.data() + static_cast<size_t>(row * columns + column) * tile_size * tile_row_bytes;
+            for (int y = 0; y < tile_size; y++) {
+                const unsigned char* src = data + (static_cast<size_t>(row * tile_size + y) * width + column * tile_size) * 4;
+                std::memcpy(layer + y * tile_row_bytes, src, tile_row_bytes);
+            }
+        }
+    }
+    stbi_image_free(data);
+
+    LOG_DEBUG("Loaded texture array: ", atlas_path, " (", m_layers, " layers of ", tile_size, "x", tile_size, ")");
+
+    glGenTextures(1, &m_id);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_id);
+
+    set_parameters();
+
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, tile_size, tile_size, m_layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, layers.data());
+
+    // 逐层缩小，mipmap 只包含本层的像素
+    glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+texture_array::texture_array(const std::string& ktx2_path) : m_id(0), m_tile_size(0), m_layers(0) {
+    ktx2_file file(ktx2_path);
+
+    if (!has_extension("GL_EXT_texture_compression_s3tc")) {
+        throw std::runtime_error("Cannot load " + ktx2_path + ": the driver does not support S3TC (BC1/BC3) textures");
+    }
+    check_layers(ktx2_path, file.get_layers());
+
+    m_tile_size = file.get_width();
+    m_layers    = file.get_layers();
+
+    GLenum internal_format = file.get_format() == block_format::bc1 ? COMPRESSED_RGBA_S3TC_DXT1 : COMPRESSED_RGBA_S3TC_DXT5;
+
+    glGenTextures(1, &m_id);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_id);
+    set_parameters();
+
+    // mip 链完全来自文件：不生成 mipmap，并把可用层数限制在文件里有的层
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, file.get_level_count() - 1);
+
+    for (int level = 0; level < file.get_level_count(); level++) {
+        glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, level, internal_format,
+        std::max(file.get_width() >> level, 1), std::max(file.get_height() >> level, 1), m_layers, 0,
+        static_cast<GLsizei>(file.get_level_size(level)), file.get_level_data(level));
+    }
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    LOG_DEBUG("Loaded texture array: ", ktx2_path, " (", m_layers, " layers of ", m_tile_size, "x", file.get_height(),
+    ", ", get_block_format_name(file.get_format()), ", ", file.get_level_count(), " mip levels)");
+}
+
+texture_array::~texture_array() {
+    if (m_id != 0) {
+        glDeleteTextures(1, &m_id);
+    }
+}
+
+auto texture_array::bind(uint32_t slot) -> void {
+    glActiveTexture(GL_TEXTURE0 + slot);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_id);
+}
+
+auto texture_array::unbind() -> void {
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+} // namespace renderer
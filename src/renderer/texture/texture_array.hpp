@@ -0,0 +1,43 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <string>
+
+namespace renderer {
+
+/**
+ * 把图集切成 GL_TEXTURE_2D_ARRAY，每个子纹理一层
+ *
+ * 第 row * 每行子纹理数 + column 层是 UV 网格中第 column 列、第 row 行（自下而上）的子纹理，
+ * 与 TextureAtlas::getLayer() 一致。每层单独重复（GL_REPEAT）并单独生成 mipmap，
+ * 合并面直接用以方块为单位的 UV 平铺，不会采样到相邻的子纹理。
+ *
+ * 两种来源：PNG 图集（主线程解码、切片、glGenerateMipmap，每像素 4 字节），
+ * 或 texture_cook 预先切好、压缩并生成 mip 链的 KTX2 文件（映射后直接上传，不解码也不生成 mipmap）。
+ */
+class texture_array {
+    private:
+    uint32_t m_id;
+
+    int m_tile_size;
+    int m_layers;
+
+    public:
+    texture_array(const std::string& atlas_path, int tile_size, bool flip = true);
+
+    // 加载 texture_cook 生成的 BC1/BC3 KTX2；驱动不支持 S3TC 时抛出 std::runtime_error，调用方可退回 PNG
+    explicit texture_array(const std::string& ktx2_path);
+    ~texture_array();
+
+    texture_array(const texture_array&)            = delete;
+    texture_array& operator=(const texture_array&) = delete;
+
+    auto bind(uint32_t slot = 0) -> void;
+    auto unbind() -> void;
+
+    auto get_id() const -> uint32_t { return m_id; }
+    auto get_tile_size() const -> int { return m_tile_size; }
+    auto get_layers() const -> int { return m_layers; }
+};
+
+} // namespace renderer
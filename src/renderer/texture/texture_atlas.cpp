@@ -0,0 +1,116 @@
+#include "texture_atlas.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include "utils/binary_io.hpp"
+#include "utils/read_file/mapped_file.hpp"
+
+namespace renderer {
+
+// 二进制图集元数据，全部小端：
+//   头部   "NTAT", u32 版本, u32 子纹理尺寸, u32 图集尺寸, u32 每行子纹理数, u32 纹理数
+//   纹理表 每个纹理 24 字节：u32 名字偏移, u32 名字长度, f32 min u / min v / max u / max v，按名字排序
+//   名字区 所有名字依次拼接，偏移从名字区开头算起
+namespace {
+
+constexpr uint8_t MAGIC[4]   = { 'N', 'T', 'A', 'T' };
+constexpr uint32_t VERSION   = 1;
+constexpr size_t HEADER_SIZE = 24;
+constexpr size_t ENTRY_SIZE  = 24;
+
+float readFloat(const uint8_t* in) {
+    return std::bit_cast<float>(utils::readLE<uint32_t>(in));
+}
+
+void appendFloat(std::vector<uint8_t>& out, float value) {
+    utils::appendLE<uint32_t>(out, std::bit_cast<uint32_t>(value));
+}
+
+} // namespace
+
+void TextureAtlas::loadFromBinary(const std::string& binary_path) {
+    utils::MappedFile file(binary_path);
+    const uint8_t* data = file.data();
+    size_t size         = file.size();
+
+    if (size < HEADER_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Not a cooked texture atlas: " + binary_path);
+    }
+    uint32_t version = utils::readLE<uint32_t>(data + 4);
+    if (version != VERSION) {
+        throw std::runtime_error("Unsupported cooked texture atlas version " + std::to_string(version) + ": " + binary_path);
+    }
+
+    uint32_t count = utils::readLE<uint32_t>(data + 20);
+    if (count > (size - HEADER_SIZE) / ENTRY_SIZE) {
+        throw std::runtime_error("Truncated cooked texture atlas: " + binary_path);
+    }
+
+    const uint8_t* entries = data + HEADER_SIZE;
+    const char* names      = reinterpret_cast<const char*>(entries + size_t(count) * ENTRY_SIZE);
+    size_t namesSize       = size - HEADER_SIZE - size_t(count) * ENTRY_SIZE;
+
+    std::unordered_map<std::string, TextureUV> uvs;
+    uvs.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+        const uint8_t* entry = entries + size_t(i) * ENTRY_SIZE;
+        uint32_t offset      = utils::readLE<uint32_t>(entry);
+        uint32_t length      = utils::readLE<uint32_t>(entry + 4);
+        if (offset > namesSize || length > namesSize - offset) {
+            throw std::runtime_error("Cooked texture atlas has a name outside the file: " + binary_path);
+        }
+
+        uvs.emplace(std::string(names + offset, length),
+        TextureUV(readFloat(entry + 8), readFloat(entry + 12), readFloat(entry + 16), readFloat(entry + 20)));
+    }
+
+    m_texture_size     = static_cast<int>(utils::readLE<uint32_t>(data + 8));
+    m_atlas_size       = static_cast<int>(utils::readLE<uint32_t>(data + 12));
+    m_textures_per_row = static_cast<int>(utils::readLE<uint32_t>(data + 16));
+    m_texture_uvs      = std::move(uvs);
+
+    LOG_INFO("Loaded ", m_texture_uvs.size(), " textures from cooked atlas ", binary_path);
+}
+
+void TextureAtlas::writeBinary(const std::string& binary_path) const {
+    std::vector<const std::pair<const std::string, TextureUV>*> sorted;
+    sorted.reserve(m_texture_uvs.size());
+    for (const auto& entry : m_texture_uvs) {
+        sorted.push_back(&entry);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+
+    std::vector<uint8_t> bytes(MAGIC, MAGIC + sizeof(MAGIC));
+    utils::appendLE<uint32_t>(bytes, VERSION);
+    utils::appendLE<uint32_t>(bytes, static_cast<uint32_t>(m_texture_size));
+    utils::appendLE<uint32_t>(bytes, static_cast<uint32_t>(m_atlas_size));
+    utils::appendLE<uint32_t>(bytes, static_cast<uint32_t>(m_textures_per_row));
+    utils::appendLE<uint32_t>(bytes, static_cast<uint32_t>(sorted.size()));
+
+    uint32_t offset = 0;
+    for (const auto* entry : sorted) {
+        utils::appendLE<uint32_t>(bytes, offset);
+        utils::appendLE<uint32_t>(bytes, static_cast<uint32_t>(entry->first.size()));
+        appendFloat(bytes, entry->second.min.x);
+        appendFloat(bytes, entry->second.min.y);
+        appendFloat(bytes, entry->second.max.x);
+        appendFloat(bytes, entry->second.max.y);
+        offset += static_cast<uint32_t>(entry->first.size());
+    }
+    for (const auto* entry : sorted) {
+        bytes.insert(bytes.end(), entry->first.begin(), entry->first.end());
+    }
+
+    std::ofstream file(binary_path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!file) {
+        throw std::runtime_error("Failed to write cooked texture atlas: " + binary_path);
+    }
+}
+
+} // namespace renderer
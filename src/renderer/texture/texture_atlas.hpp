@@ -1,13 +1,10 @@
 #pragma once
 
-#include <fstream>
+#include <cmath>
 #include <glm/glm.hpp>
-#include <iostream>
 #include <string>
 #include <unordered_map>
 
-#include <nlohmann/json.hpp>
-
 #include "utils/logger/logger.hpp"
 
 namespace renderer {
@@ -31,57 +28,25 @@ class TextureAtlas {
     public:
     TextureAtlas() : m_atlas_size(0), m_texture_size(0), m_textures_per_row(0) {}
 
-    // 从 JSON 文件加载纹理图集元数据
-    void loadFromJSON(const std::string& json_path) {
-        LOG_INFO("Loading texture atlas from JSON: ", json_path);
-
-        std::ifstream file(json_path);
-        if (!file.is_open()) {
-            throw std::runtime_error("Failed to open JSON file: " + json_path);
-        }
-
-        nlohmann::json j;
-        try {
-            file >> j;
-        } catch (const nlohmann::json::exception& e) {
-            throw std::runtime_error("Failed to parse JSON: " + std::string(e.what()));
-        }
-
-        // 读取基本信息
-        m_texture_size     = j["texture_size"].get<int>();
-        m_atlas_size       = j["atlas_size"].get<int>();
-        m_textures_per_row = j["textures_per_row"].get<int>();
-
-        LOG_DEBUG("Atlas metadata:");
-        LOG_DEBUG("  Atlas size: ", m_atlas_size, "x", m_atlas_size);
-        LOG_DEBUG("  Texture size: ", m_texture_size, "x", m_texture_size);
-        LOG_DEBUG("  Textures per row: ", m_textures_per_row);
-
-        // 读取所有纹理
-        const auto& textures = j["textures"];
-        LOG_DEBUG("Loading ", textures.size(), " textures:");
-
-        for (auto& [name, data] : textures.items()) {
-            // 读取 UV 坐标
-            float min_u = data["uv"]["min"][0].get<float>();
-            float min_v = data["uv"]["min"][1].get<float>();
-            float max_u = data["uv"]["max"][0].get<float>();
-            float max_v = data["uv"]["max"][1].get<float>();
-
-            m_texture_uvs[name] = TextureUV(min_u, min_v, max_u, max_v);
-
-            int index = data["index"].get<int>();
-            LOG_DEBUG("  [", index, "] '", name, "' UV: (", min_u, ",", min_v, ") -> (", max_u, ",", max_v, ")");
-        }
-
-
-        LOG_DEBUG("Atlas setup:");
-        LOG_DEBUG("  Atlas size: ", m_atlas_size, "x", m_atlas_size);
-        LOG_DEBUG("  Texture size: ", m_texture_size, "x", m_texture_size);
-        LOG_DEBUG("  Textures per row: ", m_textures_per_row);
-        LOG_DEBUG("  Max textures: ", m_textures_per_row * (m_atlas_size / m_texture_size));
+    /**
+     * 加载 atlas_cook 生成的二进制元数据：整个文件 mmap 一次，不解析 JSON
+     *
+     * 文件格式见 texture_atlas.cpp。文件损坏或版本不符时抛出 std::runtime_error。
+     */
+    void loadFromBinary(const std::string& binary_path);
+
+    // 写出 loadFromBinary() 读取的二进制元数据，纹理按名字排序，同样的输入总是得到同样的文件
+    void writeBinary(const std::string& binary_path) const;
+
+    // 离线工具从编辑格式（atlas_generator.py 输出的 JSON）构建图集时使用；引擎本身不解析 JSON
+    void setLayout(int atlas_size, int texture_size, int textures_per_row) {
+        m_atlas_size       = atlas_size;
+        m_texture_size     = texture_size;
+        m_textures_per_row = textures_per_row;
+    }
 
-        LOG_INFO("Successfully loaded ", m_texture_uvs.size(), " textures from atlas");
+    void addTexture(const std::string& name, const TextureUV& uv) {
+        m_texture_uvs[name] = uv;
     }
 
     TextureUV getUV(const std::string& name) const {
@@ -98,6 +63,15 @@ class TextureAtlas {
         return TextureUV();
     }
 
+    // 子纹理在 texture_array 中的层：UV 网格的行（自下而上）* 每行子纹理数 + 列
+    int getLayer(const std::string& name) const {
+        TextureUV uv = getUV(name);
+        float tiles  = static_cast<float>(m_atlas_size) / static_cast<float>(m_texture_size);
+        int column   = static_cast<int>(std::lround(uv.min.x * tiles));
+        int row      = static_cast<int>(std::lround(uv.min.y * tiles));
+        return row * m_textures_per_row + column;
+    }
+
     bool hasTexture(const std::string& name) const {
         return m_texture_uvs.find(name) != m_texture_uvs.end();
     }
@@ -106,6 +80,10 @@ class TextureAtlas {
         return m_texture_uvs.size();
     }
 
+    const std::unordered_map<std::string, TextureUV>& getTextures() const {
+        return m_texture_uvs;
+    }
+
     // 获取图集信息
     int getAtlasSize() const { return m_atlas_size; }
     int getTextureSize() const { return m_texture_size; }
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace utils {
+
+/**
+ * @brief Append an unsigned integer to a byte buffer, little-endian
+ *
+ * Written byte by byte, so files are identical on every host.
+ */
+template <typename T>
+inline void appendLE(std::vector<uint8_t>& out, T value) {
+    static_assert(std::is_unsigned_v<T>, "appendLE expects an unsigned integer");
+    for (size_t i = 0; i < sizeof(T); i++) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+/**
+ * @brief Read an unsigned little-endian integer; the caller checks bounds
+ */
+template <typename T>
+inline T readLE(const uint8_t* in) {
+    static_assert(std::is_unsigned_v<T>, "readLE expects an unsigned integer");
+    T value = 0;
+    for (size_t i = 0; i < sizeof(T); i++) {
+        value |= static_cast<T>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * @brief Append an unsigned integer as a LEB128 varint: 7 bits per byte, low bits first
+ */
+inline void appendVarint(std::vector<uint8_t>& out, uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+/**
+ * @brief Read a varint written by appendVarint(), advancing in
+ * @return false if the varint runs past end or does not fit in 32 bits
+ */
+inline bool readVarint(const uint8_t*& in, const uint8_t* end, uint32_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (in == end) return false;
+        uint8_t byte = *in++;
+        value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return shift < 28 || byte < 0x10;
+    }
+    return false;
+}
+
+/**
+ * @brief Incremental 64-bit FNV-1a hash, for cheap output fingerprints
+ */
+class Fnv1a64 {
+    private:
+    uint64_t m_hash = 14695981039346656037ull;
+
+    public:
+    void update(const uint8_t* data, size_t size) {
+        for (size_t i = 0; i < size; i++) {
+            m_hash = (m_hash ^ data[i]) * 1099511628211ull;
+        }
+    }
+
+    uint64_t value() const { return m_hash; }
+};
+
+} // namespace utils
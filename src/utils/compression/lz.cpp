@@ -0,0 +1,123 @@
+#include "lz.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace utils {
+
+namespace {
+
+constexpr size_t MIN_MATCH  = 4;
+constexpr size_t MAX_OFFSET = 0xffff;
+constexpr int HASH_BITS     = 12;
+
+uint32_t read32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+// token nibbles saturate at 15; the rest follows as 255-valued bytes and a remainder
+void appendLength(std::vector<uint8_t>& out, size_t length) {
+    for (length -= 15; length >= 255; length -= 255) {
+        out.push_back(255);
+    }
+    out.push_back(static_cast<uint8_t>(length));
+}
+
+bool readLength(const uint8_t*& in, const uint8_t* end, size_t& length) {
+    uint8_t byte;
+    do {
+        if (in == end) return false;
+        byte = *in++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+void appendSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literalCount,
+size_t offset, size_t matchLength) {
+    size_t matchCode = matchLength - MIN_MATCH;
+    out.push_back(static_cast<uint8_t>(std::min<size_t>(literalCount, 15) << 4 | std::min<size_t>(matchCode, 15)));
+    if (literalCount >= 15) appendLength(out, literalCount);
+    out.insert(out.end(), literals, literals + literalCount);
+
+    out.push_back(static_cast<uint8_t>(offset));
+    out.push_back(static_cast<uint8_t>(offset >> 8));
+    if (matchCode >= 15) appendLength(out, matchCode);
+}
+
+} // namespace
+
+void lzCompress(const uint8_t* data, size_t size, std::vector<uint8_t>& out) {
+    uint32_t table[1 << HASH_BITS] = {};
+
+    size_t anchor = 0, pos = 0;
+    while (pos + MIN_MATCH <= size) {
+        uint32_t sequence = read32(data + pos);
+        uint32_t hash     = (sequence * 2654435761u) >> (32 - HASH_BITS);
+        size_t candidate  = table[hash];
+        table[hash]       = static_cast<uint32_t>(pos);
+
+        if (candidate < pos && pos - candidate <= MAX_OFFSET && read32(data + candidate) == sequence) {
+            size_t length = MIN_MATCH;
+            while (pos + length < size && data[candidate + length] == data[pos + length]) {
+                length++;
+            }
+
+            appendSequence(out, data + anchor, pos - anchor, pos - candidate, length);
+            pos += length;
+            anchor = pos;
+        } else {
+            pos++;
+        }
+    }
+
+    // trailing literals, no match
+    size_t literalCount = size - anchor;
+    out.push_back(static_cast<uint8_t>(std::min<size_t>(literalCount, 15) << 4));
+    if (literalCount >= 15) appendLength(out, literalCount);
+    out.insert(out.end(), data + anchor, data + size);
+}
+
+bool lzDecompress(const uint8_t* data, size_t size, uint8_t* out, size_t rawSize) {
+    const uint8_t* in  = data;
+    const uint8_t* end = data + size;
+    size_t written     = 0;
+
+    while (true) {
+        if (in == end) return false;
+        uint8_t token = *in++;
+
+        size_t literalCount = token >> 4;
+        if (literalCount == 15 && !readLength(in, end, literalCount)) return false;
+        if (literalCount > static_cast<size_t>(end - in) || literalCount > rawSize - written) return false;
+        std::memcpy(out + written, in, literalCount);
+        in += literalCount;
+        written += literalCount;
+
+        if (in == end) return written == rawSize;
+
+        if (end - in < 2) return false;
+        size_t offset = in[0] | static_cast<size_t>(in[1]) << 8;
+        in += 2;
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !readLength(in, end, matchLength)) return false;
+        matchLength += MIN_MATCH;
+
+        if (offset == 0 || offset > written || matchLength > rawSize - written) return false;
+
+        // overlapping matches (offset < length) repeat the last offset bytes, so copy forwards
+        const uint8_t* from = out + written - offset;
+        if (offset >= matchLength) {
+            std::memcpy(out + written, from, matchLength);
+        } else {
+            for (size_t i = 0; i < matchLength; i++) {
+                out[written + i] = from[i];
+            }
+        }
+        written += matchLength;
+    }
+}
+
+} // namespace utils
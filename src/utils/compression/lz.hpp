@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace utils {
+
+/**
+ * @brief Compress a buffer with a small byte-oriented LZ77 codec, appending to out
+ *
+ * Greedy matching through a 4096-entry hash of 4-byte sequences, 64 KiB
+ * window. The format follows LZ4 blocks: each sequence is a token (4 bits
+ * literal count, 4 bits match length - 4, 15 extended by 255-run bytes),
+ * the literals, then a little-endian u16 offset and the match length
+ * extension; the last sequence has literals only.
+ *
+ * Aimed at buffers of a few KiB that are already entropy-light, such as
+ * encoded chunks: compression is one pass with no allocation besides out.
+ * The raw size is not stored; callers keep it next to the data.
+ */
+void lzCompress(const uint8_t* data, size_t size, std::vector<uint8_t>& out);
+
+/**
+ * @brief Decompress lzCompress() output into exactly rawSize bytes at out
+ * @return false if the input is malformed or does not produce exactly rawSize bytes
+ */
+bool lzDecompress(const uint8_t* data, size_t size, uint8_t* out, size_t rawSize);
+
+} // namespace utils
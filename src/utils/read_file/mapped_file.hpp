@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace utils {
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ *
+ * The mapping shares the page cache, so pages are read on first touch
+ * and writes made to the file through another descriptor show up in
+ * it. It does not grow with the file: map the file again to see bytes
+ * appended after construction. An empty file maps to (nullptr, 0).
+ */
+class MappedFile {
+    private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size         = 0;
+
+    void unmap();
+
+    public:
+    MappedFile() = default;
+
+    /**
+     * @brief Map the file at path
+     * @throws std::runtime_error if the file cannot be opened or mapped
+     */
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+};
+
+} // namespace utils
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utils {
+
+/**
+ * @brief Run body(index, worker) for every index in [0, count) on a set of threads
+ *
+ * Work stealing over index ranges: each thread starts with an equal,
+ * contiguous share and takes indices from its front. A thread whose
+ * share runs dry steals the back half of the largest remaining share, so
+ * uneven work per index (chunks with caves, mountains, water) keeps every
+ * thread busy until the very end without a shared queue.
+ *
+ * The calling thread works as worker 0; threadCount - 1 threads are
+ * started for the call and joined before it returns. Which worker runs
+ * an index is not deterministic, so body must only write state owned by
+ * its index (or by its worker). The first exception thrown by body is
+ * rethrown once all workers have stopped.
+ *
+ * @param count Number of indices
+ * @param threadCount Workers including the caller; 0 is treated as 1
+ * @param body Callable with signature void(size_t index, size_t worker)
+ * @return Number of successful steals, a measure of load imbalance
+ */
+template <typename F>
+size_t parallelFor(size_t count, size_t threadCount, F&& body) {
+    struct alignas(64) Share {
+        std::mutex mutex;
+        size_t begin = 0;
+        size_t end   = 0;
+    };
+
+    threadCount = std::max<size_t>(std::min(threadCount, count), 1);
+    auto shares = std::make_unique<Share[]>(threadCount);
+    for (size_t t = 0; t < threadCount; t++) {
+        shares[t].begin = count * t / threadCount;
+        shares[t].end   = count * (t + 1) / threadCount;
+    }
+
+    std::mutex errorMutex;
+    std::exception_ptr error;
+    std::atomic<size_t> steals{ 0 };
+
+    // Moves the back half of the fullest other share into self; false once all are empty
+    auto steal = [&](size_t self) {
+        while (true) {
+            size_t victim = self, most = 0;
+            for (size_t t = 0; t < threadCount; t++) {
+                if (t == self) continue;
+                std::lock_guard<std::mutex> lock(shares[t].mutex);
+                if (shares[t].end - shares[t].begin > most) {
+                    most   = shares[t].end - shares[t].begin;
+                    victim = t;
+                }
+            }
+            if (most == 0) return false;
+
+            size_t begin, end;
+            {
+                std::lock_guard<std::mutex> lock(shares[victim].mutex);
+                size_t remaining = shares[victim].end - shares[victim].begin;
+                if (remaining == 0) continue; // Drained since the scan; look again
+
+                end                = shares[victim].end;
+                begin              = end - (remaining + 1) / 2;
+                shares[victim].end = begin;
+            }
+
+            std::lock_guard<std::mutex> lock(shares[self].mutex);
+            shares[self].begin = begin;
+            shares[self].end   = end;
+            steals.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    };
+
+    auto run = [&](size_t self) {
+        try {
+            while (true) {
+                size_t index;
+                {
+                    std::lock_guard<std::mutex> lock(shares[self].mutex);
+                    index = shares[self].begin < shares[self].end ? shares[self].begin++ : count;
+                }
+                if (index < count) {
+                    body(index, self);
+                } else if (!steal(self)) {
+                    return;
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) error = std::current_exception();
+
+            // Drop the remaining work so the other workers stop soon
+            for (size_t t = 0; t < threadCount; t++) {
+                std::lock_guard<std::mutex> shareLock(shares[t].mutex);
+                shares[t].begin = shares[t].end;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (size_t t = 1; t < threadCount; t++) {
+        threads.emplace_back(run, t);
+    }
+    run(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (error) std::rethrow_exception(error);
+    return steals.load();
+}
+
+} // namespace utils
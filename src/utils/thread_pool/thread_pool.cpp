@@ -0,0 +1,74 @@
+#include "thread_pool.hpp"
+
+namespace utils {
+
+/**
+ * @brief Constructor - Start the requested number of worker threads
+ * @param thread_count Number of workers (0 = run tasks inline)
+ */
+ThreadPool::ThreadPool(size_t thread_count)
+: m_stopping(false) {
+    m_workers.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; i++) {
+        m_workers.emplace_back(&ThreadPool::worker_loop, this);
+    }
+}
+
+/**
+ * @brief Destructor - Clean shutdown of the pool
+ * Unstarted tasks are dropped so shutdown does not wait on a long backlog
+ */
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_queue_mutex);
+        m_stopping = true;
+
+        std::queue<std::function<void()>> empty;
+        m_task_queue.swap(empty);
+    }
+    m_cv.notify_all();
+
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+/**
+ * @brief Worker thread function
+ * Sleeps until a task is available, then runs it outside the lock
+ */
+auto ThreadPool::worker_loop() -> void {
+    while (true) {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(m_queue_mutex);
+            m_cv.wait(lock, [this] {
+                return m_stopping || !m_task_queue.empty();
+            });
+
+            if (m_stopping) {
+                return;
+            }
+
+            task = std::move(m_task_queue.front());
+            m_task_queue.pop();
+        }
+
+        task();
+    }
+}
+
+auto ThreadPool::getQueuedTaskCount() -> size_t {
+    std::lock_guard<std::mutex> lock(m_queue_mutex);
+    return m_task_queue.size();
+}
+
+auto ThreadPool::defaultThreadCount() -> size_t {
+    unsigned int hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? hardware - 1 : 1;
+}
+
+} // namespace utils
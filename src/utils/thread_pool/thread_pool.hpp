@@ -0,0 +1,85 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace utils {
+
+/**
+ * @brief Fixed-size worker pool for background jobs
+ *
+ * Tasks are executed in FIFO order by a set of worker threads.
+ * A pool constructed with zero threads runs every task synchronously
+ * inside submit(), which keeps single-threaded code paths (and
+ * benchmarks comparing against them) on the same API.
+ *
+ * Pending tasks that have not started when the pool is destroyed are
+ * discarded; tasks already running are waited for.
+ */
+class ThreadPool {
+    private:
+    std::vector<std::thread> m_workers;             // Worker threads
+    std::queue<std::function<void()>> m_task_queue; // Tasks waiting for a worker
+    std::mutex m_queue_mutex;                       // Mutex for queue access
+    std::condition_variable m_cv;                   // Wakes idle workers
+    bool m_stopping;                                // Set when the pool shuts down
+
+    /**
+     * @brief Worker thread function
+     * Pops and runs tasks until the pool is stopped
+     */
+    auto worker_loop() -> void;
+
+    public:
+    /**
+     * @brief Construct a pool and start its worker threads
+     * @param thread_count Number of workers (0 = run tasks inline)
+     */
+    explicit ThreadPool(size_t thread_count = defaultThreadCount());
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Stop workers, drop unstarted tasks and join all threads
+     */
+    ~ThreadPool();
+
+    /**
+     * @brief Queue a task for execution on a worker thread
+     * @param task Callable with signature void()
+     */
+    template <typename F>
+    void submit(F&& task) {
+        if (m_workers.empty()) {
+            task();
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_queue_mutex);
+            m_task_queue.emplace(std::forward<F>(task));
+        }
+        m_cv.notify_one();
+    }
+
+    /**
+     * @brief Number of tasks queued but not yet picked up by a worker
+     */
+    auto getQueuedTaskCount() -> size_t;
+
+    auto getThreadCount() const -> size_t { return m_workers.size(); }
+
+    /**
+     * @brief Worker count that leaves one hardware thread for rendering
+     * @return hardware_concurrency() - 1, at least 1
+     */
+    static auto defaultThreadCount() -> size_t;
+};
+
+} // namespace utils
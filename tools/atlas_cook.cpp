@@ -0,0 +1,110 @@
+// Texture atlas metadata cooker
+//
+// Converts the JSON metadata written by resources/textures/atlas_generator.py
+// (the authoring format) into the binary form the game loads at startup
+// with TextureAtlas::loadFromBinary(): one mmap, no JSON parsing. The
+// format is described in src/renderer/texture/texture_atlas.cpp. JSON is
+// only parsed here; the engine library does not depend on nlohmann::json.
+//
+// The cooked file is read back and compared entry by entry with the JSON,
+// and both load paths are timed. Run it after regenerating the atlas and
+// commit the output next to the JSON.
+//
+// Usage: atlas_cook [--in=universe_block_atlas.json] [--out=universe_block_atlas.ntatlas]
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+#include "tool_args.hpp"
+
+#include "renderer/texture/texture_atlas.hpp"
+#include "utils/logger/logger.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr const char* USAGE = "Usage: atlas_cook [--in=universe_block_atlas.json] [--out=universe_block_atlas.ntatlas]\n";
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// {"texture_size", "atlas_size", "textures_per_row", "textures": {name: {"uv": {"min": [u, v], "max": [u, v]}}}}
+void loadJson(const std::string& path, renderer::TextureAtlas& atlas) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open JSON file: " + path);
+    }
+
+    nlohmann::json j;
+    try {
+        file >> j;
+        atlas.setLayout(j.at("atlas_size").get<int>(), j.at("texture_size").get<int>(), j.at("textures_per_row").get<int>());
+        for (const auto& [name, data] : j.at("textures").items()) {
+            const auto& min = data.at("uv").at("min");
+            const auto& max = data.at("uv").at("max");
+            atlas.addTexture(name, renderer::TextureUV(min.at(0).get<float>(), min.at(1).get<float>(), max.at(0).get<float>(), max.at(1).get<float>()));
+        }
+    } catch (const nlohmann::json::exception& e) {
+        throw std::runtime_error("Failed to parse JSON " + path + ": " + e.what());
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    utils::log().setLevel(utils::LogLevel::WARN);
+
+    if (const char* arg = tools::findUnknownArg(argc, argv, { "in", "out" })) {
+        std::fprintf(stderr, "Unknown argument: %s\n%s", arg, USAGE);
+        return 2;
+    }
+
+    std::string in  = tools::stringArg(argc, argv, "in", "universe_block_atlas.json");
+    std::string out = tools::stringArg(argc, argv, "out", std::filesystem::path(in).replace_extension(".ntatlas").string());
+
+    renderer::TextureAtlas authored, cooked;
+    try {
+        auto start = Clock::now();
+        loadJson(in, authored);
+        double jsonMs = elapsedMs(start);
+
+        authored.writeBinary(out);
+
+        start = Clock::now();
+        cooked.loadFromBinary(out);
+        double binaryMs = elapsedMs(start);
+
+        bool same = cooked.getTextureCount() == authored.getTextureCount() &&
+        cooked.getTextureSize() == authored.getTextureSize() &&
+        cooked.getAtlasSize() == authored.getAtlasSize() &&
+        cooked.getTexturesPerRow() == authored.getTexturesPerRow();
+        for (const auto& [name, uv] : authored.getTextures()) {
+            renderer::TextureUV other = cooked.getUV(name);
+            same                     = same && cooked.hasTexture(name) && other.min == uv.min && other.max == uv.max;
+        }
+
+        LOG_FLUSH();
+        if (!same) {
+            std::printf("MISMATCH: %s does not load back as %s\n", out.c_str(), in.c_str());
+            return 1;
+        }
+
+        std::printf("%zu textures: %s (%ju bytes) -> %s (%ju bytes)\n", authored.getTextureCount(),
+        in.c_str(), static_cast<uintmax_t>(std::filesystem::file_size(in)),
+        out.c_str(), static_cast<uintmax_t>(std::filesystem::file_size(out)));
+        std::printf("load: JSON %.2f ms, cooked %.2f ms (%.0fx faster)\n", jsonMs, binaryMs, jsonMs / binaryMs);
+    } catch (const std::exception& e) {
+        LOG_FLUSH();
+        std::fprintf(stderr, "%s\n", e.what());
+        return 2;
+    }
+    return 0;
+}
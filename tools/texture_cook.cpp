@@ -0,0 +1,482 @@
+// Block texture cooker
+//
+// Turns the block atlas PNG into the KTX2 file texture_array loads at
+// startup: the atlas is cut into one array layer per tile (same layer
+// order as TextureAtlas::getLayer()), every layer gets its full mip chain
+// down to 1x1 by a 2x2 box filter (what glGenerateMipmap does), and every
+// mip level is block-compressed on the CPU:
+//
+//   BC1  8 bytes per 4x4 block, 1-bit alpha, when every texel is opaque
+//        or fully transparent
+//   BC3  16 bytes per 4x4 block, 8-bit alpha, otherwise
+//
+// Endpoints come from the extremes of each block's colours along their
+// principal axis; good enough for 16x16 pixel art. The file is read back
+// through ktx2_file and compared byte for byte, level 0 is decoded again
+// to report the compression error, and the startup cost of both paths is
+// timed: PNG decode and slicing vs mapping the KTX2.
+//
+// Usage: texture_cook [--in=universe_block_atlas.png] [--tile=16]
+//                     [--format=auto|bc1|bc3] [--out=universe_block_atlas.ktx2]
+
+#include <stb/stb_image.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "tool_args.hpp"
+
+#include "renderer/texture/ktx2_file.hpp"
+#include "utils/logger/logger.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using renderer::block_format;
+
+struct Rgba {
+    uint8_t r, g, b, a;
+};
+
+// one array layer at one mip level, row-major, bottom row first like the GL upload
+struct Image {
+    int width  = 0;
+    int height = 0;
+    std::vector<Rgba> texels;
+
+    const Rgba& at(int x, int y) const { return texels[static_cast<size_t>(y) * width + x]; }
+};
+
+constexpr const char* USAGE = "Usage: texture_cook [--in=universe_block_atlas.png] [--tile=16]\n"
+                              "                    [--format=auto|bc1|bc3] [--out=universe_block_atlas.ktx2]\n";
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Same slicing as texture_array: layer row * columns + column, V flipped on load
+std::vector<Image> loadTiles(const std::string& path, int tile) {
+    stbi_set_flip_vertically_on_load(true);
+    int width = 0, height = 0, channels = 0;
+    unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 4);
+    if (!data) {
+        throw std::runtime_error("Failed to load texture: " + path);
+    }
+    if (tile <= 0 || width % tile != 0 || height % tile != 0) {
+        stbi_image_free(data);
+        throw std::runtime_error(path + " is not a whole number of " + std::to_string(tile) + "px tiles");
+    }
+
+    int columns = width / tile, rows = height / tile;
+    std::vector<Image> tiles(static_cast<size_t>(columns) * rows);
+    for (int row = 0; row < rows; row++) {
+        for (int column = 0; column < columns; column++) {
+            Image& image = tiles[static_cast<size_t>(row) * columns + column];
+            image.width  = tile;
+            image.height = tile;
+            image.texels.resize(static_cast<size_t>(tile) * tile);
+            for (int y = 0; y < tile; y++) {
+                const unsigned char* src = data + (static_cast<size_t>(row * tile + y) * width + column * tile) * 4;
+                std::memcpy(&image.texels[static_cast<size_t>(y) * tile], src, static_cast<size_t>(tile) * 4);
+            }
+        }
+    }
+    stbi_image_free(data);
+    return tiles;
+}
+
+// 2x2 box filter with straight alpha, as glGenerateMipmap does; odd sizes clamp
+Image downsample(const Image& image) {
+    Image half;
+    half.width  = std::max(image.width / 2, 1);
+    half.height = std::max(image.height / 2, 1);
+    half.texels.resize(static_cast<size_t>(half.width) * half.height);
+    for (int y = 0; y < half.height; y++) {
+        for (int x = 0; x < half.width; x++) {
+            int x0 = std::min(x * 2, image.width - 1), x1 = std::min(x * 2 + 1, image.width - 1);
+            int y0 = std::min(y * 2, image.height - 1), y1 = std::min(y * 2 + 1, image.height - 1);
+            const Rgba* quad[4] = { &image.at(x0, y0), &image.at(x1, y0), &image.at(x0, y1), &image.at(x1, y1) };
+
+            int sum[4] = {};
+            for (const Rgba* t : quad) {
+                sum[0] += t->r, sum[1] += t->g, sum[2] += t->b, sum[3] += t->a;
+            }
+            half.texels[static_cast<size_t>(y) * half.width + x] = {
+                static_cast<uint8_t>((sum[0] + 2) / 4), static_cast<uint8_t>((sum[1] + 2) / 4),
+                static_cast<uint8_t>((sum[2] + 2) / 4), static_cast<uint8_t>((sum[3] + 2) / 4)
+            };
+        }
+    }
+    return half;
+}
+
+// ---- BC1 / BC3 -------------------------------------------------------------
+
+uint16_t packRgb565(float r, float g, float b) {
+    auto quantize = [](float value, int max) {
+        return static_cast<uint16_t>(std::clamp(static_cast<int>(std::lround(value / 255.0f * max)), 0, max));
+    };
+    return static_cast<uint16_t>(quantize(r, 31) << 11 | quantize(g, 63) << 5 | quantize(b, 31));
+}
+
+std::array<int, 3> unpackRgb565(uint16_t color) {
+    int r = color >> 11 & 31, g = color >> 5 & 63, b = color & 31;
+    return { r << 3 | r >> 2, g << 2 | g >> 4, b << 3 | b >> 2 };
+}
+
+void putU16(uint8_t* out, uint16_t value) {
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+}
+
+struct ColorFit {
+    uint16_t c0, c1;
+    uint32_t indices;
+    int error;
+};
+
+/**
+ * Order the endpoints for the block mode and pick the closest palette entry per texel
+ *
+ * Colour 0 > colour 1 selects 4 colours; colour 0 <= colour 1 selects 3
+ * colours plus transparent, used when the block has transparent texels.
+ */
+ColorFit fitEndpoints(const Rgba (&block)[16], const bool (&transparent)[16], bool threeColor, uint16_t c0, uint16_t c1) {
+    if (threeColor ? c0 > c1 : c0 < c1) std::swap(c0, c1);
+
+    std::array<int, 3> a = unpackRgb565(c0), b = unpackRgb565(c1);
+    std::array<std::array<int, 3>, 4> palette{ a, b };
+    for (int c = 0; c < 3; c++) {
+        if (threeColor) {
+            palette[2][c] = (a[c] + b[c]) / 2;
+        } else {
+            palette[2][c] = (2 * a[c] + b[c]) / 3;
+            palette[3][c] = (a[c] + 2 * b[c]) / 3;
+        }
+    }
+    int choices = (threeColor || c0 == c1) ? 3 : 4;
+
+    ColorFit fit{ c0, c1, 0, 0 };
+    for (int i = 0; i < 16; i++) {
+        uint32_t index = 3;
+        if (!transparent[i]) {
+            int best = INT32_MAX;
+            for (int p = 0; p < choices; p++) {
+                int dr = block[i].r - palette[p][0], dg = block[i].g - palette[p][1], db = block[i].b - palette[p][2];
+                int error = dr * dr + dg * dg + db * db;
+                if (error < best) best = error, index = static_cast<uint32_t>(p);
+            }
+            fit.error += best;
+        }
+        fit.indices |= index << (2 * i);
+    }
+    return fit;
+}
+
+/**
+ * Encode the colours of a 4x4 block into 8 bytes
+ *
+ * With punchThrough, texels with alpha < 128 use the transparent index of
+ * the 3-colour mode (BC1 with alpha); otherwise the 4-colour mode is
+ * always used, as BC3 requires.
+ */
+void encodeColorBlock(const Rgba (&block)[16], bool punchThrough, uint8_t* out) {
+    bool transparent[16];
+    bool anyTransparent = false;
+    float mean[3]       = {};
+    int opaque          = 0;
+    for (int i = 0; i < 16; i++) {
+        transparent[i] = punchThrough && block[i].a < 128;
+        anyTransparent = anyTransparent || transparent[i];
+        if (transparent[i]) continue;
+        mean[0] += block[i].r, mean[1] += block[i].g, mean[2] += block[i].b;
+        opaque++;
+    }
+
+    if (opaque == 0) {
+        // all transparent: colour 0 <= colour 1 selects the 3-colour mode, index 3 everywhere
+        putU16(out, 0);
+        putU16(out + 2, 0);
+        std::memset(out + 4, 0xFF, 4);
+        return;
+    }
+    for (float& m : mean) m /= opaque;
+
+    // principal axis of the opaque colours by power iteration on their covariance
+    float cov[6] = {};
+    for (int i = 0; i < 16; i++) {
+        if (transparent[i]) continue;
+        float d[3] = { block[i].r - mean[0], block[i].g - mean[1], block[i].b - mean[2] };
+        cov[0] += d[0] * d[0], cov[1] += d[0] * d[1], cov[2] += d[0] * d[2];
+        cov[3] += d[1] * d[1], cov[4] += d[1] * d[2], cov[5] += d[2] * d[2];
+    }
+    float axis[3] = { 0.577f, 0.577f, 0.577f };
+    for (int iteration = 0; iteration < 8; iteration++) {
+        float next[3] = {
+            cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2],
+            cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2],
+            cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2],
+        };
+        float length = std::sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2]);
+        if (length < 1e-6f) break;
+        for (int c = 0; c < 3; c++) axis[c] = next[c] / length;
+    }
+
+    float lo = 0.0f, hi = 0.0f;
+    for (int i = 0; i < 16; i++) {
+        if (transparent[i]) continue;
+        float t = (block[i].r - mean[0]) * axis[0] + (block[i].g - mean[1]) * axis[1] + (block[i].b - mean[2]) * axis[2];
+        lo      = std::min(lo, t);
+        hi      = std::max(hi, t);
+    }
+    bool threeColor = anyTransparent;
+    ColorFit fit    = fitEndpoints(block, transparent, threeColor,
+    packRgb565(mean[0] + axis[0] * hi, mean[1] + axis[1] * hi, mean[2] + axis[2] * hi),
+    packRgb565(mean[0] + axis[0] * lo, mean[1] + axis[1] * lo, mean[2] + axis[2] * lo));
+
+    // refine: least-squares endpoints for the chosen indices, kept only if the block gets closer
+    for (int iteration = 0; iteration < 2 && fit.error > 0; iteration++) {
+        float ww = 0, wv = 0, vv = 0, wx[3] = {}, vx[3] = {};
+        for (int i = 0; i < 16; i++) {
+            uint32_t index = fit.indices >> (2 * i) & 3;
+            if (transparent[i]) continue;
+
+            // weight of colour 0 in palette entry index
+            float w = index == 0 ? 1.0f : index == 1 ? 0.0f : threeColor ? 0.5f : index == 2 ? 2.0f / 3.0f : 1.0f / 3.0f;
+            float v = 1.0f - w;
+            ww += w * w, wv += w * v, vv += v * v;
+            const uint8_t x[3] = { block[i].r, block[i].g, block[i].b };
+            for (int c = 0; c < 3; c++) wx[c] += w * x[c], vx[c] += v * x[c];
+        }
+        float det = ww * vv - wv * wv;
+        if (std::fabs(det) < 1e-6f) break;
+
+        float a[3], b[3];
+        for (int c = 0; c < 3; c++) {
+            a[c] = (vv * wx[c] - wv * vx[c]) / det;
+            b[c] = (ww * vx[c] - wv * wx[c]) / det;
+        }
+        ColorFit refined = fitEndpoints(block, transparent, threeColor, packRgb565(a[0], a[1], a[2]), packRgb565(b[0], b[1], b[2]));
+        if (refined.error >= fit.error) break;
+        fit = refined;
+    }
+
+    putU16(out, fit.c0);
+    putU16(out + 2, fit.c1);
+    for (int i = 0; i < 4; i++) out[4 + i] = static_cast<uint8_t>(fit.indices >> (8 * i));
+}
+
+// BC3 alpha: alpha 0 > alpha 1 selects 8 evenly spaced values between them
+void encodeAlphaBlock(const Rgba (&block)[16], uint8_t* out) {
+    int hi = 0, lo = 255;
+    for (const Rgba& t : block) {
+        hi = std::max<int>(hi, t.a);
+        lo = std::min<int>(lo, t.a);
+    }
+
+    uint64_t indices = 0;
+    if (hi > lo) {
+        for (int i = 0; i < 16; i++) {
+            // step 0 is alpha 0, step 7 is alpha 1; palette index 0, 1, 2..7 is step 0, 7, 1..6
+            int step   = static_cast<int>(std::lround((hi - block[i].a) * 7.0 / (hi - lo)));
+            int index  = step == 0 ? 0 : step == 7 ? 1 : step + 1;
+            indices   |= static_cast<uint64_t>(index) << (3 * i);
+        }
+    }
+
+    out[0] = static_cast<uint8_t>(hi);
+    out[1] = static_cast<uint8_t>(lo);
+    for (int i = 0; i < 6; i++) out[2 + i] = static_cast<uint8_t>(indices >> (8 * i));
+}
+
+// Encode one mip level of one layer; blocks past the edge of levels below 4x4 repeat the edge
+void encodeImage(const Image& image, block_format format, uint8_t* out) {
+    size_t blockBytes = renderer::get_block_bytes(format);
+    for (int by = 0; by < image.height; by += 4) {
+        for (int bx = 0; bx < image.width; bx += 4) {
+            Rgba block[16];
+            for (int i = 0; i < 16; i++) {
+                block[i] = image.at(std::min(bx + i % 4, image.width - 1), std::min(by + i / 4, image.height - 1));
+            }
+            if (format == block_format::bc1) {
+                encodeColorBlock(block, true, out);
+            } else {
+                encodeAlphaBlock(block, out);
+                encodeColorBlock(block, false, out + 8);
+            }
+            out += blockBytes;
+        }
+    }
+}
+
+// Reference decoders, only used to measure the error of the encoder above
+void decodeColorBlock(const uint8_t* in, bool fourColorOnly, Rgba (&block)[16]) {
+    uint16_t c0 = static_cast<uint16_t>(in[0] | in[1] << 8), c1 = static_cast<uint16_t>(in[2] | in[3] << 8);
+    std::array<int, 3> a = unpackRgb565(c0), b = unpackRgb565(c1);
+
+    Rgba palette[4] = {
+        { uint8_t(a[0]), uint8_t(a[1]), uint8_t(a[2]), 255 },
+        { uint8_t(b[0]), uint8_t(b[1]), uint8_t(b[2]), 255 },
+    };
+    if (fourColorOnly || c0 > c1) {
+        palette[2] = { uint8_t((2 * a[0] + b[0]) / 3), uint8_t((2 * a[1] + b[1]) / 3), uint8_t((2 * a[2] + b[2]) / 3), 255 };
+        palette[3] = { uint8_t((a[0] + 2 * b[0]) / 3), uint8_t((a[1] + 2 * b[1]) / 3), uint8_t((a[2] + 2 * b[2]) / 3), 255 };
+    } else {
+        palette[2] = { uint8_t((a[0] + b[0]) / 2), uint8_t((a[1] + b[1]) / 2), uint8_t((a[2] + b[2]) / 2), 255 };
+        palette[3] = { 0, 0, 0, 0 };
+    }
+    uint32_t indices = static_cast<uint32_t>(in[4] | in[5] << 8 | in[6] << 16 | uint32_t(in[7]) << 24);
+    for (int i = 0; i < 16; i++) block[i] = palette[indices >> (2 * i) & 3];
+}
+
+void decodeAlphaBlock(const uint8_t* in, Rgba (&block)[16]) {
+    int a0 = in[0], a1 = in[1];
+    int palette[8] = { a0, a1 };
+    for (int i = 2; i < 8; i++) {
+        palette[i] = a0 > a1 ? ((8 - i) * a0 + (i - 1) * a1) / 7 : i < 6 ? ((6 - i) * a0 + (i - 1) * a1) / 5 : i == 6 ? 0 : 255;
+    }
+    uint64_t indices = 0;
+    for (int i = 0; i < 6; i++) indices |= static_cast<uint64_t>(in[2 + i]) << (8 * i);
+    for (int i = 0; i < 16; i++) block[i].a = static_cast<uint8_t>(palette[indices >> (3 * i) & 7]);
+}
+
+// squared error summed over RGBA; transparent texels only count their alpha
+double blockError(const Image& image, block_format format, const uint8_t* encoded, size_t& samples) {
+    double error = 0.0;
+    for (int by = 0; by < image.height; by += 4) {
+        for (int bx = 0; bx < image.width; bx += 4) {
+            Rgba block[16];
+            if (format == block_format::bc1) {
+                decodeColorBlock(encoded, false, block);
+            } else {
+                decodeColorBlock(encoded + 8, true, block);
+                decodeAlphaBlock(encoded, block);
+            }
+            encoded += renderer::get_block_bytes(format);
+
+            for (int i = 0; i < 16; i++) {
+                int x = bx + i % 4, y = by + i / 4;
+                if (x >= image.width || y >= image.height) continue;
+                const Rgba& src = image.at(x, y);
+                double da = src.a - block[i].a;
+                error += da * da;
+                if (src.a != 0) {
+                    double dr = src.r - block[i].r, dg = src.g - block[i].g, db = src.b - block[i].b;
+                    error += dr * dr + dg * dg + db * db;
+                }
+                samples += 4;
+            }
+        }
+    }
+    return error;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    utils::log().setLevel(utils::LogLevel::WARN);
+
+    if (const char* arg = tools::findUnknownArg(argc, argv, { "in", "out", "format", "tile" })) {
+        std::fprintf(stderr, "Unknown argument: %s\n%s", arg, USAGE);
+        return 2;
+    }
+
+    std::string in         = tools::stringArg(argc, argv, "in", "universe_block_atlas.png");
+    std::string out        = tools::stringArg(argc, argv, "out", std::filesystem::path(in).replace_extension(".ktx2").string());
+    std::string formatName = tools::stringArg(argc, argv, "format", "auto");
+    int tile               = tools::intArg(argc, argv, "tile", 16);
+
+    if (formatName != "auto" && formatName != "bc1" && formatName != "bc3") {
+        std::fprintf(stderr, "--format must be auto, bc1 or bc3\n%s", USAGE);
+        return 2;
+    }
+
+    try {
+        auto start               = Clock::now();
+        std::vector<Image> tiles = loadTiles(in, tile);
+        double decodeMs          = elapsedMs(start);
+        const int layers         = static_cast<int>(tiles.size());
+
+        // BC1 loses nothing but the alpha steps between transparent and opaque
+        block_format format = formatName == "bc3" ? block_format::bc3 : block_format::bc1;
+        size_t translucent  = 0;
+        for (const Image& image : tiles) {
+            for (const Rgba& t : image.texels) translucent += t.a != 0 && t.a != 255;
+        }
+        if (formatName == "auto" && translucent > 0) format = block_format::bc3;
+
+        int levelCount = 1;
+        while ((tile >> levelCount) > 0) levelCount++;
+
+        start = Clock::now();
+        std::vector<std::vector<uint8_t>> levels(levelCount);
+        std::vector<Image> level0 = tiles;
+        for (int level = 0; level < levelCount; level++) {
+            size_t layerBytes = renderer::get_level_bytes(format, tile, tile, level);
+            levels[level].resize(layerBytes * layers);
+            for (int layer = 0; layer < layers; layer++) {
+                if (level > 0) tiles[layer] = downsample(tiles[layer]);
+                encodeImage(tiles[layer], format, levels[level].data() + layer * layerBytes);
+            }
+        }
+        double encodeMs = elapsedMs(start);
+
+        renderer::write_ktx2(out, format, tile, tile, layers, levels);
+
+        start = Clock::now();
+        renderer::ktx2_file cooked(out);
+        double mapMs = elapsedMs(start);
+
+        bool same = cooked.get_format() == format && cooked.get_width() == tile && cooked.get_height() == tile &&
+        cooked.get_layers() == layers && cooked.get_level_count() == levelCount;
+        for (int level = 0; same && level < levelCount; level++) {
+            same = cooked.get_level_size(level) == levels[level].size() &&
+            std::memcmp(cooked.get_level_data(level), levels[level].data(), levels[level].size()) == 0;
+        }
+
+        LOG_FLUSH();
+        if (!same) {
+            std::printf("MISMATCH: %s does not read back as written\n", out.c_str());
+            return 1;
+        }
+
+        size_t samples = 0;
+        double error   = 0.0;
+        size_t layer0  = renderer::get_level_bytes(format, tile, tile, 0);
+        for (int layer = 0; layer < layers; layer++) {
+            error += blockError(level0[layer], format, cooked.get_level_data(0) + layer * layer0, samples);
+        }
+        double rmse = std::sqrt(error / samples);
+
+        // what the PNG path uploads: RGBA8 plus the mips glGenerateMipmap adds
+        size_t rgbaBytes = 0, compressedBytes = 0;
+        for (int level = 0; level < levelCount; level++) {
+            size_t side = static_cast<size_t>(std::max(tile >> level, 1));
+            rgbaBytes += side * side * 4 * layers;
+            compressedBytes += levels[level].size();
+        }
+
+        std::printf("%d layers of %dx%d, %d mip levels, %s (%zu translucent texels)\n",
+        layers, tile, tile, levelCount, renderer::get_block_format_name(format), translucent);
+        std::printf("%s: %ju bytes -> %s: %ju bytes\n", in.c_str(), static_cast<uintmax_t>(std::filesystem::file_size(in)),
+        out.c_str(), static_cast<uintmax_t>(std::filesystem::file_size(out)));
+        std::printf("VRAM: RGBA8 %.1f KiB -> %.1f KiB (%.1fx less)\n", rgbaBytes / 1024.0, compressedBytes / 1024.0,
+        double(rgbaBytes) / compressedBytes);
+        std::printf("level 0 error: RMSE %.2f, PSNR %.1f dB\n", rmse, 20.0 * std::log10(255.0 / std::max(rmse, 1e-9)));
+        std::printf("startup: PNG decode + slice %.2f ms (plus glGenerateMipmap), KTX2 map %.3f ms; encoding took %.0f ms\n",
+        decodeMs, mapMs, encodeMs);
+    } catch (const std::exception& e) {
+        LOG_FLUSH();
+        std::fprintf(stderr, "%s\n", e.what());
+        return 2;
+    }
+    return 0;
+}
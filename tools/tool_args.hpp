@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdlib>
+#include <initializer_list>
+#include <string>
+
+namespace tools {
+
+/**
+ * @brief Read a "--name=value" option, falling back to a default
+ */
+inline std::string stringArg(int argc, char** argv, const std::string& name, const std::string& fallback) {
+    std::string prefix = "--" + name + "=";
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind(prefix, 0) == 0) return arg.substr(prefix.size());
+    }
+    return fallback;
+}
+
+/**
+ * @brief Read an integer "--name=value" option, falling back to a default
+ */
+inline int intArg(int argc, char** argv, const std::string& name, int fallback) {
+    std::string value = stringArg(argc, argv, name, "");
+    return value.empty() ? fallback : std::atoi(value.c_str());
+}
+
+/**
+ * @brief First argument that is not "--name=value" for one of names, or nullptr
+ *
+ * Checked before doing any work, so a typo or --help stops the tool
+ * instead of running it with the defaults.
+ */
+inline const char* findUnknownArg(int argc, char** argv, std::initializer_list<const char*> names) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool known      = false;
+        for (const char* name : names) {
+            known = known || arg.rfind("--" + std::string(name) + "=", 0) == 0;
+        }
+        if (!known) return argv[i];
+    }
+    return nullptr;
+}
+
+} // namespace tools
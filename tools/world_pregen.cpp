@@ -0,0 +1,207 @@
+// Headless world pregeneration
+//
+// Generates a square of chunks around the origin with TerrainGenerator on
+// every core and writes them to one file:
+//
+//   header   "NTPG", version, seed, flags (bit 0 density, bit 1 biomes),
+//            first chunk X/Z, chunks along X/Z
+//   table    per chunk, index x * sizeZ + z: u64 offset, u32 length
+//   payload  game::chuck::serializeChunk() of every chunk, in table order
+//
+// all little-endian. Chunks are generated in batches with
+// utils::parallelFor() (work stealing), and the writer thread stores batch
+// N in index order while the workers generate batch N + 1. The file
+// therefore never depends on the thread count or on scheduling.
+//
+// The printed content hash (FNV-1a over the payloads in order) fingerprints
+// the output; --expect fails the run when it differs, which makes the
+// tool a regression harness for both generator output and throughput.
+//
+// Usage: world_pregen [--seed=1] [--size=256] [--threads=N] [--batch=1024]
+//                     [--mode=heightmap|density] [--biomes=0|1]
+//                     [--out=world.ntpg] [--expect=<hex hash>]
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tool_args.hpp"
+
+#include "game/chuck/chunk_serializer.hpp"
+#include "game/generator/terrain_generator.hpp"
+#include "utils/binary_io.hpp"
+#include "utils/logger/logger.hpp"
+#include "utils/thread_pool/parallel_for.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr size_t TABLE_ENTRY_SIZE = 12;
+
+// Same terrain settings as main.cpp, with a non-zero scale
+void configureGenerator(game::generator::TerrainGenerator& generator, bool density, bool biomes) {
+    generator.setScale(0.05f);
+    generator.setOctaves(6);
+    generator.setPersistence(0.5f);
+    generator.setBaseHeight(30);
+    generator.setMaxHeight(40);
+    generator.setWaterLevel(25);
+    generator.setTerrainMode(density ? game::generator::TerrainMode::DENSITY : game::generator::TerrainMode::HEIGHTMAP);
+    generator.setBiomesEnabled(biomes);
+
+    // every chunk is generated exactly once, so cached heightmaps would never be hit
+    generator.setHeightmapCacheCapacity(0);
+}
+
+constexpr const char* USAGE = "Usage: world_pregen [--seed=1] [--size=256] [--threads=N] [--batch=1024]\n"
+                              "                    [--mode=heightmap|density] [--biomes=0|1]\n"
+                              "                    [--out=world.ntpg] [--expect=<hex hash>]\n";
+
+struct TableEntry {
+    uint64_t offset = 0;
+    uint32_t length = 0;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    utils::log().setLevel(utils::LogLevel::WARN);
+
+    if (const char* arg = tools::findUnknownArg(argc, argv, { "seed", "size", "threads", "batch", "mode", "biomes", "out", "expect" })) {
+        std::fprintf(stderr, "Unknown argument: %s\n%s", arg, USAGE);
+        return 2;
+    }
+
+    unsigned seed      = static_cast<unsigned>(tools::intArg(argc, argv, "seed", 1));
+    int size           = tools::intArg(argc, argv, "size", 256);
+    int threadArg      = tools::intArg(argc, argv, "threads", static_cast<int>(std::max(std::thread::hardware_concurrency(), 1u)));
+    int batchArg       = tools::intArg(argc, argv, "batch", 1024);
+    std::string mode   = tools::stringArg(argc, argv, "mode", "heightmap");
+    bool biomes        = tools::intArg(argc, argv, "biomes", 0) != 0;
+    std::string path   = tools::stringArg(argc, argv, "out", "world.ntpg");
+    std::string expect = tools::stringArg(argc, argv, "expect", "");
+
+    if (size <= 0 || threadArg <= 0 || batchArg <= 0) {
+        std::fprintf(stderr, "--size, --threads and --batch must be positive\n%s", USAGE);
+        return 2;
+    }
+    if (mode != "heightmap" && mode != "density") {
+        std::fprintf(stderr, "--mode must be heightmap or density\n%s", USAGE);
+        return 2;
+    }
+
+    size_t threads   = static_cast<size_t>(threadArg);
+    size_t batchSize = static_cast<size_t>(batchArg);
+    bool density     = mode == "density";
+
+    game::generator::TerrainGenerator generator(seed);
+    configureGenerator(generator, density, biomes);
+
+    const int originX  = -size / 2;
+    const int originZ  = -size / 2;
+    const size_t count = static_cast<size_t>(size) * size;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::fprintf(stderr, "Cannot open %s for writing\n", path.c_str());
+        return 2;
+    }
+
+    std::vector<uint8_t> header;
+    header.insert(header.end(), { 'N', 'T', 'P', 'G' });
+    utils::appendLE<uint32_t>(header, FORMAT_VERSION);
+    utils::appendLE<uint32_t>(header, seed);
+    utils::appendLE<uint32_t>(header, (density ? 1u : 0u) | (biomes ? 2u : 0u));
+    utils::appendLE<uint32_t>(header, static_cast<uint32_t>(originX));
+    utils::appendLE<uint32_t>(header, static_cast<uint32_t>(originZ));
+    utils::appendLE<uint32_t>(header, static_cast<uint32_t>(size));
+    utils::appendLE<uint32_t>(header, static_cast<uint32_t>(size));
+    file.write(reinterpret_cast<const char*>(header.data()), header.size());
+
+    // the table is filled in once every chunk's length is known
+    uint64_t tableOffset = header.size();
+    uint64_t offset      = tableOffset + count * TABLE_ENTRY_SIZE;
+    file.seekp(static_cast<std::streamoff>(offset));
+
+    std::vector<TableEntry> table(count);
+    utils::Fnv1a64 hash;
+
+    // two sets of per-chunk buffers: one being generated, one being written
+    std::vector<std::vector<uint8_t>> buffers[2];
+    std::future<void> writing;
+    size_t steals = 0;
+
+    auto writeBatch = [&](size_t first, const std::vector<std::vector<uint8_t>>* batch) {
+        for (size_t i = 0; i < batch->size(); i++) {
+            const std::vector<uint8_t>& bytes = (*batch)[i];
+            table[first + i]                  = { offset, static_cast<uint32_t>(bytes.size()) };
+            file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+            hash.update(bytes.data(), bytes.size());
+            offset += bytes.size();
+        }
+    };
+
+    auto start = Clock::now();
+    for (size_t first = 0, b = 0; first < count; first += batchSize, b ^= 1) {
+        size_t batchCount = std::min(batchSize, count - first);
+        auto& batch       = buffers[b];
+        batch.resize(batchCount);
+
+        steals += utils::parallelFor(batchCount, threads, [&](size_t i, size_t) {
+            size_t index = first + i;
+            int chunkX   = originX + static_cast<int>(index / size);
+            int chunkZ   = originZ + static_cast<int>(index % size);
+
+            game::chuck::VoxelChunk chunk;
+            generator.generateChunk(chunkX, chunkZ, chunk);
+            chunk.compact();
+
+            batch[i].clear();
+            game::chuck::serializeChunk(chunk, batch[i]);
+        });
+
+        if (writing.valid()) writing.get();
+        writing = std::async(std::launch::async, writeBatch, first, &batch);
+    }
+    if (writing.valid()) writing.get();
+
+    std::vector<uint8_t> tableBytes;
+    tableBytes.reserve(count * TABLE_ENTRY_SIZE);
+    for (const TableEntry& entry : table) {
+        utils::appendLE<uint64_t>(tableBytes, entry.offset);
+        utils::appendLE<uint32_t>(tableBytes, entry.length);
+    }
+    file.seekp(static_cast<std::streamoff>(tableOffset));
+    file.write(reinterpret_cast<const char*>(tableBytes.data()), tableBytes.size());
+    file.close();
+
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    if (!file) {
+        std::fprintf(stderr, "Failed writing %s\n", path.c_str());
+        return 2;
+    }
+
+    char hashText[17];
+    std::snprintf(hashText, sizeof(hashText), "%016" PRIx64, hash.value());
+
+    std::printf("seed %u, %dx%d chunks, %s%s, %zu threads, batches of %zu\n",
+    seed, size, size, density ? "density" : "heightmap", biomes ? " + biomes" : "", threads, batchSize);
+    std::printf("%zu chunks in %.2f s: %.0f chunks/s, %zu steals\n", count, seconds, count / seconds, steals);
+    std::printf("%s: %.1f MiB, %.1f MiB/s, %.2f KiB per chunk\n",
+    path.c_str(), offset / 1048576.0, offset / 1048576.0 / seconds, offset / 1024.0 / count);
+    std::printf("content hash: %s\n", hashText);
+
+    LOG_FLUSH();
+    if (!expect.empty() && expect != hashText) {
+        std::printf("FAIL: content hash differs from the expected %s\n", expect.c_str());
+        return 1;
+    }
+    return 0;
+}